@@ -0,0 +1,166 @@
+#!/usr/bin/env perl
+
+# Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+# l'Epita (LRDE)
+#
+# This file is part of Spot, a model checking library.
+#
+# Spot is free software; you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# Spot is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+# or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+# License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with Spot; see the file COPYING.  If not, write to the Free
+# Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+# 02111-1307, USA.
+
+# Print the measures output by run.pl as a table.  When a baseline
+# (another output of run.pl) is given, compare the two and flag the
+# runs whose results changed, or whose size, time, or memory grew by
+# more than a threshold.  Also flag models and formulae for which
+# algorithms or compression options disagree.  Exit with status 1 if
+# anything was flagged.
+
+use strict;
+use warnings;
+use Getopt::Long;
+
+my $threshold = 10;		# percent
+my $min_time = 0.1;		# seconds
+my $min_memory = 1024;		# kB
+
+GetOptions('threshold=f' => \$threshold,
+	   'min-time=f' => \$min_time,
+	   'min-memory=i' => \$min_memory)
+  && (@ARGV == 1 || @ARGV == 2)
+  or die "Usage: $0 [--threshold=PCT] [--min-time=SECS] [--min-memory=KB]\n"
+       . "       RESULTS [BASELINE]\n";
+
+my @columns = qw(model formula algorithm compression result
+		 states transitions time memory);
+
+# Read a file output by run.pl, and return the list of runs (each a
+# hash) in order.
+sub read_results ($)
+{
+  my ($file) = @_;
+  open(my $fh, '<', $file) or die "cannot open $file: $!\n";
+  my @res;
+  while (<$fh>)
+    {
+      chomp;
+      next if $. == 1 && /^model\t/;
+      my %run;
+      @run{@columns} = split /\t/;
+      push @res, \%run;
+    }
+  close $fh;
+  return @res;
+}
+
+sub key ($)
+{
+  my ($run) = @_;
+  return join("\t", @$run{qw(model formula algorithm compression)});
+}
+
+my @results = read_results($ARGV[0]);
+my %baseline;
+if (@ARGV == 2)
+  {
+    $baseline{key($_)} = $_ foreach read_results($ARGV[1]);
+  }
+
+# Relative change of a measure, or undef if it cannot be computed.
+sub change ($$)
+{
+  my ($new, $old) = @_;
+  return undef if $new eq '-' || $old eq '-' || $old == 0;
+  return ($new - $old) * 100 / $old;
+}
+
+# All runs on the same model and formula should agree.
+my %verdict;
+my %disagree;
+foreach my $run (@results)
+  {
+    next if $run->{result} eq 'error';
+    my $mf = "$run->{model}\t$run->{formula}";
+    if (!exists $verdict{$mf})
+      {
+	$verdict{$mf} = $run->{result};
+      }
+    elsif ($verdict{$mf} ne $run->{result})
+      {
+	$disagree{$mf} = 1;
+      }
+  }
+
+my ($flagged, $improved) = (0, 0);
+printf("%-16s %3s %-10s %-4s %-9s %10s %12s %8s %9s  %s\n",
+       'model', 'f', 'algorithm', 'comp', 'result', 'states',
+       'transitions', 'time', 'memory', 'notes');
+foreach my $run (@results)
+  {
+    my @notes;
+    my $bad = 0;
+    my $good = 0;
+    if (exists $disagree{"$run->{model}\t$run->{formula}"})
+      {
+	push @notes, 'DISAGREE';
+	$bad = 1;
+      }
+    if (%baseline)
+      {
+	my $old = $baseline{key($run)};
+	if (!$old)
+	  {
+	    push @notes, 'new';
+	  }
+	elsif ($old->{result} ne $run->{result})
+	  {
+	    push @notes, "RESULT (was $old->{result})";
+	    $bad = 1;
+	  }
+	else
+	  {
+	    foreach my $m (qw(states transitions time memory))
+	      {
+		my $c = change($run->{$m}, $old->{$m});
+		next unless defined $c;
+		my $diff = $run->{$m} - $old->{$m};
+		next if $m eq 'time' && abs($diff) < $min_time;
+		next if $m eq 'memory' && abs($diff) < $min_memory;
+		next if abs($c) < ($m eq 'states' || $m eq 'transitions'
+				   ? 0.005 : $threshold);
+		my $note = sprintf("%s %+.1f%%", $m, $c);
+		if ($c > $threshold)
+		  {
+		    $note = uc $note;
+		    $bad = 1;
+		  }
+		elsif ($c < 0)
+		  {
+		    $good = 1;
+		  }
+		push @notes, $note;
+	      }
+	  }
+      }
+    ++$flagged if $bad;
+    ++$improved if $good && !$bad;
+    printf("%-16s %3s %-10s %-4s %-9s %10s %12s %8s %9s  %s\n",
+	   @$run{@columns}, join(', ', @notes));
+  }
+
+print "\n", scalar(@results), " runs, $flagged flagged";
+print ", $improved improved" if %baseline;
+printf(" (threshold %g%%)", $threshold) if %baseline;
+print "\n";
+exit($flagged ? 1 : 0);
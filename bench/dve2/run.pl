@@ -0,0 +1,124 @@
+#!/usr/bin/env perl
+
+# Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+# l'Epita (LRDE)
+#
+# This file is part of Spot, a model checking library.
+#
+# Spot is free software; you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# Spot is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+# or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+# License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with Spot; see the file COPYING.  If not, write to the Free
+# Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+# 02111-1307, USA.
+
+# Run dve2check with all emptiness-check algorithms, with and without
+# state compression, on all the models and formulae listed in a file,
+# and output one tab-separated line of measures per run.
+
+use strict;
+use warnings;
+use Getopt::Long;
+
+my $dve2check = '../../iface/dve2/dve2check';
+my $srcdir = '.';
+my $list;
+my $algorithms;
+my $compressions = ',-z,-Z';
+my $json = 'report.json';
+
+$| = 1;
+
+GetOptions('dve2check=s' => \$dve2check,
+	   'srcdir=s' => \$srcdir,
+	   'list=s' => \$list,
+	   'algorithms=s' => \$algorithms,
+	   'compressions=s' => \$compressions)
+  && !@ARGV
+  or die "Usage: $0 [--dve2check=PROG] [--srcdir=DIR] [--list=FILE]\n"
+       . "       [--algorithms=FILE] [--compressions=OPT,OPT,...]\n";
+
+$list = "$srcdir/models/list" unless defined $list;
+$algorithms = "$srcdir/algorithms" unless defined $algorithms;
+
+sub read_lines ($)
+{
+  my ($file) = @_;
+  open(my $fh, '<', $file) or die "cannot open $file: $!\n";
+  my @res;
+  while (<$fh>)
+    {
+      chomp;
+      next if /^\s*(#|$)/;
+      push @res, $_;
+    }
+  close $fh;
+  return @res;
+}
+
+my @algos = read_lines($algorithms);
+my @opts = split(/,/, $compressions, -1);
+@opts = ('') unless @opts;
+
+print join("\t", qw(model formula algorithm compression result
+		    states transitions time memory)), "\n";
+
+foreach my $entry (read_lines($list))
+  {
+    my ($model, $ltl) = split(/\s+/, $entry);
+    my $name = $model;
+    $name =~ s,.*/,,;
+    $name =~ s/\.dve$//;
+    my @formulae = read_lines("$srcdir/$ltl");
+    for my $n (0 .. $#formulae)
+      {
+	for my $algo (@algos)
+	  {
+	    for my $opt (@opts)
+	      {
+		unlink $json;
+		my @cmd = ($dve2check, "-e$algo", "-J$json");
+		push @cmd, $opt if $opt ne '';
+		push @cmd, "$srcdir/$model", $formulae[$n];
+		open(my $out, '-|', @cmd) or die "cannot run $dve2check: $!\n";
+		my $result = 'error';
+		while (<$out>)
+		  {
+		    $result = 'empty' if /^no accepting run found/;
+		    $result = 'nonempty' if /^an accepting run exists/;
+		  }
+		close $out;
+
+		my ($states, $trans, $time, $mem) = ('-') x 4;
+		if (open(my $fh, '<', $json))
+		  {
+		    local $/;
+		    my $report = <$fh>;
+		    close $fh;
+		    $mem = $1 if $report =~ /"peak_rss_kb": (\d+)/;
+		    if ($report =~ /"emptiness check": \{([^}]*)\}/)
+		      {
+			my $stats = $1;
+			$states = $1 if $stats =~ /"states": (\d+)/;
+			$trans = $1 if $stats =~ /"transitions": (\d+)/;
+		      }
+		    $time = sprintf("%.3f", $1)
+		      if $report =~ /"name":\s*"running\ emptiness\ check",\s*
+				     "count":\s*\d+,\s*"user":\s*[\d.]+,\s*
+				     "system":\s*[\d.]+,\s*"cpu":\s*([\d.]+)/x;
+		  }
+		print join("\t", $name, $n + 1, $algo, $opt eq '' ? '-' : $opt,
+			   $result, $states, $trans, $time, $mem), "\n";
+	      }
+	  }
+      }
+  }
+unlink $json;
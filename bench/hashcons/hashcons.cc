@@ -0,0 +1,225 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+// Measure the throughput of formula construction through the
+// instance tables of unop, binop, and multop, and the memory used by
+// these tables.
+
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include "ltlast/allnodes.hh"
+#include "ltlvisit/clone.hh"
+#include "ltlvisit/length.hh"
+#include "ltlvisit/randomltl.hh"
+#include "ltlenv/defaultenv.hh"
+#include "ltlparse/ltlfile.hh"
+#include "misc/random.hh"
+#include "misc/timer.hh"
+
+namespace
+{
+  // Rebuild a formula bottom-up, going through instance() for
+  // every node.
+  class rebuild_visitor: public spot::ltl::clone_visitor
+  {
+  public:
+    spot::ltl::formula*
+    recurse(spot::ltl::formula* f)
+    {
+      rebuild_visitor v;
+      f->accept(v);
+      return v.result();
+    }
+  };
+
+  void
+  syntax(char* prog)
+  {
+    std::cerr << "Usage: " << prog << " [OPTIONS...] [FILE]" << std::endl
+	      << std::endl
+	      << "Build formulae read from FILE, or random formulae if"
+	      << " FILE is omitted," << std::endl
+	      << "then rebuild them node by node several times."
+	      << std::endl << std::endl
+	      << "Options:" << std::endl
+	      << "  -a N    number of atomic propositions [4]" << std::endl
+	      << "  -f N    size of random formulae [20]" << std::endl
+	      << "  -F N    number of random formulae [100000]" << std::endl
+	      << "  -r N    number of rebuild rounds [10]" << std::endl
+	      << "  -s N    seed for the random number generator [0]"
+	      << std::endl;
+    exit(2);
+  }
+
+  int
+  to_int(const char* s)
+  {
+    char* endptr;
+    int res = strtol(s, &endptr, 10);
+    if (*endptr || res < 0)
+      {
+	std::cerr << "Failed to parse `" << s << "' as a positive integer."
+		  << std::endl;
+	exit(2);
+      }
+    return res;
+  }
+
+  double
+  seconds(const spot::timer& t)
+  {
+    return double(t.utime() + t.stime()) / sysconf(_SC_CLK_TCK);
+  }
+
+  void
+  print_rate(const char* what, unsigned nodes, const spot::timer& t)
+  {
+    double s = seconds(t);
+    std::cout << std::setw(10) << what << ": "
+	      << std::setw(10) << nodes << " nodes in "
+	      << std::setw(6) << std::setprecision(2) << std::fixed << s
+	      << " s";
+    if (s > 0)
+      std::cout << " (" << std::setprecision(0) << nodes / s
+		<< " nodes/s)";
+    std::cout << std::endl;
+  }
+
+  void
+  print_tables()
+  {
+    using namespace spot::ltl;
+    std::cout << std::setw(10) << "unop" << ": "
+	      << std::setw(10) << unop::instance_count() << " instances, "
+	      << std::setw(10) << unop::instance_memory() << " bytes"
+	      << std::endl
+	      << std::setw(10) << "binop" << ": "
+	      << std::setw(10) << binop::instance_count() << " instances, "
+	      << std::setw(10) << binop::instance_memory() << " bytes"
+	      << std::endl
+	      << std::setw(10) << "multop" << ": "
+	      << std::setw(10) << multop::instance_count() << " instances, "
+	      << std::setw(10) << multop::instance_memory() << " bytes"
+	      << std::endl;
+  }
+}
+
+int
+main(int argc, char** argv)
+{
+  int opt_a = 4;
+  int opt_f = 20;
+  int opt_F = 100000;
+  int opt_r = 10;
+  int opt_s = 0;
+  const char* file = 0;
+
+  for (int argn = 1; argn < argc; ++argn)
+    {
+      if (!strcmp(argv[argn], "-a") && argn + 1 < argc)
+	opt_a = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-f") && argn + 1 < argc)
+	opt_f = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-F") && argn + 1 < argc)
+	opt_F = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-r") && argn + 1 < argc)
+	opt_r = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-s") && argn + 1 < argc)
+	opt_s = to_int(argv[++argn]);
+      else if (*argv[argn] == '-' || file)
+	syntax(argv[0]);
+      else
+	file = argv[argn];
+    }
+
+  std::vector<spot::ltl::formula*> fs;
+  unsigned nodes = 0;
+  spot::timer tbuild;
+
+  if (file)
+    {
+      spot::ltl::ltl_file formulae(file);
+      tbuild.start();
+      spot::ltl::formula* f;
+      while ((f = formulae.next()))
+	fs.push_back(f);
+      tbuild.stop();
+    }
+  else
+    {
+      spot::ltl::environment& env =
+	spot::ltl::default_environment::instance();
+      spot::ltl::atomic_prop_set ap;
+      for (int i = 0; i < opt_a; ++i)
+	{
+	  char buf[20];
+	  sprintf(buf, "p%d", i);
+	  ap.insert(static_cast<spot::ltl::atomic_prop*>(env.require(buf)));
+	}
+      spot::ltl::random_ltl rl(&ap);
+      spot::srand(opt_s);
+      tbuild.start();
+      for (int i = 0; i < opt_F; ++i)
+	fs.push_back(rl.generate(opt_f));
+      tbuild.stop();
+      for (spot::ltl::atomic_prop_set::iterator i = ap.begin();
+	   i != ap.end(); ++i)
+	(*i)->destroy();
+    }
+
+  for (unsigned i = 0; i < fs.size(); ++i)
+    nodes += spot::ltl::length(fs[i]);
+
+  std::cout << "formulae: " << fs.size() << std::endl;
+  print_rate("build", nodes, tbuild);
+
+  // Each rebuild finds every node in the instance tables.
+  spot::timer trebuild;
+  trebuild.start();
+  for (int r = 0; r < opt_r; ++r)
+    for (unsigned i = 0; i < fs.size(); ++i)
+      {
+	rebuild_visitor v;
+	fs[i]->accept(v);
+	v.result()->destroy();
+      }
+  trebuild.stop();
+  print_rate("rebuild", nodes * opt_r, trebuild);
+  print_tables();
+
+  spot::timer tdestroy;
+  tdestroy.start();
+  for (unsigned i = 0; i < fs.size(); ++i)
+    fs[i]->destroy();
+  tdestroy.stop();
+  print_rate("destroy", nodes, tdestroy);
+
+  assert(spot::ltl::atomic_prop::instance_count() == 0);
+  assert(spot::ltl::unop::instance_count() == 0);
+  assert(spot::ltl::binop::instance_count() == 0);
+  assert(spot::ltl::multop::instance_count() == 0);
+  return 0;
+}
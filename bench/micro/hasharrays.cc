@@ -0,0 +1,153 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#include "hasharrays.hh"
+#include "misc/simd.hh"
+
+#ifdef SPOT_HAVE_X86_SIMD
+#  include <immintrin.h>
+#endif
+
+namespace spot
+{
+#ifdef SPOT_HAVE_X86_SIMD
+  namespace
+  {
+    // wang32_hash() works on size_t, so although each value is
+    // truncated to 32 bits before being combined with the next one,
+    // the computation needs 64-bit lanes.  Each lane hashes one
+    // array: the arrays are hashed in parallel up to the size of the
+    // shortest one, and the rest is finished in scalar code.
+
+    struct sse41
+    {
+      enum { lanes = 2 };
+
+      SPOT_TARGET("sse4.1") static void
+      hash(const int* const* arrays, unsigned size, unsigned* hashes)
+      {
+	const __m128i ones = _mm_set1_epi32(-1);
+	const __m128i low = _mm_set1_epi64x(0xFFFFFFFFULL);
+	__m128i key = _mm_setzero_si128();
+	for (unsigned i = 0; i < size; ++i)
+	  {
+	    __m128i v = _mm_set_epi64x(static_cast<unsigned>(arrays[1][i]),
+				       static_cast<unsigned>(arrays[0][i]));
+	    key = _mm_xor_si128(_mm_and_si128(key, low), v);
+	    key = _mm_add_epi64(key, _mm_xor_si128(_mm_slli_epi64(key, 15),
+						   ones));
+	    key = _mm_xor_si128(key, _mm_srli_epi64(key, 10));
+	    key = _mm_add_epi64(key, _mm_slli_epi64(key, 3));
+	    key = _mm_xor_si128(key, _mm_srli_epi64(key, 6));
+	    key = _mm_add_epi64(key, _mm_xor_si128(_mm_slli_epi64(key, 11),
+						   ones));
+	    key = _mm_xor_si128(key, _mm_srli_epi64(key, 16));
+	  }
+	hashes[0] = _mm_cvtsi128_si32(key);
+	hashes[1] = _mm_extract_epi32(key, 2);
+      }
+    };
+
+    struct avx2
+    {
+      enum { lanes = 4 };
+
+      SPOT_TARGET("avx2") static void
+      hash(const int* const* arrays, unsigned size, unsigned* hashes)
+      {
+	const __m256i ones = _mm256_set1_epi32(-1);
+	const __m256i low = _mm256_set1_epi64x(0xFFFFFFFFULL);
+	const __m256i gather = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+	__m256i key = _mm256_setzero_si256();
+	for (unsigned i = 0; i < size; ++i)
+	  {
+	    __m256i v =
+	      _mm256_set_epi64x(static_cast<unsigned>(arrays[3][i]),
+				static_cast<unsigned>(arrays[2][i]),
+				static_cast<unsigned>(arrays[1][i]),
+				static_cast<unsigned>(arrays[0][i]));
+	    key = _mm256_xor_si256(_mm256_and_si256(key, low), v);
+	    key = _mm256_add_epi64(key,
+				   _mm256_xor_si256(_mm256_slli_epi64(key, 15),
+						    ones));
+	    key = _mm256_xor_si256(key, _mm256_srli_epi64(key, 10));
+	    key = _mm256_add_epi64(key, _mm256_slli_epi64(key, 3));
+	    key = _mm256_xor_si256(key, _mm256_srli_epi64(key, 6));
+	    key = _mm256_add_epi64(key,
+				   _mm256_xor_si256(_mm256_slli_epi64(key, 11),
+						    ones));
+	    key = _mm256_xor_si256(key, _mm256_srli_epi64(key, 16));
+	  }
+	// Keep the low half of each lane.
+	key = _mm256_permutevar8x32_epi32(key, gather);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(hashes),
+			 _mm256_castsi256_si128(key));
+      }
+    };
+
+    template <class isa>
+    void
+    hash_arrays(const int* const* arrays, const unsigned* sizes,
+		unsigned n, unsigned* hashes)
+    {
+      unsigned i = 0;
+      for (; i + isa::lanes <= n; i += isa::lanes)
+	{
+	  unsigned common = sizes[i];
+	  for (unsigned l = 1; l < isa::lanes; ++l)
+	    if (sizes[i + l] < common)
+	      common = sizes[i + l];
+	  isa::hash(arrays + i, common, hashes + i);
+	  for (unsigned l = 0; l < isa::lanes; ++l)
+	    {
+	      unsigned hash = hashes[i + l];
+	      for (unsigned j = common; j < sizes[i + l]; ++j)
+		hash = wang32_hash(hash
+				   ^ static_cast<unsigned>(arrays[i + l][j]));
+	      hashes[i + l] = hash;
+	    }
+	}
+      for (; i < n; ++i)
+	hashes[i] = wang32_hash_array(arrays[i], sizes[i]);
+    }
+  }
+#endif
+
+  void
+  wang32_hash_arrays(const int* const* arrays, const unsigned* sizes,
+		     unsigned n, unsigned* hashes)
+  {
+#ifdef SPOT_HAVE_X86_SIMD
+    switch (get_simd_level())
+      {
+      case simd_avx2:
+	hash_arrays<avx2>(arrays, sizes, n, hashes);
+	return;
+      case simd_sse41:
+	hash_arrays<sse41>(arrays, sizes, n, hashes);
+	return;
+      case simd_none:
+	break;
+      }
+#endif
+    for (unsigned i = 0; i < n; ++i)
+      hashes[i] = wang32_hash_array(arrays[i], sizes[i]);
+  }
+}
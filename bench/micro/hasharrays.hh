@@ -0,0 +1,43 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#ifndef SPOT_BENCH_MICRO_HASHARRAYS_HH
+# define SPOT_BENCH_MICRO_HASHARRAYS_HH
+
+# include "misc/hasharray.hh"
+
+namespace spot
+{
+  /// \brief Hash \a n arrays of integers with spot::wang32_hash_array().
+  ///
+  /// Array \a arrays[i] has \a sizes[i] elements, and its hash is
+  /// stored in \a hashes[i].  The arrays are hashed simultaneously
+  /// when the processor has vector instructions (see simd_level), with
+  /// the same results as hashing them one at a time.
+  ///
+  /// This is only used to measure the gain of hashing the successors
+  /// of a state by batches: the DiVinE interface hashes them
+  /// incrementally instead (see wang32_sum_hash_array()).
+  void
+  wang32_hash_arrays(const int* const* arrays, const unsigned* sizes,
+		     unsigned n, unsigned* hashes);
+}
+
+#endif // SPOT_BENCH_MICRO_HASHARRAYS_HH
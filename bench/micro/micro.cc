@@ -0,0 +1,1251 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+// Repeatable micro-benchmarks of some hot paths of Spot.  Each
+// benchmark is set up once, run once to warm the caches, and then
+// timed over several runs.
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <pthread.h>
+#include <set>
+#include <string>
+#include <vector>
+#include "ltlast/allnodes.hh"
+#include "ltlenv/defaultenv.hh"
+#include "ltlparse/public.hh"
+#include "ltlvisit/apcollect.hh"
+#include "misc/fixpool.hh"
+#include "misc/hash.hh"
+#include "misc/hasharray.hh"
+#include "misc/intvcomp.hh"
+#include "misc/intvcmp2.hh"
+#include "misc/mspool.hh"
+#include "misc/mtpool.hh"
+#include "misc/random.hh"
+#include "misc/simd.hh"
+#include "misc/timer.hh"
+#include "tgba/bdddict.hh"
+#include "tgba/tgbaexplicit.hh"
+#include "tgba/tgbaproduct.hh"
+#include "tgbaalgos/gtec/nsheap.hh"
+#include "tgbaalgos/ltl2tgba_fm.hh"
+#include "tgbaalgos/randomgraph.hh"
+#include "hasharrays.hh"
+
+namespace
+{
+  // A benchmark is built (its setup is not timed), and then run()
+  // several times.  Each call to run() returns the number of
+  // operations it performed.  prepare() is called, untimed, before
+  // each run.
+  class benchmark
+  {
+  public:
+    virtual ~benchmark()
+    {
+    }
+
+    virtual void
+    prepare()
+    {
+    }
+
+    virtual unsigned run() = 0;
+  };
+
+  // The product of a random graph with the automaton of an LTL
+  // formula, and the list of its reachable states.
+  class product_fixture
+  {
+  public:
+    product_fixture(int scale)
+    {
+      spot::ltl::environment& env =
+	spot::ltl::default_environment::instance();
+      spot::ltl::atomic_prop_set ap;
+      ap.insert(static_cast<spot::ltl::atomic_prop*>(env.require("a")));
+      ap.insert(static_cast<spot::ltl::atomic_prop*>(env.require("b")));
+      ap.insert(static_cast<spot::ltl::atomic_prop*>(env.require("c")));
+      spot::srand(0);
+      graph_ = spot::random_graph(5000 * scale, 0.001, &ap, &dict_);
+      for (spot::ltl::atomic_prop_set::iterator i = ap.begin();
+	   i != ap.end(); ++i)
+	(*i)->destroy();
+
+      spot::ltl::parse_error_list pel;
+      spot::ltl::formula* f =
+	spot::ltl::parse("G(a -> F(b & X c)) & GF(!a | c)", pel);
+      assert(f && pel.empty());
+      aut_ = spot::ltl_to_tgba_fm(f, &dict_);
+      f->destroy();
+      product_ = new spot::tgba_product(graph_, aut_);
+
+      // Collect the reachable states breadth-first.
+      typedef Sgi::hash_set<const spot::state*, spot::state_ptr_hash,
+			    spot::state_ptr_equal> seen_set;
+      seen_set seen;
+      const spot::state* init = product_->get_init_state();
+      seen.insert(init);
+      states.push_back(init);
+      for (unsigned n = 0; n < states.size(); ++n)
+	{
+	  spot::tgba_succ_iterator* it = product_->succ_iter(states[n]);
+	  for (it->first(); !it->done(); it->next())
+	    {
+	      const spot::state* s = it->current_state();
+	      if (seen.insert(s).second)
+		states.push_back(s);
+	      else
+		s->destroy();
+	    }
+	  delete it;
+	}
+    }
+
+    ~product_fixture()
+    {
+      for (unsigned n = 0; n < states.size(); ++n)
+	states[n]->destroy();
+      delete product_;
+      delete aut_;
+      delete graph_;
+    }
+
+    const spot::tgba*
+    product() const
+    {
+      return product_;
+    }
+
+    std::vector<const spot::state*> states;
+
+  private:
+    spot::bdd_dict dict_;
+    spot::tgba* graph_;
+    spot::tgba_explicit* aut_;
+    spot::tgba_product* product_;
+  };
+
+  // Iterate over the successors of all reachable states of a
+  // product.  One operation is one successor.
+  class product_succ: public benchmark
+  {
+  public:
+    product_succ(int scale)
+      : f_(scale)
+    {
+    }
+
+    virtual unsigned
+    run()
+    {
+      unsigned ops = 0;
+      const spot::tgba* p = f_.product();
+      for (unsigned n = 0; n < f_.states.size(); ++n)
+	{
+	  spot::tgba_succ_iterator* it = p->succ_iter(f_.states[n]);
+	  for (it->first(); !it->done(); it->next())
+	    {
+	      it->current_state()->destroy();
+	      ++ops;
+	    }
+	  delete it;
+	}
+      return ops;
+    }
+
+  private:
+    product_fixture f_;
+  };
+
+  // Insert clones of all reachable states of a product in a
+  // numbered_state_heap, and destroy it.  One operation is one state.
+  class nsheap_insert: public benchmark
+  {
+  public:
+    nsheap_insert(int scale)
+      : f_(scale)
+    {
+    }
+
+    virtual unsigned
+    run()
+    {
+      spot::numbered_state_heap_hash_map h;
+      unsigned n;
+      for (n = 0; n < f_.states.size(); ++n)
+	h.insert(f_.states[n]->clone(), n + 1);
+      return n;
+    }
+
+  private:
+    product_fixture f_;
+  };
+
+  // Look up all reachable states of a product in a
+  // numbered_state_heap, ten times.  One operation is one lookup.
+  class nsheap_find: public benchmark
+  {
+  public:
+    nsheap_find(int scale)
+      : f_(scale)
+    {
+      for (unsigned n = 0; n < f_.states.size(); ++n)
+	h_.insert(f_.states[n]->clone(), n + 1);
+    }
+
+    virtual unsigned
+    run()
+    {
+      unsigned ops = 0;
+      for (int r = 0; r < 10; ++r)
+	for (unsigned n = 0; n < f_.states.size(); ++n)
+	  {
+	    // Passing a clone is what the emptiness checks do: find()
+	    // destroys it since it is already in the heap.
+	    spot::numbered_state_heap::state_index_p i =
+	      h_.find(f_.states[n]->clone());
+	    assert(i.first);
+	    (void) i;
+	    ++ops;
+	  }
+      return ops;
+    }
+
+  private:
+    product_fixture f_;
+    spot::numbered_state_heap_hash_map h_;
+  };
+
+  // State vectors that look like those of DiVinE models: mostly
+  // small values, and a few larger ones.
+  class state_vectors
+  {
+  public:
+    state_vectors(int scale)
+      : size(32), count(10000 * scale), data(count * size)
+    {
+      spot::srand(0);
+      for (unsigned i = 0; i < data.size(); ++i)
+	{
+	  int r = spot::mrand(100);
+	  data[i] = r < 50 ? 0 : r < 90 ? spot::mrand(4) : spot::mrand(256);
+	}
+    }
+
+    unsigned size;
+    unsigned count;
+    std::vector<int> data;
+  };
+
+  // The state vectors of the first 20000 * scale states (in BFS
+  // order) of BEEM's peterson.4 model (iface/dve2/beem-peterson.4.dve),
+  // with the variables in the order of the DiVinE interface: pos[4],
+  // step[4], and then the control state, j, and k of each process.
+  // The successors of each of these states are also kept, in the
+  // order in which they are generated.
+  class beem_vectors
+  {
+  public:
+    enum { procs = 4 };
+    // Control states of the processes.
+    enum { NCS, CS, WAIT, Q2, Q3 };
+
+    beem_vectors(int scale)
+      : size(2 * procs + 3 * procs), count(20000 * scale)
+    {
+      std::vector<int> init(size, 0);
+      std::set<std::vector<int> > seen;
+      std::deque<std::vector<int> > todo;
+      seen.insert(init);
+      todo.push_back(init);
+      std::vector<std::vector<int> > succs;
+      while (count > succ_begin.size() && !todo.empty())
+	{
+	  const std::vector<int>& s = todo.front();
+	  data.insert(data.end(), s.begin(), s.end());
+	  succ_begin.push_back(succ_count());
+	  succs.clear();
+	  successors(s, succs);
+	  for (unsigned i = 0; i < succs.size(); ++i)
+	    {
+	      succ_data.insert(succ_data.end(),
+			       succs[i].begin(), succs[i].end());
+	      if (seen.insert(succs[i]).second)
+		todo.push_back(succs[i]);
+	    }
+	  todo.pop_front();
+	}
+      count = succ_begin.size();
+      succ_begin.push_back(succ_count());
+    }
+
+    unsigned
+    succ_count() const
+    {
+      return succ_data.size() / size;
+    }
+
+    unsigned size;
+    unsigned count;
+    std::vector<int> data;
+    // The successors of state N are succ_begin[N] to
+    // succ_begin[N + 1] - 1.
+    std::vector<int> succ_data;
+    std::vector<unsigned> succ_begin;
+
+  private:
+    void
+    successors(const std::vector<int>& s, std::vector<std::vector<int> >& out)
+    {
+      const int* pos = &s[0];
+      const int* step = &s[procs];
+      for (int p = 0; p < procs; ++p)
+	{
+	  unsigned pc = 2 * procs + 3 * p;
+	  int j = s[pc + 1];
+	  int k = s[pc + 2];
+	  std::vector<int> t = s;
+	  switch (s[pc])
+	    {
+	    case NCS:
+	      t[pc] = WAIT;
+	      t[pc + 1] = 1;
+	      out.push_back(t);
+	      break;
+	    case WAIT:
+	      if (j < procs)
+		{
+		  t[pc] = Q2;
+		  t[p] = j;
+		}
+	      else
+		{
+		  t[pc] = CS;
+		}
+	      out.push_back(t);
+	      break;
+	    case Q2:
+	      t[pc] = Q3;
+	      t[procs + j - 1] = p;
+	      t[pc + 2] = 0;
+	      out.push_back(t);
+	      break;
+	    case Q3:
+	      if (k < procs && (k == p || pos[k] < j))
+		{
+		  t[pc + 2] = k + 1;
+		  out.push_back(t);
+		  t = s;
+		}
+	      if (step[j - 1] != p || k == procs)
+		{
+		  t[pc] = WAIT;
+		  t[pc + 1] = j + 1;
+		  out.push_back(t);
+		}
+	      break;
+	    case CS:
+	      t[pc] = NCS;
+	      t[p] = 0;
+	      out.push_back(t);
+	      break;
+	    }
+	}
+    }
+  };
+
+  // Compress (or uncompress) state vectors with
+  // int_array_array_compress() or int_array_array_compress2().
+  // One operation is one int of the uncompressed vectors.
+  template <class Vectors,
+	    void (*compress)(const int*, size_t, int*, size_t&),
+	    void (*decompress)(const int*, size_t, int*, size_t),
+	    bool measure_decompress>
+  class intv: public benchmark
+  {
+  public:
+    intv(int scale)
+      : v_(scale), out_(v_.count * 2 * v_.size), out_size_(v_.count),
+	buf_(2 * v_.size + 30)
+    {
+      for (unsigned n = 0; n < v_.count; ++n)
+	{
+	  size_t s = 2 * v_.size;
+	  compress(&v_.data[n * v_.size], v_.size,
+		   &out_[n * 2 * v_.size], s);
+	  out_size_[n] = s;
+	}
+    }
+
+    virtual unsigned
+    run()
+    {
+      int* buf = &buf_[0];
+      for (unsigned n = 0; n < v_.count; ++n)
+	if (measure_decompress)
+	  {
+	    decompress(&out_[n * 2 * v_.size], out_size_[n], buf, v_.size);
+	  }
+	else
+	  {
+	    size_t s = 2 * v_.size;
+	    compress(&v_.data[n * v_.size], v_.size, buf, s);
+	  }
+      return v_.count * v_.size;
+    }
+
+  private:
+    Vectors v_;
+    std::vector<int> out_;
+    std::vector<size_t> out_size_;
+    std::vector<int> buf_;
+  };
+
+  typedef intv<state_vectors, spot::int_array_array_compress,
+	       spot::int_array_array_decompress, false> intvcomp_compress;
+  typedef intv<state_vectors, spot::int_array_array_compress,
+	       spot::int_array_array_decompress, true> intvcomp_decompress;
+  typedef intv<state_vectors, spot::int_array_array_compress2,
+	       spot::int_array_array_decompress2, false> intvcmp2_compress;
+  typedef intv<state_vectors, spot::int_array_array_compress2,
+	       spot::int_array_array_decompress2, true> intvcmp2_decompress;
+  typedef intv<beem_vectors, spot::int_array_array_compress2,
+	       spot::int_array_array_decompress2, false> beem_compress2;
+  typedef intv<beem_vectors, spot::int_array_array_compress2,
+	       spot::int_array_array_decompress2, true> beem_decompress2;
+
+  // Hash the successors of the BEEM states, one at a time with
+  // wang32_hash_array(), or all the successors of a state at once
+  // with wang32_hash_arrays().  One operation is the hash of one
+  // successor.
+  template <bool batch>
+  class state_hash: public benchmark
+  {
+  public:
+    state_hash(int scale)
+      : v_(scale), hashes_(v_.succ_count()),
+	arrays_(v_.succ_count()), sizes_(v_.succ_count(), v_.size)
+    {
+      for (unsigned n = 0; n < arrays_.size(); ++n)
+	arrays_[n] = &v_.succ_data[n * v_.size];
+      if (batch)
+	{
+	  // The batches should give the same hashes as the scalar code.
+	  run();
+	  for (unsigned n = 0; n < arrays_.size(); ++n)
+	    if (hashes_[n] != spot::wang32_hash_array(arrays_[n], v_.size))
+	      {
+		std::cerr << "*** "
+			  << spot::simd_level_name(spot::get_simd_level())
+			  << " hash error ***" << std::endl;
+		exit(1);
+	      }
+	}
+    }
+
+    virtual unsigned
+    run()
+    {
+      if (batch)
+	for (unsigned n = 0; n < v_.count; ++n)
+	  {
+	    unsigned b = v_.succ_begin[n];
+	    spot::wang32_hash_arrays(&arrays_[b], &sizes_[b],
+				     v_.succ_begin[n + 1] - b, &hashes_[b]);
+	  }
+      else
+	for (unsigned n = 0; n < arrays_.size(); ++n)
+	  hashes_[n] = spot::wang32_hash_array(arrays_[n], v_.size);
+      return arrays_.size();
+    }
+
+  private:
+    beem_vectors v_;
+    std::vector<unsigned> hashes_;
+    std::vector<const int*> arrays_;
+    std::vector<unsigned> sizes_;
+  };
+
+  // Allocate blocks from a fixed_size_pool, and release them in
+  // reverse order.  One operation is one allocation and its release.
+  class fixpool: public benchmark
+  {
+  public:
+    fixpool(int scale)
+      : pool_(40), blocks_(100000 * scale)
+    {
+    }
+
+    virtual unsigned
+    run()
+    {
+      unsigned n = blocks_.size();
+      for (unsigned i = 0; i < n; ++i)
+	blocks_[i] = pool_.allocate();
+      for (unsigned i = n; i > 0; --i)
+	pool_.deallocate(blocks_[i - 1]);
+      return n;
+    }
+
+  private:
+    spot::fixed_size_pool pool_;
+    std::vector<void*> blocks_;
+  };
+
+  // Same as fixpool, with a multiple_size_pool and blocks of 16 to
+  // 256 bytes.
+  class mspool: public benchmark
+  {
+  public:
+    mspool(int scale)
+      : blocks_(100000 * scale)
+    {
+    }
+
+    virtual unsigned
+    run()
+    {
+      unsigned n = blocks_.size();
+      for (unsigned i = 0; i < n; ++i)
+	blocks_[i] = pool_.allocate(size(i));
+      for (unsigned i = n; i > 0; --i)
+	pool_.deallocate(blocks_[i - 1], size(i - 1));
+      return n;
+    }
+
+  private:
+    static size_t
+    size(unsigned i)
+    {
+      return 16 + (i * 7 % 16) * 16;
+    }
+
+    spot::multiple_size_pool pool_;
+    std::vector<void*> blocks_;
+  };
+
+  // Number of threads of the mtpool benchmarks.
+  unsigned thread_count = 4;
+
+  // A fixed_size_pool shared by all threads behind a lock, to compare
+  // with the concurrent pools.
+  class locked_pool
+  {
+  public:
+    locked_pool()
+      : pool_(40)
+    {
+    }
+
+    class cache
+    {
+    public:
+      cache(locked_pool& p)
+	: p_(p)
+      {
+      }
+
+      void*
+      allocate(unsigned)
+      {
+	p_.lock_.lock();
+	void* res = p_.pool_.allocate();
+	p_.lock_.unlock();
+	return res;
+      }
+
+      void
+      deallocate(void* b, unsigned)
+      {
+	p_.lock_.lock();
+	p_.pool_.deallocate(b);
+	p_.lock_.unlock();
+      }
+
+    private:
+      locked_pool& p_;
+    };
+
+  private:
+    spot::spin_lock lock_;
+    spot::fixed_size_pool pool_;
+    friend class cache;
+  };
+
+  // The same interface for the concurrent pools.
+  class fixed_pool
+  {
+  public:
+    fixed_pool()
+      : pool_(40)
+    {
+    }
+
+    class cache
+    {
+    public:
+      cache(fixed_pool& p)
+	: c_(p.pool_)
+      {
+      }
+
+      void*
+      allocate(unsigned)
+      {
+	return c_.allocate();
+      }
+
+      void
+      deallocate(void* b, unsigned)
+      {
+	c_.deallocate(b);
+      }
+
+    private:
+      spot::concurrent_fixed_size_pool::cache c_;
+    };
+
+  private:
+    spot::concurrent_fixed_size_pool pool_;
+    friend class cache;
+  };
+
+  class multiple_pool
+  {
+  public:
+    class cache
+    {
+    public:
+      cache(multiple_pool& p)
+	: c_(p.pool_)
+      {
+      }
+
+      // Blocks of 16 to 256 bytes, as in the mspool benchmark.
+      void*
+      allocate(unsigned i)
+      {
+	return c_.allocate(16 + (i * 7 % 16) * 16);
+      }
+
+      void
+      deallocate(void* b, unsigned i)
+      {
+	c_.deallocate(b, 16 + (i * 7 % 16) * 16);
+      }
+
+    private:
+      spot::concurrent_multiple_size_pool::cache c_;
+    };
+
+  private:
+    spot::concurrent_multiple_size_pool pool_;
+    friend class cache;
+  };
+
+  // Contention on a pool shared by thread_count threads.  Each
+  // thread allocates a batch of blocks through its cache, and once
+  // all threads are done, releases the batch of the next thread, so
+  // that blocks keep moving from one thread to the other.  The
+  // batches add up to as many blocks as in the fixpool benchmark,
+  // whatever the number of threads.  One operation is one allocation
+  // and its release.
+  template <class Pool>
+  class mtpool: public benchmark
+  {
+  public:
+    mtpool(int scale)
+      : blocks_(thread_count)
+    {
+      unsigned n = 100000 * scale / thread_count;
+      for (unsigned t = 0; t < thread_count; ++t)
+	{
+	  caches_.push_back(new typename Pool::cache(pool_));
+	  blocks_[t].resize(n);
+	}
+    }
+
+    ~mtpool()
+    {
+      for (unsigned t = 0; t < thread_count; ++t)
+	delete caches_[t];
+    }
+
+    virtual unsigned
+    run()
+    {
+      in_parallel(allocate_batch);
+      in_parallel(release_next_batch);
+      return thread_count * blocks_[0].size();
+    }
+
+  private:
+    struct job
+    {
+      mtpool* self;
+      unsigned thread;
+    };
+
+    void
+    in_parallel(void* (*work)(void*))
+    {
+      std::vector<pthread_t> threads(thread_count);
+      std::vector<job> jobs(thread_count);
+      for (unsigned t = 0; t < thread_count; ++t)
+	{
+	  jobs[t].self = this;
+	  jobs[t].thread = t;
+	  if (pthread_create(&threads[t], 0, work, &jobs[t]))
+	    {
+	      std::cerr << "Failed to create a thread." << std::endl;
+	      exit(1);
+	    }
+	}
+      for (unsigned t = 0; t < thread_count; ++t)
+	pthread_join(threads[t], 0);
+    }
+
+    static void*
+    allocate_batch(void* arg)
+    {
+      job* j = static_cast<job*>(arg);
+      typename Pool::cache* c = j->self->caches_[j->thread];
+      std::vector<void*>& blocks = j->self->blocks_[j->thread];
+      unsigned n = blocks.size();
+      for (unsigned i = 0; i < n; ++i)
+	blocks[i] = c->allocate(i);
+      return 0;
+    }
+
+    static void*
+    release_next_batch(void* arg)
+    {
+      job* j = static_cast<job*>(arg);
+      typename Pool::cache* c = j->self->caches_[j->thread];
+      unsigned next = (j->thread + 1) % thread_count;
+      std::vector<void*>& blocks = j->self->blocks_[next];
+      for (unsigned i = blocks.size(); i > 0; --i)
+	c->deallocate(blocks[i - 1], i - 1);
+      return 0;
+    }
+
+    Pool pool_;
+    std::vector<typename Pool::cache*> caches_;
+    std::vector<std::vector<void*> > blocks_;
+  };
+
+  // The first five classes of formulae of src/ltltest/genltl.cc, for
+  // sizes 1 to 4 (twice as many with each doubling of the scale).
+  class formula_families
+  {
+  public:
+    formula_families(int scale)
+    {
+      int max = 4;
+      while (scale > 1)
+	{
+	  ++max;
+	  scale /= 2;
+	}
+      for (int n = 1; n <= max; ++n)
+	{
+	  add("(" + e_n("p", n) + ") & (" + e_n("q", n) + ")");
+	  add("F(" + phi_n("p", n, false) + ") & F("
+	      + phi_n("q", n, false) + ")");
+	  add("F(" + phi_n("p", n, true) + ") & F("
+	      + phi_n("q", n, true) + ")");
+	  add(join("GF(p", n, ")", " & "));
+	  add(join("FG(p", n, ")", " | "));
+	}
+    }
+
+    ~formula_families()
+    {
+      for (unsigned i = 0; i < formulae.size(); ++i)
+	formulae[i]->destroy();
+    }
+
+    std::vector<spot::ltl::formula*> formulae;
+
+  private:
+    void
+    add(const std::string& s)
+    {
+      spot::ltl::parse_error_list pel;
+      spot::ltl::formula* f = spot::ltl::parse(s, pel);
+      assert(f && pel.empty());
+      formulae.push_back(f);
+    }
+
+    static std::string
+    prop(const std::string& name, int i)
+    {
+      char buf[20];
+      sprintf(buf, "%d", i);
+      return name + buf;
+    }
+
+    // F(p1 & F(p2 & ... F(pn)))
+    static std::string
+    e_n(const std::string& name, int n)
+    {
+      std::string res = "F(" + prop(name, n) + ")";
+      for (int i = n - 1; i > 0; --i)
+	res = "F(" + prop(name, i) + " & " + res + ")";
+      return res;
+    }
+
+    // p & X(p & X(p & ... X(p))), or p & Xp & XXp & ... if flat.
+    static std::string
+    phi_n(const std::string& name, int n, bool flat)
+    {
+      std::string res = name;
+      std::string x = name;
+      for (int i = 1; i < n; ++i)
+	if (flat)
+	  {
+	    x = "X" + x;
+	    res += " & " + x;
+	  }
+	else
+	  {
+	    res = name + " & X(" + res + ")";
+	  }
+      return res;
+    }
+
+    static std::string
+    join(const std::string& pre, int n, const std::string& post,
+	 const std::string& sep)
+    {
+      std::string res;
+      for (int i = 1; i <= n; ++i)
+	res += (i > 1 ? sep : "") + pre + prop("", i) + post;
+      return res;
+    }
+  };
+
+  // Translate these formulae with ltl_to_tgba_fm(), with the
+  // successors of each state computed by minato_isop() or by a walk
+  // of their BDD.  One operation is one translation.
+  template <bool Walk>
+  class ltl2tgba_fm_bench: public benchmark
+  {
+  public:
+    ltl2tgba_fm_bench(int scale)
+      : f_(scale)
+    {
+    }
+
+    virtual unsigned
+    run()
+    {
+      for (unsigned i = 0; i < f_.formulae.size(); ++i)
+	delete spot::ltl_to_tgba_fm(f_.formulae[i], &dict_, false, true,
+				    false, false, 0, spot::ltl::Reduce_None,
+				    Walk);
+      return f_.formulae.size();
+    }
+
+  private:
+    formula_families f_;
+    spot::bdd_dict dict_;
+  };
+
+  // Build the conjunctions of all subsets of (at least two) atomic
+  // propositions with multop::instance(), twice: the second
+  // construction finds every formula in the instance table.  One
+  // operation is one call to multop::instance().
+  class multop_instance: public benchmark
+  {
+  public:
+    multop_instance(int scale)
+    {
+      spot::ltl::environment& env =
+	spot::ltl::default_environment::instance();
+      int n = 12;
+      while (scale > 1)
+	{
+	  ++n;
+	  scale /= 2;
+	}
+      for (int i = 0; i < n; ++i)
+	{
+	  char buf[20];
+	  sprintf(buf, "p%d", i);
+	  props_.push_back(env.require(buf));
+	}
+    }
+
+    ~multop_instance()
+    {
+      for (unsigned i = 0; i < props_.size(); ++i)
+	props_[i]->destroy();
+    }
+
+    virtual unsigned
+    run()
+    {
+      using namespace spot::ltl;
+      unsigned subsets = 1U << props_.size();
+      std::vector<formula*> res;
+      res.reserve(2 * subsets);
+      for (int round = 0; round < 2; ++round)
+	for (unsigned s = 0; s < subsets; ++s)
+	  {
+	    if (!(s & (s - 1)))
+	      continue;		// fewer than two elements
+	    multop::vec* v = new multop::vec;
+	    for (unsigned i = 0; i < props_.size(); ++i)
+	      if (s & (1U << i))
+		v->push_back(props_[i]->clone());
+	    res.push_back(multop::instance(multop::And, v));
+	  }
+      for (unsigned i = 0; i < res.size(); ++i)
+	res[i]->destroy();
+      return res.size();
+    }
+
+  private:
+    std::vector<spot::ltl::formula*> props_;
+  };
+
+  // Random BDDs over some variables of a bdd_dict.
+  class bdd_fixture
+  {
+  public:
+    enum { vars = 24 };
+
+    bdd_fixture(int scale)
+      : count(500 * scale)
+    {
+      first_var = dict_.register_anonymous_variables(2 * vars, this);
+      spot::srand(0);
+      for (unsigned i = 0; i < count; ++i)
+	{
+	  bdd f = bddfalse;
+	  for (int t = 0; t < 4; ++t)
+	    {
+	      bdd c = bddtrue;
+	      for (int v = 0; v < vars; ++v)
+		{
+		  int r = spot::mrand(3);
+		  if (r == 0)
+		    c &= bdd_ithvar(first_var + v);
+		  else if (r == 1)
+		    c &= bdd_nithvar(first_var + v);
+		}
+	      f |= c;
+	    }
+	  bdds.push_back(f);
+	}
+    }
+
+    ~bdd_fixture()
+    {
+      bdds.clear();
+      dict_.unregister_all_my_variables(this);
+    }
+
+    unsigned count;
+    int first_var;
+    std::vector<bdd> bdds;
+
+  private:
+    spot::bdd_dict dict_;
+  };
+
+  // Conjunctions and disjunctions of pairs of random BDDs with
+  // bdd_apply().  The operation caches are flushed before each run.
+  // One operation is one call to bdd_apply().
+  class bdd_apply_bench: public benchmark
+  {
+  public:
+    bdd_apply_bench(int scale)
+      : f_(scale)
+    {
+    }
+
+    virtual void
+    prepare()
+    {
+      bdd_gbc();
+    }
+
+    virtual unsigned
+    run()
+    {
+      unsigned ops = 0;
+      for (unsigned i = 0; i < f_.count; ++i)
+	for (unsigned j = 1; j <= 8; ++j)
+	  {
+	    const bdd& a = f_.bdds[i];
+	    const bdd& b = f_.bdds[(i + j) % f_.count];
+	    bdd_apply(a, b, j & 1 ? bddop_and : bddop_or);
+	    ++ops;
+	  }
+      return ops;
+    }
+
+  private:
+    bdd_fixture f_;
+  };
+
+  // Rename the variables of random BDDs with bdd_replace().  The
+  // operation caches are flushed before each run.  One operation is
+  // one call to bdd_replace().
+  class bdd_replace_bench: public benchmark
+  {
+  public:
+    bdd_replace_bench(int scale)
+      : f_(scale), pair_(bdd_newpair())
+    {
+      for (int v = 0; v < bdd_fixture::vars; ++v)
+	bdd_setpair(pair_, f_.first_var + v,
+		    f_.first_var + bdd_fixture::vars + v);
+    }
+
+    ~bdd_replace_bench()
+    {
+      bdd_freepair(pair_);
+    }
+
+    virtual void
+    prepare()
+    {
+      bdd_gbc();
+    }
+
+    virtual unsigned
+    run()
+    {
+      for (unsigned i = 0; i < f_.count; ++i)
+	bdd_replace(f_.bdds[i], pair_);
+      return f_.count;
+    }
+
+  private:
+    bdd_fixture f_;
+    bddPair* pair_;
+  };
+
+  template <class B>
+  benchmark*
+  make(int scale)
+  {
+    return new B(scale);
+  }
+
+  struct benchmark_entry
+  {
+    const char* name;
+    benchmark* (*build)(int);
+  };
+
+  const benchmark_entry benchmarks[] =
+    {
+      { "product_succ", make<product_succ> },
+      { "nsheap_insert", make<nsheap_insert> },
+      { "nsheap_find", make<nsheap_find> },
+      { "intvcomp_compress", make<intvcomp_compress> },
+      { "intvcomp_decompress", make<intvcomp_decompress> },
+      { "intvcmp2_compress", make<intvcmp2_compress> },
+      { "intvcmp2_decompress", make<intvcmp2_decompress> },
+      { "beem_compress2", make<beem_compress2> },
+      { "beem_decompress2", make<beem_decompress2> },
+      { "state_hash", make<state_hash<false> > },
+      { "state_hash_batch", make<state_hash<true> > },
+      { "fixpool", make<fixpool> },
+      { "mspool", make<mspool> },
+      { "mtpool_locked", make<mtpool<locked_pool> > },
+      { "mtpool_fixed", make<mtpool<fixed_pool> > },
+      { "mtpool_multiple", make<mtpool<multiple_pool> > },
+      { "ltl2tgba_fm", make<ltl2tgba_fm_bench<false> > },
+      { "ltl2tgba_fm_walk", make<ltl2tgba_fm_bench<true> > },
+      { "multop_instance", make<multop_instance> },
+      { "bdd_apply", make<bdd_apply_bench> },
+      { "bdd_replace", make<bdd_replace_bench> },
+      { 0, 0 }
+    };
+
+  void
+  syntax(char* prog)
+  {
+    std::cerr << "Usage: " << prog << " [OPTIONS...] [BENCHMARKS...]"
+	      << std::endl << std::endl
+	      << "Run the given micro-benchmarks, or all of them."
+	      << std::endl << std::endl
+	      << "Options:" << std::endl
+	      << "  -l      list the benchmarks and exit" << std::endl
+	      << "  -n N    scale the size of the inputs by N [1]"
+	      << std::endl
+	      << "  -r N    number of timed runs [10]" << std::endl
+	      << "  -s SET  use the SET instruction set in vectorized code"
+	      << std::endl
+	      << "          (none, sse4.1, or avx2) [best supported]"
+	      << std::endl
+	      << "  -t N    number of threads of the mtpool benchmarks [4]"
+	      << std::endl;
+    exit(2);
+  }
+
+  int
+  to_int(const char* s)
+  {
+    char* endptr;
+    int res = strtol(s, &endptr, 10);
+    if (*endptr || res <= 0)
+      {
+	std::cerr << "Failed to parse `" << s << "' as a positive integer."
+		  << std::endl;
+	exit(2);
+      }
+    return res;
+  }
+
+  void
+  measure(const benchmark_entry& e, int scale, int runs)
+  {
+    benchmark* b = e.build(scale);
+
+    // Warm-up run.
+    b->prepare();
+    unsigned ops = b->run();
+
+    std::vector<double> times;
+    for (int r = 0; r < runs; ++r)
+      {
+	b->prepare();
+	spot::timer t;
+	t.start();
+	unsigned o = b->run();
+	t.stop();
+	assert(o == ops);
+	(void) o;
+	times.push_back(t.walltime());
+      }
+    delete b;
+
+    double sum = 0;
+    double min = times[0];
+    for (int r = 0; r < runs; ++r)
+      {
+	sum += times[r];
+	if (times[r] < min)
+	  min = times[r];
+      }
+    double mean = sum / runs;
+    double var = 0;
+    for (int r = 0; r < runs; ++r)
+      var += (times[r] - mean) * (times[r] - mean);
+    if (runs > 1)
+      var /= runs - 1;
+
+    // Times are reported in nanoseconds per operation.
+    double scale_ns = 1e9 / ops;
+    printf("%-20s %10u %4d %10.2f %9.2f %10.2f %8.2f\n", e.name, ops, runs,
+	   mean * scale_ns, sqrt(var) * scale_ns, min * scale_ns,
+	   mean > 0 ? ops / mean / 1e6 : 0.);
+    fflush(stdout);
+  }
+}
+
+int
+main(int argc, char** argv)
+{
+  int scale = 1;
+  int runs = 10;
+  std::vector<const benchmark_entry*> selected;
+
+  for (int argn = 1; argn < argc; ++argn)
+    {
+      if (!strcmp(argv[argn], "-l"))
+	{
+	  for (const benchmark_entry* e = benchmarks; e->name; ++e)
+	    std::cout << e->name << std::endl;
+	  return 0;
+	}
+      else if (!strcmp(argv[argn], "-n") && argn + 1 < argc)
+	scale = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-r") && argn + 1 < argc)
+	runs = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-t") && argn + 1 < argc)
+	thread_count = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-s") && argn + 1 < argc)
+	{
+	  const char* name = argv[++argn];
+	  int l;
+	  for (l = spot::simd_avx2; l >= spot::simd_none; --l)
+	    {
+	      spot::simd_level level = static_cast<spot::simd_level>(l);
+	      if (!strcmp(name, spot::simd_level_name(level)))
+		break;
+	    }
+	  if (l < spot::simd_none)
+	    {
+	      std::cerr << "Unknown instruction set `" << name << "'."
+			<< std::endl;
+	      exit(2);
+	    }
+	  spot::simd_level want = static_cast<spot::simd_level>(l);
+	  if (spot::set_simd_level(want) != want)
+	    {
+	      std::cerr << "Instruction set `" << name
+			<< "' is not supported by this processor." << std::endl;
+	      exit(2);
+	    }
+	}
+      else if (*argv[argn] == '-')
+	syntax(argv[0]);
+      else
+	{
+	  const benchmark_entry* e;
+	  for (e = benchmarks; e->name; ++e)
+	    if (!strcmp(e->name, argv[argn]))
+	      break;
+	  if (!e->name)
+	    {
+	      std::cerr << "Unknown benchmark `" << argv[argn] << "'."
+			<< std::endl;
+	      exit(2);
+	    }
+	  selected.push_back(e);
+	}
+    }
+  if (selected.empty())
+    for (const benchmark_entry* e = benchmarks; e->name; ++e)
+      selected.push_back(e);
+
+  printf("# instruction set: %s\n",
+	 spot::simd_level_name(spot::get_simd_level()));
+  printf("# threads: %u\n", thread_count);
+  printf("# %-18s %10s %4s %10s %9s %10s %8s\n", "benchmark", "ops", "runs",
+	 "mean(ns)", "sdev(ns)", "min(ns)", "Mops/s");
+  for (unsigned i = 0; i < selected.size(); ++i)
+    measure(*selected[i], scale, runs);
+  return 0;
+}
@@ -20,6 +20,8 @@
 
 #include <queue>
 #include <limits>
+#include <cstdlib>
+#include <cstring>
 #include <sys/time.h>
 #include "tgbaalgos/scc.hh"
 #include "ltlparse/ltlfile.hh"
@@ -67,7 +69,7 @@ namespace spot
 	}
 	else
 	  // No, free dst.
-	  delete dst;
+	  dst->destroy();
       }
       delete sit;
     }
@@ -75,7 +77,7 @@ namespace spot
     // Free visited states.
     for (it2 = seen.begin(); it2 != seen.end(); it2++)
     {
-      delete *it2;
+      (*it2)->destroy();
     }
     return count;
   }
@@ -128,9 +130,18 @@ bool accepting_path(spot::tgba* a, std::ostream& output, bool do_print)
 
 int main(int argc, char* argv[])
 {
-  if (argc > 4)
+  // Number of worker processes for the parallel check of the split
+  // products.  0 disables it.
+  unsigned jobs = 0;
+  if (argc > 1 && !strncmp(argv[1], "-j", 2))
   {
-    std::cout << "Usage ./cutscc file_name split_count [model_file]"
+    jobs = atoi(argv[1] + 2);
+    --argc;
+    ++argv;
+  }
+  if (argc < 3 || argc > 4)
+  {
+    std::cout << "Usage ./cutscc [-jN] file_name split_count [model_file]"
 	      << std::endl;
     return 1;
   }
@@ -146,6 +157,7 @@ int main(int argc, char* argv[])
   double split_sum = 0.;
   double full_sum = 0.;
   double cut_sum = 0.;
+  double par_sum = 0.;
   spot::tgba* r = 0;
   spot::ltl::environment& env(spot::ltl::default_environment::instance());
   spot::bdd_dict* dict = new spot::bdd_dict();
@@ -181,16 +193,18 @@ int main(int argc, char* argv[])
       r = spot::random_graph(10000, 0.0001, s, dict, 0, 0.15, 0.5);
       delete s;
     }
-    spot::scc_map m (a);
-    m.build_map();
-
     spot::tgba* res = 0;
 
     // Simplify the tgba to delete useless pathes
     if (argc != 4)
     {
       spot::tgba* tmp = a;
-      a = spot::split_tgba(a, m, 1).front();
+      {
+	// The map must be destroyed before the automaton it refers to.
+	spot::scc_map m (tmp);
+	m.build_map();
+	a = spot::split_tgba(tmp, m, 1).front();
+      }
       delete tmp;
     }
 
@@ -248,11 +262,13 @@ int main(int argc, char* argv[])
 
     cut_sum = cut_time / iter_count;
     // Compute again for printing purposes only
-    spot::scc_map m2 (a);
-    m2.build_map();
-    //  if (i == 42)
-    //	spot::dotty_reachable(out_dot, a);
-    splitted = spot::split_tgba(a, m2, split_count);
+    {
+      spot::scc_map m2 (a);
+      m2.build_map();
+      //  if (i == 42)
+      //	spot::dotty_reachable(out_dot, a);
+      splitted = spot::split_tgba(a, m2, split_count);
+    }
     if (print_time)
     {
       std::cout << "Splitting in "
@@ -326,6 +342,34 @@ int main(int argc, char* argv[])
       std::cout << "Time gain " << time_gain << "s" << std::endl;
       std::cout << std::endl;
     }
+    if (jobs)
+    {
+      // Measure the time to check all split products in parallel.
+      bool par_result = false;
+      elapsed = 0.;
+      for (j = 0; j < iter_count; j++)
+      {
+	TimerReset(start);
+	int ec = spot::split_emptiness_check(r, splitted, jobs);
+	elapsed += TimerGetElapsedTime(start);
+	if (ec < 0)
+	{
+	  std::cerr << "parallel check failed" << std::endl;
+	  exit(2);
+	}
+	par_result = ec;
+      }
+      elapsed /= iter_count;
+      par_sum += elapsed + cut_time / iter_count;
+      if (print_time)
+	std::cout << "Parallel check with " << jobs << " workers : "
+		  << elapsed << "s" << std::endl
+		  << "Parallel time gain "
+		  << full_time - (elapsed + cut_time / iter_count) << "s"
+		  << std::endl << std::endl;
+      if (par_result != full_result)
+	std::cout << "Disagree !" << std::endl;
+    }
     std::list<spot::tgba*>::iterator lit;
     for (lit = splitted.begin(); lit != splitted.end(); lit++)
       delete *lit;
@@ -344,4 +388,6 @@ int main(int argc, char* argv[])
   std::cout << "Full    " << full_sum << "s" << std::endl
 	    << "Cutting " << cut_sum << "s" << std::endl
 	    << "Split   " << split_sum << "s" << std::endl;
+  if (jobs)
+    std::cout << "Parallel " << par_sum << "s" << std::endl;
 }
@@ -27,7 +27,8 @@
 #include <unistd.h>
 
 #include "dve2.hh"
-#include "misc/hashfunc.hh"
+#include "misc/arena.hh"
+#include "misc/hasharray.hh"
 #include "misc/fixpool.hh"
 #include "misc/mspool.hh"
 #include "misc/intvcomp.hh"
@@ -80,9 +81,7 @@ namespace spot
 
       void compute_hash()
       {
-	hash_value = 0;
-	for (int i = 0; i < size; ++i)
-	  hash_value = wang32_hash(hash_value ^ vars[i]);
+	hash_value = wang32_sum_hash_array(vars, size);
       }
 
       dve2_state* clone() const
@@ -137,13 +136,6 @@ namespace spot
       {
       }
 
-      void compute_hash()
-      {
-	hash_value = 0;
-	for (int i = 0; i < size; ++i)
-	  hash_value = wang32_hash(hash_value ^ vars[i]);
-      }
-
       dve2_compressed_state* clone() const
       {
 	++count;
@@ -190,6 +182,8 @@ namespace spot
 
     public:
       multiple_size_pool* pool;
+      // Hash of the uncompressed state, as for dve2_state, so that
+      // it can be computed incrementally.
       size_t hash_value: 32;
       int size: 16;
       mutable unsigned count: 16;
@@ -207,8 +201,18 @@ namespace spot
       void* pool;
       int* compressed;
       void (*compress)(const int*, size_t, int*, size_t&);
-
-      ~callback_context()
+      // The source state: its variables, its hash, and, if it was
+      // compressed with int_array_array_compress2(), its compressed
+      // variables (otherwise PARENT_COMP is 0).  Successors are
+      // hashed and compressed incrementally from the source state.
+      const int* parent;
+      unsigned parent_hash;
+      const int* parent_comp;
+      size_t parent_comp_size;
+
+      // Virtual, because the contexts allocated from an arena are
+      // arena_allocated<callback_context> objects.
+      virtual ~callback_context()
       {
 	callback_context::transitions_t::const_iterator it;
 	for (it = transitions.begin(); it != transitions.end(); ++it)
@@ -216,6 +220,26 @@ namespace spot
       }
     };
 
+    // Compute the hash of the successor DST from that of the source
+    // state, and set FIRST_CHANGE to the first variable that differs
+    // (or to the state size).  Successors usually differ from their
+    // source in a few variables only.
+    unsigned successor_hash(const callback_context* ctx, const int* dst,
+			    int& first_change)
+    {
+      const int* src = ctx->parent;
+      int size = ctx->state_size;
+      int i = 0;
+      while (i < size && dst[i] == src[i])
+	++i;
+      first_change = i;
+      unsigned hash = ctx->parent_hash;
+      for (; i < size; ++i)
+	if (dst[i] != src[i])
+	  hash += wang32_slot_hash(i, dst[i]) - wang32_slot_hash(i, src[i]);
+      return hash;
+    }
+
     void transition_callback(void* arg, transition_info_t*, int *dst)
     {
       callback_context* ctx = static_cast<callback_context*>(arg);
@@ -223,7 +247,8 @@ namespace spot
       dve2_state* out =
 	new(p->allocate()) dve2_state(ctx->state_size, p);
       memcpy(out->vars, dst, ctx->state_size * sizeof(int));
-      out->compute_hash();
+      int first_change;
+      out->hash_value = successor_hash(ctx, dst, first_change);
       ctx->transitions.push_back(out);
     }
 
@@ -232,14 +257,22 @@ namespace spot
       callback_context* ctx = static_cast<callback_context*>(arg);
       multiple_size_pool* p = static_cast<multiple_size_pool*>(ctx->pool);
 
+      int first_change;
+      unsigned hash = successor_hash(ctx, dst, first_change);
+
       size_t csize = ctx->state_size * 2;
-      ctx->compress(dst, ctx->state_size, ctx->compressed, csize);
+      if (ctx->parent_comp)
+	int_array_array_recompress2(dst, ctx->state_size, first_change,
+				    ctx->parent_comp, ctx->parent_comp_size,
+				    ctx->compressed, csize);
+      else
+	ctx->compress(dst, ctx->state_size, ctx->compressed, csize);
 
       void* mem = p->allocate(sizeof(dve2_compressed_state)
 			      + sizeof(int) * csize);
       dve2_compressed_state* out = new(mem) dve2_compressed_state(csize, p);
       memcpy(out->vars, ctx->compressed, csize * sizeof(int));
-      out->compute_hash();
+      out->hash_value = hash;
       ctx->transitions.push_back(out);
     }
 
@@ -607,10 +640,22 @@ namespace spot
 		      : int_array_array_decompress2),
 	  uncompressed_(compress ? new int[state_size_ + 30] : 0),
 	  compressed_(compress ? new int[state_size_ * 2] : 0),
-	  statepool_(compress ? sizeof(dve2_compressed_state) :
-		     (sizeof(dve2_state) + state_size_ * sizeof(int))),
 	  state_condition_last_state_(0), state_condition_last_cc_(0)
       {
+	size_t state_bytes = (compress ? sizeof(dve2_compressed_state) :
+			      (sizeof(dve2_state) + state_size_ * sizeof(int)));
+	arena_ = arena_scope::current();
+	if (arena_)
+	  {
+	    statepool_ = arena_->fixed_pool(state_bytes);
+	    compstatepool_ = arena_->multiple_pool();
+	  }
+	else
+	  {
+	    statepool_ = new fixed_size_pool(state_bytes);
+	    compstatepool_ = new multiple_size_pool;
+	  }
+
 	vname_ = new const char*[state_size_];
 	for (int i = 0; i < state_size_; ++i)
 	  vname_[i] = d_->get_state_variable_name(i);
@@ -665,6 +710,12 @@ namespace spot
 	if (state_condition_last_state_)
 	  state_condition_last_state_->destroy();
 	delete state_condition_last_cc_; // Might be 0 already.
+
+	if (!arena_)
+	  {
+	    delete statepool_;
+	    delete compstatepool_;
+	  }
       }
 
       virtual
@@ -676,19 +727,18 @@ namespace spot
 	    size_t csize = state_size_ * 2;
 	    compress_(uncompressed_, state_size_, compressed_, csize);
 
-	    multiple_size_pool* p =
-	      const_cast<multiple_size_pool*>(&compstatepool_);
+	    multiple_size_pool* p = compstatepool_;
 	    void* mem = p->allocate(sizeof(dve2_compressed_state)
 				    + sizeof(int) * csize);
 	    dve2_compressed_state* res = new(mem)
 	      dve2_compressed_state(csize, p);
 	    memcpy(res->vars, compressed_, csize * sizeof(int));
-	    res->compute_hash();
+	    res->hash_value = wang32_sum_hash_array(uncompressed_, state_size_);
 	    return res;
 	  }
 	else
 	  {
-	    fixed_size_pool* p = const_cast<fixed_size_pool*>(&statepool_);
+	    fixed_size_pool* p = statepool_;
 	    dve2_state* res = new(p->allocate()) dve2_state(state_size_, p);
 	    d_->get_initial_state(res->vars);
 	    res->compute_hash();
@@ -737,16 +787,33 @@ namespace spot
 	return res;
       }
 
-      callback_context* build_cc(const int* vars, int& t) const
+      // VARS are the variables of ST, as returned by get_vars(ST).
+      callback_context* build_cc(const state* st, const int* vars,
+				 int& t) const
       {
-	callback_context* cc = new callback_context;
+	callback_context* cc;
+	if (arena_)
+	  cc = new(arena_) arena_allocated<callback_context>;
+	else
+	  cc = new callback_context;
 	cc->state_size = state_size_;
-	cc->pool =
-	  const_cast<void*>(compress_
-			    ? static_cast<const void*>(&compstatepool_)
-			    : static_cast<const void*>(&statepool_));
+	cc->pool = (compress_
+		    ? static_cast<void*>(compstatepool_)
+		    : static_cast<void*>(statepool_));
 	cc->compress = compress_;
 	cc->compressed = compressed_;
+	cc->parent = vars;
+	cc->parent_hash = st->hash();
+	cc->parent_comp = 0;
+	cc->parent_comp_size = 0;
+	if (compress_ == int_array_array_compress2)
+	  {
+	    const dve2_compressed_state* s =
+	      down_cast<const dve2_compressed_state*>(st);
+	    assert(s);
+	    cc->parent_comp = s->vars;
+	    cc->parent_comp_size = s->size;
+	  }
 	t = d_->get_successors(0, const_cast<int*>(vars),
 			       compress_
 			       ? transition_callback_compress
@@ -774,7 +841,7 @@ namespace spot
 
 	bdd res = compute_state_condition_aux(vars);
 	int t;
-	callback_context* cc = build_cc(vars, t);
+	callback_context* cc = build_cc(st, vars, t);
 
 	if (t)
 	  {
@@ -836,13 +903,15 @@ namespace spot
 	else
 	  {
 	    int t;
-	    cc = build_cc(get_vars(local_state), t);
+	    cc = build_cc(local_state, get_vars(local_state), t);
 
 	    // Add a self-loop to dead-states if we care about these.
 	    if (t == 0 && scond != bddfalse)
 	      cc->transitions.push_back(local_state->clone());
 	  }
 
+	if (arena_)
+	  return new(arena_) arena_allocated<dve2_succ_iterator>(cc, scond);
 	return new dve2_succ_iterator(cc, scond);
       }
 
@@ -893,8 +962,11 @@ namespace spot
       void (*decompress_)(const int*, size_t, int*, size_t);
       int* uncompressed_;
       int* compressed_;
-      fixed_size_pool statepool_;
-      multiple_size_pool compstatepool_;
+      // The arena of the states, iterators and contexts, or 0.  The
+      // pools of the states are those of the arena, or our own.
+      arena_scope* arena_;
+      fixed_size_pool* statepool_;
+      multiple_size_pool* compstatepool_;
 
       // This cache is used to speedup repeated calls to state_condition()
       // and get_succ().
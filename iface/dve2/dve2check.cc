@@ -25,11 +25,15 @@
 #include "ltlparse/public.hh"
 #include "tgbaalgos/ltl2tgba_fm.hh"
 #include "tgbaalgos/sccfilter.hh"
+#include "tgbaalgos/degen.hh"
 #include "tgbaalgos/emptiness.hh"
 #include "tgbaalgos/reducerun.hh"
 #include "tgba/tgbaproduct.hh"
+#include "misc/arena.hh"
 #include "misc/timer.hh"
+#include "misc/perfreport.hh"
 #include "misc/memusage.hh"
+#include <cstdlib>
 #include <cstring>
 
 static void
@@ -60,11 +64,19 @@ syntax(char* prog)
 	    << std::endl
             << "  -T     time the different phases of the execution"
 	    << std::endl
+	    << "  -JFILE  write a JSON performance report to FILE"
+	    << std::endl
+	    << "  -W[SECS]  report the progress of the emptiness check on"
+	    << " stderr every SECS" << std::endl
+	    << "          seconds (10 by default, 0 for never) and on SIGUSR1"
+	    << std::endl
             << "  -z     compress states to handle larger models"
 	    << std::endl
             << "  -Z     compress states (faster) "
 	    << "assuming all values in [0 .. 2^28-1]"
-	    << std::endl;
+	    << std::endl
+	    << "  -A     allocate states and iterators in an arena, "
+	    << "released at once" << std::endl;
 
   exit(1);
 }
@@ -75,6 +87,9 @@ main(int argc, char **argv)
   spot::timer_map tm;
 
   bool use_timer = false;
+  const char* json_file = 0;
+  spot::perf_report report("dve2check");
+  const char* progress_interval = 0;
 
   enum { DotFormula, DotModel, DotProduct, EmptinessCheck }
   output = EmptinessCheck;
@@ -82,6 +97,8 @@ main(int argc, char **argv)
   bool expect_counter_example = false;
   char *dead = 0;
   int compress_states = 0;
+  bool use_arena = false;
+  spot::arena_scope* arena = 0;
 
   const char* echeck_algo = "Cou99";
 
@@ -94,6 +111,9 @@ main(int argc, char **argv)
 	{
 	  switch (*++opt)
 	    {
+	    case 'A':
+	      use_arena = true;
+	      break;
 	    case 'C':
 	      accepting_run = true;
 	      break;
@@ -127,6 +147,14 @@ main(int argc, char **argv)
 		  goto error;
 		}
 	      break;
+	    case 'J':
+	      json_file = opt + 1;
+	      if (!*json_file)
+		goto error;
+	      break;
+	    case 'W':
+	      progress_interval = opt + 1;
+	      break;
 	    case 'T':
 	      use_timer = true;
 	      break;
@@ -207,6 +235,9 @@ main(int argc, char **argv)
   atomic_prop_collect(f, &ap);
 
 
+  if (use_arena)
+    arena = new spot::arena_scope;
+
   if (output != DotFormula)
     {
       tm.start("loading dve2");
@@ -241,6 +272,29 @@ main(int argc, char **argv)
   }
   tm.stop("reducing A_f w/ SCC");
 
+  if (echeck_inst)
+    {
+      unsigned n_acc = prop->number_of_acceptance_conditions();
+      // CVWY90, GV04, and SE05 only work with a single acceptance
+      // condition.
+      if (n_acc > echeck_inst->max_acceptance_conditions())
+	{
+	  tm.start("degeneralization");
+	  spot::tgba* aut_degen = spot::degeneralize(prop);
+	  delete prop;
+	  prop = aut_degen;
+	  tm.stop("degeneralization");
+	}
+      else if (n_acc < echeck_inst->min_acceptance_conditions())
+	{
+	  std::cerr << echeck_algo << " requires at least "
+		    << echeck_inst->min_acceptance_conditions()
+		    << " acceptance conditions." << std::endl;
+	  exit_code = 1;
+	  goto safe_exit;
+	}
+    }
+
   if (output == DotFormula)
     {
       tm.start("dotty output");
@@ -266,8 +320,30 @@ main(int argc, char **argv)
     spot::emptiness_check* ec = echeck_inst->instantiate(product);
     bool search_many = echeck_inst->options().get("repeated");
     assert(ec);
+    spot::ec_progress_printer progress(std::cerr);
+    if (progress_interval)
+      if (spot::ec_statistics* ecs = dynamic_cast<spot::ec_statistics*>(ec))
+	{
+	  ecs->set_progress(&progress, *progress_interval
+			    ? strtod(progress_interval, 0) : 10.);
+	  spot::ec_progress::report_on_sigusr1();
+	}
+    // The statistics of each check of a repeated search go to their
+    // own sections of the JSON report.
+    unsigned check_num = 0;
+    std::string ec_section = "emptiness check";
+    std::string run_section = "accepting run";
     do
       {
+	if (search_many)
+	  {
+	    ++check_num;
+	    ec_section =
+	      spot::perf_report::numbered_section("emptiness check",
+						  check_num);
+	    run_section =
+	      spot::perf_report::numbered_section("accepting run", check_num);
+	  }
 	int memused = spot::memusage();
 	tm.start("running emptiness check");
 	spot::emptiness_check_result* res;
@@ -287,6 +363,13 @@ main(int argc, char **argv)
 	tm.stop("running emptiness check");
 	memused = spot::memusage() - memused;
 
+	if (json_file)
+	  {
+	    if (const spot::unsigned_statistics* s = ec->statistics())
+	      report.add_stats(ec_section, *s);
+	    report.add(ec_section, "pages allocated", memused);
+	  }
+
 	ec->print_stats(std::cout);
 	std::cout << memused << " pages allocated for emptiness check"
 		  << std::endl;
@@ -352,6 +435,9 @@ main(int argc, char **argv)
 	    std::cout << "an accepting run exists "
 		      << "(use -C to print it)" << std::endl;
 	  }
+	if (json_file && res)
+	  if (const spot::unsigned_statistics* s = res->statistics())
+	    report.add_stats(run_section, *s);
 	delete res;
       }
     while (search_many);
@@ -363,14 +449,26 @@ main(int argc, char **argv)
   delete product;
   delete prop;
   delete model;
+  delete arena;
   if (f)
     f->destroy();
+  if (json_file)
+    report.add_bdd_stats();
   delete dict;
 
   deadf->destroy();
 
   if (use_timer)
     tm.print(std::cout);
+  if (json_file)
+    {
+      report.add_timers("main", tm);
+      if (!report.print_json(json_file))
+	{
+	  std::cerr << "cannot write `" << json_file << "'" << std::endl;
+	  exit_code = 2;
+	}
+    }
   tm.reset_all();		// This helps valgrind.
 
   spot::ltl::atomic_prop::dump_instances(std::cerr);
@@ -23,6 +23,7 @@
 
 #include "atomic_prop.hh"
 #include "visitor.hh"
+#include "misc/hash.hh"
 #include <cassert>
 #include <ostream>
 
@@ -34,6 +35,7 @@ namespace spot
     atomic_prop::atomic_prop(const std::string& name, environment& env)
       : name_(name), env_(&env)
     {
+      hash_ = hash_combine(3, string_hash()(name));
     }
 
     atomic_prop::~atomic_prop()
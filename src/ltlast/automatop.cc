@@ -22,6 +22,7 @@
 #include "automatop.hh"
 #include "nfa.hh"
 #include "visitor.hh"
+#include "misc/hash.hh"
 
 namespace spot
 {
@@ -30,6 +31,10 @@ namespace spot
     automatop::automatop(const nfa::ptr nfa, vec* v, bool negated)
       : nfa_(nfa), children_(v), negated_(negated)
     {
+      hash_ = hash_combine(hash_combine(7, string_hash()(nfa->get_name())),
+			   negated);
+      for (vec::const_iterator i = v->begin(); i != v->end(); ++i)
+	hash_ = hash_combine(hash_, (*i)->hash());
     }
 
     automatop::~automatop()
@@ -25,25 +25,53 @@
 #include <utility>
 #include "binop.hh"
 #include "visitor.hh"
+#include "misc/hashfunc.hh"
 #include <iostream>
 
 namespace spot
 {
   namespace ltl
   {
+    namespace
+    {
+      inline size_t
+      binop_hash(binop::type op, const formula* first, const formula* second)
+      {
+	return hash_combine(hash_combine(hash_combine(5, op), first->hash()),
+			    second->hash());
+      }
+
+      struct binop_eq
+      {
+	binop_eq(binop::type op, const formula* first, const formula* second)
+	  : op_(op), first_(first), second_(second)
+	{
+	}
+
+	bool
+	operator()(const binop* b) const
+	{
+	  return (b->op() == op_
+		  && b->first() == first_
+		  && b->second() == second_);
+	}
+
+	binop::type op_;
+	const formula* first_;
+	const formula* second_;
+      };
+    }
+
     binop::binop(type op, formula* first, formula* second)
       : op_(op), first_(first), second_(second)
     {
+      hash_ = binop_hash(op, first, second);
     }
 
     binop::~binop()
     {
-      // Get this instance out of the instance map.
-      pairf pf(first(), second());
-      pair p(op(), pf);
-      map::iterator i = instances.find(p);
-      assert (i != instances.end());
-      instances.erase(i);
+      // Get this instance out of the instance table.
+      instances.erase(hash(), this);
 
       // Dereference children.
       first()->destroy();
@@ -125,7 +153,7 @@ namespace spot
       return 0;
     }
 
-    binop::map binop::instances;
+    binop::table binop::instances;
 
     binop*
     binop::instance(type op, formula* first, formula* second)
@@ -149,18 +177,17 @@ namespace spot
 	  break;
 	}
 
-      pairf pf(first, second);
-      pair p(op, pf);
-      map::iterator i = instances.find(p);
-      if (i != instances.end())
+      size_t h = binop_hash(op, first, second);
+      binop* b = instances.find(h, binop_eq(op, first, second));
+      if (b)
 	{
 	  // This instance already exists.
 	  first->destroy();
 	  second->destroy();
-	  return static_cast<binop*>(i->second->clone());
+	  return static_cast<binop*>(b->clone());
 	}
       binop* ap = new binop(op, first, second);
-      instances[p] = ap;
+      instances.insert(h, ap);
       return static_cast<binop*>(ap->clone());
     }
 
@@ -170,14 +197,20 @@ namespace spot
       return instances.size();
     }
 
+    size_t
+    binop::instance_memory()
+    {
+      return instances.memory();
+    }
+
     std::ostream&
     binop::dump_instances(std::ostream& os)
     {
-      for (map::iterator i = instances.begin(); i != instances.end(); ++i)
+      for (table::iterator i = instances.begin(); i != instances.end(); ++i)
 	{
-	  os << i->second << " = "
-	     << i->second->ref_count_() << " * "
-	     << i->second->dump()
+	  os << *i << " = "
+	     << (*i)->ref_count_() << " * "
+	     << (*i)->dump()
 	     << std::endl;
 	}
       return os;
@@ -29,9 +29,9 @@
 #ifndef SPOT_LTLAST_BINOP_HH
 # define SPOT_LTLAST_BINOP_HH
 
-#include <map>
 #include <iosfwd>
 #include "refformula.hh"
+#include "misc/openhash.hh"
 
 namespace spot
 {
@@ -83,14 +83,15 @@ namespace spot
       /// Number of instantiated binary operators.  For debugging.
       static unsigned instance_count();
 
+      /// Number of bytes used by the instance table.  For debugging.
+      static size_t instance_memory();
+
       /// Dump all instances.  For debugging.
       static std::ostream& dump_instances(std::ostream& os);
 
     protected:
-      typedef std::pair<formula*, formula*> pairf;
-      typedef std::pair<type, pairf> pair;
-      typedef std::map<pair, binop*> map;
-      static map instances;
+      typedef open_hash_set<binop> table;
+      static table instances;
 
       binop(type op, formula* first, formula* second);
       virtual ~binop();
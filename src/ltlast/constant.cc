@@ -23,6 +23,7 @@
 
 #include "constant.hh"
 #include "visitor.hh"
+#include "misc/hashfunc.hh"
 #include <cassert>
 
 namespace spot
@@ -32,6 +33,7 @@ namespace spot
     constant::constant(type val)
       : val_(val)
     {
+      hash_ = wang32_hash(val + 1);
     }
 
     constant::~constant()
@@ -73,7 +73,7 @@ namespace spot
     class formula
     {
     public:
-      formula() : count_(++max_count) {}
+      formula() : count_(++max_count), hash_(0) {}
 
       /// Entry point for vspot::ltl::visitor instances.
       virtual void accept(visitor& v) = 0;
@@ -94,9 +94,24 @@ namespace spot
       /// Return a canonic representation of the formula
       virtual std::string dump() const = 0;
 
-      /// Return a hash key for the formula.
+      /// \brief Return a hash key for the formula.
+      ///
+      /// This hash is structural: it is computed from the operator
+      /// and the hashes of the operands when the formula is built,
+      /// so two runs constructing the same formula give it the same
+      /// hash.
       size_t
       hash() const
+      {
+	return hash_;
+      }
+
+      /// \brief Return a unique identifier for the formula.
+      ///
+      /// This is the number of formulae constructed before this
+      /// one.  It is used to order formulae deterministically.
+      size_t
+      id() const
       {
 	return count_;
       }
@@ -109,8 +124,12 @@ namespace spot
       /// the instance must be deleted (usually when the counter hits 0).
       virtual bool unref_();
 
-      /// \brief The hash key of this formula.
+      /// \brief The serial number of this formula.
       size_t count_;
+      /// \brief The structural hash key of this formula.
+      ///
+      /// Subclasses should set it in their constructor.
+      size_t hash_;
 
     private:
       /// \brief Number of formulae created so far.
@@ -140,16 +159,16 @@ namespace spot
 	assert(right);
 	if (left == right)
 	  return false;
-	size_t l = left->hash();
-	size_t r = right->hash();
+	size_t l = left->id();
+	size_t r = right->id();
 	if (l != r)
 	  return l < r;
-	// Because the hash code assigned to each formula is the
-	// number of formulae constructed so far, it is very unlikely
-	// that we will ever reach a case were two different formulae
-	// have the same hash.  This will happen only ever with have
-	// produced 256**sizeof(size_t) formulae (i.e. max_count has
-	// looped back to 0 and started over).  In that case we can
+	// Because the id assigned to each formula is the number of
+	// formulae constructed so far, it is very unlikely that we
+	// will ever reach a case were two different formulae have the
+	// same id.  This will happen only ever with have produced
+	// 256**sizeof(size_t) formulae (i.e. max_count has looped back
+	// to 0 and started over).  In that case we can
 	// order two formulae by looking at their text representation.
 	// We could be more efficient and look at their AST, but it's
 	// not worth the burden.  (Also ordering pointers is ruled out
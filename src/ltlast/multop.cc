@@ -28,23 +28,60 @@
 #include "multop.hh"
 #include "constant.hh"
 #include "visitor.hh"
+#include "misc/hashfunc.hh"
 
 namespace spot
 {
   namespace ltl
   {
+    namespace
+    {
+      // The children are sorted by formula id, which depends on the
+      // order in which formulae were built.  Combine their hashes
+      // commutatively so that the result does not.
+      size_t
+      multop_hash(multop::type op, const multop::vec* v)
+      {
+	size_t sum = 0;
+	for (multop::vec::const_iterator i = v->begin(); i != v->end(); ++i)
+	  sum += wang32_hash((*i)->hash());
+	return hash_combine(hash_combine(6, op), sum);
+      }
+
+      struct multop_eq
+      {
+	multop_eq(multop::type op, const multop::vec* v)
+	  : op_(op), v_(v)
+	{
+	}
+
+	bool
+	operator()(const multop* m) const
+	{
+	  if (m->op() != op_ || m->size() != v_->size())
+	    return false;
+	  unsigned s = m->size();
+	  for (unsigned n = 0; n < s; ++n)
+	    if (m->nth(n) != (*v_)[n])
+	      return false;
+	  return true;
+	}
+
+	multop::type op_;
+	const multop::vec* v_;
+      };
+    }
+
     multop::multop(type op, vec* v)
       : op_(op), children_(v)
     {
+      hash_ = multop_hash(op, v);
     }
 
     multop::~multop()
     {
-      // Get this instance out of the instance map.
-      pair p(op(), children_);
-      map::iterator i = instances.find(p);
-      assert (i != instances.end());
-      instances.erase(i);
+      // Get this instance out of the instance table.
+      instances.erase(hash(), this);
 
       // Dereference children.
       for (unsigned n = 0; n < size(); ++n)
@@ -116,7 +153,7 @@ namespace spot
       return 0;
     }
 
-    multop::map multop::instances;
+    multop::table multop::instances;
 
     formula*
     multop::instance(type op, vec* v)
@@ -191,23 +228,23 @@ namespace spot
 	}
 
       // The hash key.
-      pair p(op, v);
+      size_t h = multop_hash(op, v);
 
-      map::iterator i = instances.find(p);
-      if (i != instances.end())
+      multop* m = instances.find(h, multop_eq(op, v));
+      if (m)
 	{
 	  // The instance already exists.
 	  for (vec::iterator vi = v->begin(); vi != v->end(); ++vi)
 	    (*vi)->destroy();
 	  delete v;
-	  return static_cast<multop*>(i->second->clone());
+	  return static_cast<multop*>(m->clone());
 	}
 
       // This is the first instance of this formula.
 
-      // Record the instance in the map,
+      // Record the instance in the table,
       multop* ap = new multop(op, v);
-      instances[p] = ap;
+      instances.insert(h, ap);
       return ap->clone();
     }
 
@@ -226,14 +263,20 @@ namespace spot
       return instances.size();
     }
 
+    size_t
+    multop::instance_memory()
+    {
+      return instances.memory();
+    }
+
     std::ostream&
     multop::dump_instances(std::ostream& os)
     {
-      for (map::iterator i = instances.begin(); i != instances.end(); ++i)
+      for (table::iterator i = instances.begin(); i != instances.end(); ++i)
 	{
-	  os << i->second << " = "
-	     << i->second->ref_count_() << " * "
-	     << i->second->dump()
+	  os << *i << " = "
+	     << (*i)->ref_count_() << " * "
+	     << (*i)->dump()
 	     << std::endl;
 	}
       return os;
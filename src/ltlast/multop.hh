@@ -27,9 +27,9 @@
 # define SPOT_LTLAST_MULTOP_HH
 
 #include <vector>
-#include <map>
 #include <iosfwd>
 #include "refformula.hh"
+#include "misc/openhash.hh"
 
 namespace spot
 {
@@ -101,24 +101,15 @@ namespace spot
       /// Number of instantiated multi-operand operators.  For debugging.
       static unsigned instance_count();
 
+      /// Number of bytes used by the instance table.  For debugging.
+      static size_t instance_memory();
+
       /// Dump all instances.  For debugging.
       static std::ostream& dump_instances(std::ostream& os);
 
     protected:
-      typedef std::pair<type, vec*> pair;
-      /// Comparison functor used internally by ltl::multop.
-      struct paircmp
-      {
-	bool
-	operator () (const pair& p1, const pair& p2) const
-	{
-	  if (p1.first != p2.first)
-	    return p1.first < p2.first;
-	  return *p1.second < *p2.second;
-	}
-      };
-      typedef std::map<pair, multop*, paircmp> map;
-      static map instances;
+      typedef open_hash_set<multop> table;
+      static table instances;
 
       multop(type op, vec* v);
       virtual ~multop();
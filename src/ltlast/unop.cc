@@ -23,6 +23,7 @@
 
 #include "unop.hh"
 #include "visitor.hh"
+#include "misc/hashfunc.hh"
 #include <cassert>
 #include <iostream>
 
@@ -30,18 +31,42 @@ namespace spot
 {
   namespace ltl
   {
+    namespace
+    {
+      inline size_t
+      unop_hash(unop::type op, const formula* child)
+      {
+	return hash_combine(hash_combine(4, op), child->hash());
+      }
+
+      struct unop_eq
+      {
+	unop_eq(unop::type op, const formula* child)
+	  : op_(op), child_(child)
+	{
+	}
+
+	bool
+	operator()(const unop* u) const
+	{
+	  return u->op() == op_ && u->child() == child_;
+	}
+
+	unop::type op_;
+	const formula* child_;
+      };
+    }
+
     unop::unop(type op, formula* child)
       : op_(op), child_(child)
     {
+      hash_ = unop_hash(op, child);
     }
 
     unop::~unop()
     {
-      // Get this instance out of the instance map.
-      pair p(op(), child());
-      map::iterator i = instances.find(p);
-      assert (i != instances.end());
-      instances.erase(i);
+      // Get this instance out of the instance table.
+      instances.erase(hash(), this);
 
       // Dereference child.
       child()->destroy();
@@ -104,21 +129,21 @@ namespace spot
       return 0;
     }
 
-    unop::map unop::instances;
+    unop::table unop::instances;
 
     unop*
     unop::instance(type op, formula* child)
     {
-      pair p(op, child);
-      map::iterator i = instances.find(p);
-      if (i != instances.end())
+      size_t h = unop_hash(op, child);
+      unop* u = instances.find(h, unop_eq(op, child));
+      if (u)
 	{
 	  // This instance already exists.
 	  child->destroy();
-	  return static_cast<unop*>(i->second->clone());
+	  return static_cast<unop*>(u->clone());
 	}
       unop* ap = new unop(op, child);
-      instances[p] = ap;
+      instances.insert(h, ap);
       return static_cast<unop*>(ap->clone());
     }
 
@@ -128,14 +153,20 @@ namespace spot
       return instances.size();
     }
 
+    size_t
+    unop::instance_memory()
+    {
+      return instances.memory();
+    }
+
     std::ostream&
     unop::dump_instances(std::ostream& os)
     {
-      for (map::iterator i = instances.begin(); i != instances.end(); ++i)
+      for (table::iterator i = instances.begin(); i != instances.end(); ++i)
 	{
-	  os << i->second << " = "
-	     << i->second->ref_count_() << " * "
-	     << i->second->dump()
+	  os << *i << " = "
+	     << (*i)->ref_count_() << " * "
+	     << (*i)->dump()
 	     << std::endl;
 	}
       return os;
@@ -26,9 +26,9 @@
 #ifndef SPOT_LTLAST_UNOP_HH
 # define SPOT_LTLAST_UNOP_HH
 
-#include <map>
 #include <iosfwd>
 #include "refformula.hh"
+#include "misc/openhash.hh"
 
 namespace spot
 {
@@ -65,13 +65,15 @@ namespace spot
       /// Number of instantiated unary operators.  For debugging.
       static unsigned instance_count();
 
+      /// Number of bytes used by the instance table.  For debugging.
+      static size_t instance_memory();
+
       /// Dump all instances.  For debugging.
       static std::ostream& dump_instances(std::ostream& os);
 
     protected:
-      typedef std::pair<type, formula*> pair;
-      typedef std::map<pair, unop*> map;
-      static map instances;
+      typedef open_hash_set<unop> table;
+      static table instances;
 
       unop(type op, formula* child);
       virtual ~unop();
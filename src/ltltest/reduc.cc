@@ -34,6 +34,7 @@
 #include "ltlvisit/nenoform.hh"
 #include "ltlvisit/tostring.hh"
 #include "ltlvisit/reduce.hh"
+#include "ltlvisit/reducecache.hh"
 #include "ltlvisit/length.hh"
 #include "ltlvisit/contain.hh"
 #include "ltlast/allnodes.hh"
@@ -150,6 +151,10 @@ main(int argc, char** argv)
 
   int exit_code = 0;
 
+  // Share the reductions of subformulae between all the formulae
+  // of the file.
+  spot::ltl::reduce_cache cache;
+
  next_line:
 
   if (fin)
@@ -205,7 +210,7 @@ main(int argc, char** argv)
     std::string f1s_before = spot::ltl::to_string(f1);
 
     ftmp1 = f1;
-    f1 = spot::ltl::reduce(f1, o);
+    f1 = spot::ltl::reduce(f1, o, &cache);
     ftmp2 = f1;
     f1 = spot::ltl::unabbreviate_logic(f1);
     ftmp1->destroy();
@@ -287,6 +292,7 @@ main(int argc, char** argv)
       delete fin;
     }
 
+  cache.clear();
   assert(spot::ltl::atomic_prop::instance_count() == 0);
   assert(spot::ltl::unop::instance_count() == 0);
   assert(spot::ltl::binop::instance_count() == 0);
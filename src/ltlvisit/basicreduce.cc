@@ -22,6 +22,7 @@
 // 02111-1307, USA.
 
 #include "basicreduce.hh"
+#include "reducecache.hh"
 #include "ltlast/visitor.hh"
 #include "ltlast/allnodes.hh"
 #include <cassert>
@@ -62,7 +63,10 @@ namespace spot
       {
       public:
 
-	basic_reduce_visitor(){}
+	basic_reduce_visitor(reduce_cache* cache)
+	  : cache_(cache)
+	{
+	}
 
 	virtual ~basic_reduce_visitor(){}
 
@@ -72,6 +76,12 @@ namespace spot
 	  return result_;
 	}
 
+	formula*
+	recurse(const formula* f)
+	{
+	  return basic_reduce(f, cache_);
+	}
+
 	void
 	visit(atomic_prop* ap)
 	{
@@ -116,7 +126,7 @@ namespace spot
 	visit(unop* uo)
 	{
 	  formula* f = uo->child();
-	  result_ = basic_reduce(f);
+	  result_ = recurse(f);
 	  multop* mo = 0;
 	  unop* u = 0;
 	  binop* bo = 0;
@@ -161,10 +171,10 @@ namespace spot
 		  formula* res =
 		    unop::instance(unop::X,
 				   unop::instance(unop::F,
-						  basic_reduce(u->child())));
+						  recurse(u->child())));
 		  u->destroy();
 		  // FXX(a) = XXF(a) ...
-		  result_ = basic_reduce(res);
+		  result_ = recurse(res);
 		  res->destroy();
 		  return;
 		}
@@ -206,7 +216,7 @@ namespace spot
 	      if (bo && bo->op() == binop::R)
 		{
 		  result_ = unop::instance(unop::G,
-					   basic_reduce(bo->second()));
+					   recurse(bo->second()));
 		  bo->destroy();
 		  return;
 		}
@@ -218,11 +228,11 @@ namespace spot
 		  formula* res =
 		    unop::instance(unop::X,
 				   unop::instance(unop::G,
-						  basic_reduce(u->child())));
+						  recurse(u->child())));
 		  u->destroy();
 		  // GXX(a) = XXG(a) ...
 		  // GXF(a) = XGF(a) = GF(a) ...
-		  result_ = basic_reduce(res);
+		  result_ = recurse(res);
 		  res->destroy();
 		  return;
 		}
@@ -258,16 +268,16 @@ namespace spot
 	    case binop::Equiv:
 	    case binop::Implies:
 	      result_ = binop::instance(bo->op(),
-					basic_reduce(f1),
-					basic_reduce(f2));
+					recurse(f1),
+					recurse(f2));
 	      return;
 	    case binop::W:
 	    case binop::M:
 	    case binop::U:
 	    case binop::R:
 	      {
-		f1 = basic_reduce(f1);
-		f2 = basic_reduce(f2);
+		f1 = recurse(f1);
+		f2 = recurse(f2);
 
 		// a W false = Ga
 		if (op == binop::W && f2 == constant::false_instance())
@@ -305,9 +315,9 @@ namespace spot
 		    && fu2->op() == unop::X)
 		  {
 		    formula* ftmp = binop::instance(op,
-						    basic_reduce(fu1->child()),
-						    basic_reduce(fu2->child()));
-		    result_ = unop::instance(unop::X, basic_reduce(ftmp));
+						    recurse(fu1->child()),
+						    recurse(fu2->child()));
+		    result_ = unop::instance(unop::X, recurse(ftmp));
 		    f1->destroy();
 		    f2->destroy();
 		    ftmp->destroy();
@@ -427,7 +437,7 @@ namespace spot
 	  multop::vec* tmpOther = new multop::vec;
 
 	  for (unsigned i = 0; i < mos; ++i)
-	    res->push_back(basic_reduce(mo->nth(i)));
+	    res->push_back(recurse(mo->nth(i)));
 
 	  switch (op)
 	    {
@@ -855,15 +865,25 @@ namespace spot
 
       protected:
 	formula* result_;
+	reduce_cache* cache_;
       };
     }
 
     formula*
-    basic_reduce(const formula* f)
+    basic_reduce(const formula* f, reduce_cache* cache)
     {
-      basic_reduce_visitor v;
+      if (cache)
+	{
+	  formula* res = cache->basic_reduced(f);
+	  if (res)
+	    return res;
+	}
+      basic_reduce_visitor v(cache);
       const_cast<formula*>(f)->accept(v);
-      return v.result();
+      formula* res = v.result();
+      if (cache)
+	cache->set_basic_reduced(f, res);
+      return res;
     }
 
   }
@@ -28,9 +28,14 @@ namespace spot
 {
   namespace ltl
   {
+    class reduce_cache;
+
     /// \brief Basic rewritings.
     /// \ingroup ltl_rewriting
-    formula* basic_reduce(const formula* f);
+    ///
+    /// If \a cache is non-null, the rewriting of each subformula is
+    /// looked up there first, and recorded there.
+    formula* basic_reduce(const formula* f, reduce_cache* cache = 0);
 
     /// \brief Whether a formula starts with GF.
     /// \ingroup ltl_misc
@@ -30,22 +30,32 @@
 #include "tgba/tgbaproduct.hh"
 #include "tgbaalgos/gtec/gtec.hh"
 #include "tgbaalgos/save.hh"
+#include "tostring.hh"
+
 namespace spot
 {
   namespace ltl
   {
+    namespace
+    {
+      // First line of the cache files.  Bump the number whenever
+      // the format or the meaning of the verdicts changes.
+      const char cache_version[] = "spot-containment-cache 1";
+    }
 
     language_containment_checker::language_containment_checker
       (bdd_dict* dict, bool exprop, bool symb_merge,
        bool branching_postponement, bool fair_loop_approx)
       : dict_(dict), exprop_(exprop), symb_merge_(symb_merge),
       branching_postponement_(branching_postponement),
-      fair_loop_approx_(fair_loop_approx)
+      fair_loop_approx_(fair_loop_approx), cache_file_(0),
+      hits_(0), file_hits_(0), misses_(0)
     {
     }
 
     language_containment_checker::~language_containment_checker()
     {
+      delete cache_file_;
       while (!translated_.empty())
 	{
 	  trans_map::iterator i = translated_.begin();
@@ -56,14 +66,117 @@ namespace spot
 	}
     }
 
+    std::string
+    language_containment_checker::options_() const
+    {
+      std::string res = "----";
+      res[0] = exprop_ ? 'x' : '-';
+      res[1] = symb_merge_ ? 's' : '-';
+      res[2] = branching_postponement_ ? 'b' : '-';
+      res[3] = fair_loop_approx_ ? 'f' : '-';
+      return res;
+    }
+
+    bool
+    language_containment_checker::use_cache_file(const std::string& filename)
+    {
+      delete cache_file_;
+      cache_file_ = 0;
+
+      // Lines have the form "OPTIONS VERDICT\tLEFT\tRIGHT".
+      bool fresh = true;
+      std::string opt = options_();
+      std::ifstream in(filename.c_str());
+      if (in)
+	{
+	  std::string line;
+	  if (std::getline(in, line) && line == cache_version)
+	    {
+	      fresh = false;
+	      while (std::getline(in, line))
+		{
+		  std::string::size_type t1 = line.find('\t');
+		  if (t1 != opt.size() + 2 || line.compare(0, opt.size(), opt)
+		      || line[opt.size()] != ' ')
+		    continue;
+		  std::string::size_type t2 = line.find('\t', t1 + 1);
+		  if (t2 == std::string::npos)
+		    continue;
+		  bool v = line[t1 - 1] == '1';
+		  std::string l = line.substr(t1 + 1, t2 - t1 - 1);
+		  std::string r = line.substr(t2 + 1);
+		  file_verdicts_[l + '\t' + r] = v;
+		  file_verdicts_[r + '\t' + l] = v;
+		}
+	    }
+	}
+      in.close();
+
+      if (fresh)
+	cache_file_ = new std::ofstream(filename.c_str(), std::ios::trunc);
+      else
+	cache_file_ = new std::ofstream(filename.c_str(), std::ios::app);
+      if (!*cache_file_)
+	{
+	  delete cache_file_;
+	  cache_file_ = 0;
+	  return false;
+	}
+      if (fresh)
+	*cache_file_ << cache_version << std::endl;
+      return true;
+    }
+
+    unsigned
+    language_containment_checker::hits() const
+    {
+      return hits_;
+    }
+
+    unsigned
+    language_containment_checker::file_hits() const
+    {
+      return file_hits_;
+    }
+
+    unsigned
+    language_containment_checker::misses() const
+    {
+      return misses_;
+    }
+
     bool
     language_containment_checker::incompatible_(record_* l, record_* g)
     {
       record_::incomp_map::const_iterator i = l->incompatible.find(g);
       if (i != l->incompatible.end())
-	return i->second;
+	{
+	  ++hits_;
+	  return i->second;
+	}
 
-      const tgba* p = new tgba_product(l->translation, g->translation);
+      std::string key;
+      bool savable = false;
+      if (cache_file_)
+	{
+	  // Formulae whose names cannot be written on one line are
+	  // not saved.
+	  savable = (name_(l).find_first_of("\t\n") == std::string::npos
+		     && name_(g).find_first_of("\t\n") == std::string::npos);
+	  key = name_(l) + '\t' + name_(g);
+	  verdict_map::const_iterator j = file_verdicts_.find(key);
+	  if (j != file_verdicts_.end())
+	    {
+	      ++hits_;
+	      ++file_hits_;
+	      l->incompatible[g] = j->second;
+	      g->incompatible[l] = j->second;
+	      return j->second;
+	    }
+	}
+
+      ++misses_;
+      const tgba* p = new tgba_product(translation_(l), translation_(g));
       emptiness_check* ec = couvreur99(p);
       emptiness_check_result* ecr = ec->check();
       if (!ecr)
@@ -79,6 +192,9 @@ namespace spot
 	}
       delete ec;
       delete p;
+
+      if (savable)
+	*cache_file_ << options_() << ' ' << !ecr << '\t' << key << std::endl;
       return !ecr;
     }
 
@@ -132,14 +248,31 @@ namespace spot
       if (i != translated_.end())
 	return &i->second;
 
-      const tgba_explicit* e = ltl_to_tgba_fm(f, dict_, exprop_, symb_merge_,
-					      branching_postponement_,
-					      fair_loop_approx_);
-      record_& r = translated_[f->clone()];
-      r.translation = e;
+      f = f->clone();
+      record_& r = translated_[f];
+      r.f = f;
+      r.translation = 0;
       return &r;
     }
 
+    const tgba*
+    language_containment_checker::translation_(record_* r)
+    {
+      if (!r->translation)
+	r->translation = ltl_to_tgba_fm(r->f, dict_, exprop_, symb_merge_,
+					branching_postponement_,
+					fair_loop_approx_);
+      return r->translation;
+    }
+
+    const std::string&
+    language_containment_checker::name_(record_* r)
+    {
+      if (r->name.empty())
+	r->name = to_string(r->f);
+      return r->name;
+    }
+
 
     namespace
     {
@@ -383,18 +516,20 @@ namespace spot
     }
 
     formula*
-    reduce_tau03(const formula* f, bool stronger)
+    reduce_tau03(const formula* f, bool stronger,
+		 language_containment_checker* lcc)
     {
       bdd_dict b;
-      reduce_tau03_visitor v(stronger,
-			     new language_containment_checker(&b,
-							      true, true,
-							      false, false));
+      language_containment_checker* own = 0;
+      if (!lcc)
+	lcc = own = new language_containment_checker(&b, true, true,
+						     false, false);
+      reduce_tau03_visitor v(stronger, lcc);
       // reduce_tau03_visitor does not handle Xor, Implies, and Equiv.
       f = unabbreviate_ltl(f);
       const_cast<formula*>(f)->accept(v);
       f->destroy();
-      delete v.lcc;
+      delete own;
       return v.result();
     }
   }
@@ -26,6 +26,8 @@
 #include "tgbaalgos/ltl2tgba_fm.hh"
 #include "misc/hash.hh"
 #include <map>
+#include <string>
+#include <fstream>
 
 namespace spot
 {
@@ -36,12 +38,18 @@ namespace spot
     {
       struct record_
       {
+	const formula* f;
+	// Translated lazily, when an emptiness check is needed.
 	const tgba* translation;
+	// String representation of f, computed lazily for the
+	// cache file.
+	std::string name;
 	typedef std::map<const record_*, bool> incomp_map;
 	incomp_map incompatible;
       };
       typedef Sgi::hash_map<const formula*,
 			    record_, formula_ptr_hash> trans_map;
+      typedef Sgi::hash_map<std::string, bool, string_hash> verdict_map;
     public:
       /// This class uses spot::ltl_to_tgba_fm to translate LTL
       /// formulae.  See that class for the meaning of these options.
@@ -62,11 +70,39 @@ namespace spot
       /// Check whether L(l) = L(g).
       bool equal(const formula* l, const formula* g);
 
+      /// \brief Keep the containment verdicts in \a filename.
+      ///
+      /// The verdicts already recorded in \a filename for the
+      /// translation options of this checker are loaded, and every
+      /// new verdict is appended to the file, so that later runs
+      /// (or later checkers) do not have to compute them again.
+      /// Formulae are identified by their string representation.
+      ///
+      /// The file starts with a version line.  A file with another
+      /// version is discarded and started afresh.
+      ///
+      /// \return false if \a filename cannot be written to.
+      bool use_cache_file(const std::string& filename);
+
+      /// \brief Number of verdicts answered without emptiness check.
+      ///
+      /// This counts the verdicts found in memory, and those found in
+      /// the cache file (which are also counted by file_hits()).
+      unsigned hits() const;
+      /// Number of verdicts found in the cache file.
+      unsigned file_hits() const;
+      /// Number of verdicts that required an emptiness check.
+      unsigned misses() const;
+
     protected:
       bool incompatible_(record_* l, record_* g);
 
       record_* register_formula_(const formula* f);
 
+      const tgba* translation_(record_* r);
+      const std::string& name_(record_* r);
+      std::string options_() const;
+
       /* Translation options */
       bdd_dict* dict_;
       bool exprop_;
@@ -75,6 +111,13 @@ namespace spot
       bool fair_loop_approx_;
       /* Translation Maps */
       trans_map translated_;
+      /* Verdicts read from the cache file, indexed by
+	 "left\tright".  */
+      verdict_map file_verdicts_;
+      std::ofstream* cache_file_;
+      unsigned hits_;
+      unsigned file_hits_;
+      unsigned misses_;
     };
 
     /// \brief Reduce a formula using language containment relationships.
@@ -101,7 +144,12 @@ namespace spot
     /// If \a stronger is set, additional rules are used to further
     /// reduce some U, R, and X usages.
     /// \endverbatim
-    formula* reduce_tau03(const formula* f, bool stronger = true);
+    ///
+    /// The containment checks are done by \a lcc if it is non-null
+    /// (e.g., to share a cache file between several calls), or by a
+    /// temporary checker otherwise.
+    formula* reduce_tau03(const formula* f, bool stronger = true,
+			  language_containment_checker* lcc = 0);
   }
 }
 
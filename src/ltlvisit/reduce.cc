@@ -22,6 +22,7 @@
 // 02111-1307, USA.
 
 #include "reduce.hh"
+#include "reducecache.hh"
 #include "basicreduce.hh"
 #include "syntimpl.hh"
 #include "ltlast/allnodes.hh"
@@ -196,8 +197,8 @@ namespace spot
       {
       public:
 
-	reduce_visitor(int opt)
-	  : opt_(opt)
+	reduce_visitor(int opt, reduce_cache* cache)
+	  : opt_(opt), cache_(cache)
 	{
 	}
 
@@ -312,14 +313,14 @@ namespace spot
 
 		case binop::U:
 		  /* a < b => a U b = b */
-		  if (syntactic_implication(f1, f2))
+		  if (syntactic_implication(f1, f2, cache_))
 		    {
 		      result_ = f2;
 		      f1->destroy();
 		      return;
 		    }
 		  /* !b < a => a U b = Fb */
-		  if (syntactic_implication_neg(f2, f1, false))
+		  if (syntactic_implication_neg(f2, f1, false, cache_))
 		    {
 		      result_ = unop::instance(unop::F, f2);
 		      f1->destroy();
@@ -330,7 +331,7 @@ namespace spot
 		  {
 		    binop* bo = dynamic_cast<binop*>(f2);
 		    if (bo && (bo->op() == binop::U || bo->op() == binop::W)
-			&& syntactic_implication(f1, bo->first()))
+			&& syntactic_implication(f1, bo->first(), cache_))
 		      {
 			result_ = f2;
 			f1->destroy();
@@ -341,14 +342,14 @@ namespace spot
 
 		case binop::R:
 		  /* b < a => a R b = b */
-		  if (syntactic_implication(f2, f1))
+		  if (syntactic_implication(f2, f1, cache_))
 		    {
 		      result_ = f2;
 		      f1->destroy();
 		      return;
 		    }
 		  /* b < !a => a R b = Gb */
-		  if (syntactic_implication_neg(f2, f1, true))
+		  if (syntactic_implication_neg(f2, f1, true, cache_))
 		    {
 		      result_ = unop::instance(unop::G, f2);
 		      f1->destroy();
@@ -359,7 +360,7 @@ namespace spot
 		  {
 		    binop* bo = dynamic_cast<binop*>(f2);
 		    if (bo && (bo->op() == binop::R || bo->op() == binop::M)
-			&& syntactic_implication(bo->first(), f1))
+			&& syntactic_implication(bo->first(), f1, cache_))
 		      {
 			result_ = f2;
 			f1->destroy();
@@ -370,7 +371,7 @@ namespace spot
 		  {
 		    binop* bo = dynamic_cast<binop*>(f2);
 		    if (bo && bo->op() == binop::R
-			&& syntactic_implication(f1, bo->first()))
+			&& syntactic_implication(f1, bo->first(), cache_))
 		      {
 			result_ = binop::instance(binop::R, f1,
 						  bo->second()->clone());
@@ -382,14 +383,14 @@ namespace spot
 
 		case binop::W:
 		  /* a < b => a W b = b */
-		  if (syntactic_implication(f1, f2))
+		  if (syntactic_implication(f1, f2, cache_))
 		    {
 		      result_ = f2;
 		      f1->destroy();
 		      return;
 		    }
 		  /* !b < a => a W b = 1 */
-		  if (syntactic_implication_neg(f2, f1, false))
+		  if (syntactic_implication_neg(f2, f1, false, cache_))
 		    {
 		      result_ = constant::true_instance();
 		      f1->destroy();
@@ -400,7 +401,7 @@ namespace spot
 		  {
 		    binop* bo = dynamic_cast<binop*>(f2);
 		    if (bo && bo->op() == binop::W
-			&& syntactic_implication(f1, bo->first()))
+			&& syntactic_implication(f1, bo->first(), cache_))
 		      {
 			result_ = f2;
 			f1->destroy();
@@ -411,14 +412,14 @@ namespace spot
 
 		case binop::M:
 		  /* b < a => a M b = b */
-		  if (syntactic_implication(f2, f1))
+		  if (syntactic_implication(f2, f1, cache_))
 		    {
 		      result_ = f2;
 		      f1->destroy();
 		      return;
 		    }
 		  /* b < !a => a M b = 0 */
-		  if (syntactic_implication_neg(f2, f1, true))
+		  if (syntactic_implication_neg(f2, f1, true, cache_))
 		    {
 		      result_ = constant::false_instance();
 		      f1->destroy();
@@ -429,7 +430,7 @@ namespace spot
 		  {
 		    binop* bo = dynamic_cast<binop*>(f2);
 		    if (bo && bo->op() == binop::M
-			&& syntactic_implication(bo->first(), f1))
+			&& syntactic_implication(bo->first(), f1, cache_))
 		      {
 			result_ = f2;
 			f1->destroy();
@@ -441,7 +442,7 @@ namespace spot
 		  {
 		    binop* bo = dynamic_cast<binop*>(f2);
 		    if (bo && (bo->op() == binop::M || bo->op() == binop::R)
-			&& syntactic_implication(f1, bo->first()))
+			&& syntactic_implication(f1, bo->first(), cache_))
 		      {
 			result_ = binop::instance(binop::M, f1,
 						  bo->second()->clone());
@@ -487,9 +488,11 @@ namespace spot
 		      assert(f1 != f2);
 		      // a < b => a + b = b
 		      // a < b => a & b = a
-		      if ((syntactic_implication(*f1, *f2) && // f1 < f2
+		      if ((syntactic_implication(*f1, *f2, // f1 < f2
+						 cache_) &&
 			   (mo->op() == multop::Or)) ||
-			  ((syntactic_implication(*f2, *f1)) && // f2 < f1
+			  ((syntactic_implication(*f2, *f1, // f2 < f1
+						  cache_)) &&
 			   (mo->op() == multop::And)))
 			{
 			  // We keep f2
@@ -498,9 +501,11 @@ namespace spot
 			  removed = true;
 			  break;
 			}
-		      else if ((syntactic_implication(*f2, *f1) && // f2 < f1
+		      else if ((syntactic_implication(*f2, *f1, // f2 < f1
+						      cache_) &&
 				(mo->op() == multop::Or)) ||
-			       ((syntactic_implication(*f1, *f2)) && // f1 < f2
+			       ((syntactic_implication(*f1, *f2, // f1 < f2
+						       cache_)) &&
 				(mo->op() == multop::And)))
 			{
 			  // We keep f1
@@ -520,7 +525,8 @@ namespace spot
 		for (f2 = res->begin(); f2 != res->end(); f2++)
 		  if (f1 != f2 &&
 		      syntactic_implication_neg(*f1, *f2,
-						mo->op() !=  multop::Or))
+						mo->op() !=  multop::Or,
+						cache_))
 		    {
 		      for (multop::vec::iterator j = res->begin();
 			   j != res->end(); j++)
@@ -547,19 +553,33 @@ namespace spot
 	formula*
 	recurse(formula* f)
 	{
-	  return reduce(f, opt_);
+	  return reduce(f, opt_, cache_);
 	}
 
       protected:
 	formula* result_;
 	int opt_;
+	reduce_cache* cache_;
       };
 
     } // anonymous
 
     formula*
-    reduce(const formula* f, int opt)
+    reduce(const formula* f, int opt, reduce_cache* cache)
     {
+      // Without a cache supplied by the caller, still share the
+      // results between the subformulae of f.
+      if (!cache)
+	{
+	  reduce_cache local;
+	  return reduce(f, opt, &local);
+	}
+
+      formula* res = cache->reduced(f, opt);
+      if (res)
+	return res;
+      const formula* orig = f;
+
       formula* f1;
       formula* f2;
       formula* prev = 0;
@@ -588,7 +608,7 @@ namespace spot
 
 	  if (opt & Reduce_Basics)
 	    {
-	      f1 = basic_reduce(f2);
+	      f1 = basic_reduce(f2, cache);
 	      f2->destroy();
 	      f2 = f1;
 	    }
@@ -596,7 +616,7 @@ namespace spot
 	  if (opt & (Reduce_Syntactic_Implications
 		     | Reduce_Eventuality_And_Universality))
 	    {
-	      reduce_visitor v(opt);
+	      reduce_visitor v(opt, cache);
 	      f2->accept(v);
 	      f1 = v.result();
 	      f2->destroy();
@@ -609,13 +629,15 @@ namespace spot
 	    {
 	      formula* f1 =
 		reduce_tau03(f2,
-			     opt & Reduce_Containment_Checks_Stronger);
+			     opt & Reduce_Containment_Checks_Stronger,
+			     cache->containment_checker());
 	      f2->destroy();
 	      f2 = f1;
 	    }
 	  f = f2;
 	}
       prev->destroy();
+      cache->set_reduced(orig, opt, f);
       return const_cast<formula*>(f);
     }
 
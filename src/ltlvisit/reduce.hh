@@ -29,6 +29,7 @@ namespace spot
 {
   namespace ltl
   {
+    class reduce_cache;
 
     /// \addtogroup ltl_rewriting
     /// @{
@@ -57,8 +58,13 @@ namespace spot
     /// \param f the formula to reduce
     /// \param opt a conjonction of spot::ltl::reduce_options specifying
     ///            which optimizations to apply.
+    /// \param cache a cache in which to memoize the reductions of
+    ///            the subformulae of \a f.  Pass the same cache to
+    ///            several calls to share the work between them.  If
+    ///            null, a temporary cache is used for this call.
     /// \return the reduced formula
-    formula* reduce(const formula* f, int opt = Reduce_All);
+    formula* reduce(const formula* f, int opt = Reduce_All,
+		    reduce_cache* cache = 0);
     /// @}
 
     /// \brief Check whether a formula is a pure eventuality.
@@ -0,0 +1,186 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#include "reducecache.hh"
+
+namespace spot
+{
+  namespace ltl
+  {
+    reduce_cache::reduce_cache(unsigned max_entries)
+      : lcc_(0), max_entries_(max_entries), hits_(0), misses_(0), flushes_(0)
+    {
+    }
+
+    reduce_cache::~reduce_cache()
+    {
+      clear();
+    }
+
+    void
+    reduce_cache::clear()
+    {
+      for (reduce_map::iterator i = reduced_.begin();
+	   i != reduced_.end(); ++i)
+	{
+	  i->first.first->destroy();
+	  i->second->destroy();
+	}
+      reduced_.clear();
+      for (basic_map::iterator i = basic_.begin(); i != basic_.end(); ++i)
+	{
+	  i->first->destroy();
+	  i->second->destroy();
+	}
+      basic_.clear();
+      for (impl_map::iterator i = impl_.begin(); i != impl_.end(); ++i)
+	{
+	  i->first.first->destroy();
+	  i->first.second->destroy();
+	}
+      impl_.clear();
+    }
+
+    void
+    reduce_cache::reserve_()
+    {
+      if (max_entries_ && size() >= max_entries_)
+	{
+	  clear();
+	  ++flushes_;
+	}
+    }
+
+    formula*
+    reduce_cache::reduced(const formula* f, int opt)
+    {
+      reduce_map::const_iterator i = reduced_.find(fopt(f, opt));
+      if (i == reduced_.end())
+	{
+	  ++misses_;
+	  return 0;
+	}
+      ++hits_;
+      return i->second->clone();
+    }
+
+    void
+    reduce_cache::set_reduced(const formula* f, int opt, const formula* res)
+    {
+      reserve_();
+      std::pair<reduce_map::iterator, bool> p =
+	reduced_.insert(reduce_map::value_type(fopt(f, opt), res));
+      if (p.second)
+	{
+	  f->clone();
+	  res->clone();
+	}
+    }
+
+    formula*
+    reduce_cache::basic_reduced(const formula* f)
+    {
+      basic_map::const_iterator i = basic_.find(f);
+      if (i == basic_.end())
+	{
+	  ++misses_;
+	  return 0;
+	}
+      ++hits_;
+      return i->second->clone();
+    }
+
+    void
+    reduce_cache::set_basic_reduced(const formula* f, const formula* res)
+    {
+      reserve_();
+      std::pair<basic_map::iterator, bool> p =
+	basic_.insert(basic_map::value_type(f, res));
+      if (p.second)
+	{
+	  f->clone();
+	  res->clone();
+	}
+    }
+
+    int
+    reduce_cache::implication(const formula* f1, const formula* f2)
+    {
+      impl_map::const_iterator i = impl_.find(fpair(f1, f2));
+      if (i == impl_.end())
+	{
+	  ++misses_;
+	  return -1;
+	}
+      ++hits_;
+      return i->second;
+    }
+
+    void
+    reduce_cache::set_implication(const formula* f1, const formula* f2,
+				  bool res)
+    {
+      reserve_();
+      std::pair<impl_map::iterator, bool> p =
+	impl_.insert(impl_map::value_type(fpair(f1, f2), res));
+      if (p.second)
+	{
+	  f1->clone();
+	  f2->clone();
+	}
+    }
+
+    void
+    reduce_cache::set_containment_checker(language_containment_checker* lcc)
+    {
+      lcc_ = lcc;
+    }
+
+    language_containment_checker*
+    reduce_cache::containment_checker() const
+    {
+      return lcc_;
+    }
+
+    unsigned
+    reduce_cache::size() const
+    {
+      return reduced_.size() + basic_.size() + impl_.size();
+    }
+
+    unsigned
+    reduce_cache::hits() const
+    {
+      return hits_;
+    }
+
+    unsigned
+    reduce_cache::misses() const
+    {
+      return misses_;
+    }
+
+    unsigned
+    reduce_cache::flushes() const
+    {
+      return flushes_;
+    }
+  }
+}
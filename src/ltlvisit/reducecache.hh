@@ -0,0 +1,154 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#ifndef SPOT_LTLVISIT_REDUCECACHE_HH
+# define SPOT_LTLVISIT_REDUCECACHE_HH
+
+#include "ltlast/formula.hh"
+#include "misc/hash.hh"
+#include <utility>
+
+namespace spot
+{
+  namespace ltl
+  {
+    class language_containment_checker;
+
+    /// \brief Memoize the results of the LTL rewriting passes.
+    /// \ingroup ltl_rewriting
+    ///
+    /// Because formulae are hash-consed, the result of
+    /// spot::ltl::reduce, spot::ltl::basic_reduce, or
+    /// spot::ltl::syntactic_implication only depends on the address
+    /// of their arguments (and on the reduction options).  This
+    /// class remembers these results so that subformulae shared by
+    /// several formulae (or occurring several times in the same
+    /// formula) are processed only once.
+    ///
+    /// The cache holds a reference to every formula it stores.  It is
+    /// emptied when it reaches its maximal size, or explicitly with
+    /// clear().  It must be cleared or destroyed before the program
+    /// checks that all formulae have been released.
+    ///
+    /// A single cache can be shared by all the formulae of a file:
+    /// \code
+    ///   spot::ltl::reduce_cache cache;
+    ///   while (spot::ltl::formula* f = file.next())
+    ///     {
+    ///       spot::ltl::formula* r = spot::ltl::reduce(f, opt, &cache);
+    ///       ...
+    ///     }
+    /// \endcode
+    class reduce_cache
+    {
+    public:
+      /// \brief Create an empty cache.
+      ///
+      /// \param max_entries the number of results the cache may hold
+      /// before being flushed.  0 means no limit.
+      reduce_cache(unsigned max_entries = 1 << 16);
+      ~reduce_cache();
+
+      /// \brief Forget all results, and release the formulae.
+      void clear();
+
+      /// \brief Look up the result of reduce(f, opt).
+      ///
+      /// Return 0 if it is unknown, or a clone of the result.
+      formula* reduced(const formula* f, int opt);
+      /// Remember that reduce(f, opt) is \a res.
+      void set_reduced(const formula* f, int opt, const formula* res);
+
+      /// \brief Look up the result of basic_reduce(f).
+      ///
+      /// Return 0 if it is unknown, or a clone of the result.
+      formula* basic_reduced(const formula* f);
+      /// Remember that basic_reduce(f) is \a res.
+      void set_basic_reduced(const formula* f, const formula* res);
+
+      /// \brief Look up the result of syntactic_implication(f1, f2).
+      ///
+      /// Return -1 if it is unknown, 0 or 1 otherwise.
+      int implication(const formula* f1, const formula* f2);
+      /// Remember that syntactic_implication(f1, f2) is \a res.
+      void set_implication(const formula* f1, const formula* f2, bool res);
+
+      /// \brief Use \a lcc for the containment checks of reduce().
+      ///
+      /// The checker is not owned by the cache.  If none is set,
+      /// spot::ltl::reduce_tau03 uses a temporary checker.
+      void set_containment_checker(language_containment_checker* lcc);
+      /// The checker set by set_containment_checker(), or 0.
+      language_containment_checker* containment_checker() const;
+
+      /// Number of results currently held.
+      unsigned size() const;
+      /// Number of successful lookups since the construction.
+      unsigned hits() const;
+      /// Number of failed lookups since the construction.
+      unsigned misses() const;
+      /// Number of times the cache was flushed because it was full.
+      unsigned flushes() const;
+
+    private:
+      typedef std::pair<const formula*, int> fopt;
+      struct fopt_hash
+      {
+	size_t
+	operator()(const fopt& p) const
+	{
+	  return hash_combine(p.first->hash(), p.second);
+	}
+      };
+      typedef std::pair<const formula*, const formula*> fpair;
+      struct fpair_hash
+      {
+	size_t
+	operator()(const fpair& p) const
+	{
+	  return hash_combine(p.first->hash(), p.second->hash());
+	}
+      };
+      typedef Sgi::hash_map<fopt, const formula*, fopt_hash> reduce_map;
+      typedef Sgi::hash_map<const formula*, const formula*,
+			    formula_ptr_hash> basic_map;
+      typedef Sgi::hash_map<fpair, bool, fpair_hash> impl_map;
+
+      // Make room for a new entry.
+      void reserve_();
+
+      // Disallow copy.
+      reduce_cache(const reduce_cache&);
+      reduce_cache& operator=(const reduce_cache&);
+
+      reduce_map reduced_;
+      basic_map basic_;
+      impl_map impl_;
+      language_containment_checker* lcc_;
+      unsigned max_entries_;
+      unsigned hits_;
+      unsigned misses_;
+      unsigned flushes_;
+    };
+
+  }
+}
+
+#endif // SPOT_LTLVISIT_REDUCECACHE_HH
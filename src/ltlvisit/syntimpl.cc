@@ -22,6 +22,7 @@
 // 02111-1307, USA.
 
 #include "syntimpl.hh"
+#include "reducecache.hh"
 #include "ltlast/allnodes.hh"
 #include <cassert>
 
@@ -40,8 +41,8 @@ namespace spot
       {
       public:
 
-	inf_right_recurse_visitor(const formula *f)
-	  : result_(false), f(f)
+	inf_right_recurse_visitor(const formula *f, reduce_cache* cache)
+	  : result_(false), f(f), cache_(cache)
 	{
 	}
 
@@ -91,16 +92,16 @@ namespace spot
 	      {
 		const unop* op = dynamic_cast<const unop*>(f);
 		if (op && op->op() == unop::X)
-		  result_ = syntactic_implication(op->child(), f1);
+		  result_ = syntactic_implication(op->child(), f1, cache_);
 	      }
 	      return;
 	    case unop::F:
 	      /* F(a) = true U a */
-	      result_ = syntactic_implication(f, f1);
+	      result_ = syntactic_implication(f, f1, cache_);
 	      return;
 	    case unop::G:
 	      /* G(a) = false R a */
-	      if (syntactic_implication(f, constant::false_instance()))
+	      if (syntactic_implication(f, constant::false_instance(), cache_))
 		result_ = true;
 	      return;
 	    case unop::Finish:
@@ -125,45 +126,45 @@ namespace spot
 	      return;
 	    case binop::U:
 	    case binop::W:
-	      if (syntactic_implication(f, f2))
+	      if (syntactic_implication(f, f2, cache_))
 		result_ = true;
 	      return;
 	    case binop::R:
 	      if (fb && fb->op() == binop::R)
-		if (syntactic_implication(fb->first(), f1) &&
-		    syntactic_implication(fb->second(), f2))
+		if (syntactic_implication(fb->first(), f1, cache_) &&
+		    syntactic_implication(fb->second(), f2, cache_))
 		  {
 		    result_ = true;
 		    return;
 		  }
 	      if (fu && fu->op() == unop::G)
 		if (f1 == constant::false_instance() &&
-		    syntactic_implication(fu->child(), f2))
+		    syntactic_implication(fu->child(), f2, cache_))
 		  {
 		    result_ = true;
 		    return;
 		  }
-	      if (syntactic_implication(f, f1)
-		  && syntactic_implication(f, f2))
+	      if (syntactic_implication(f, f1, cache_)
+		  && syntactic_implication(f, f2, cache_))
 		result_ = true;
 	      return;
 	    case binop::M:
 	      if (fb && fb->op() == binop::M)
-		if (syntactic_implication(fb->first(), f1) &&
-		    syntactic_implication(fb->second(), f2))
+		if (syntactic_implication(fb->first(), f1, cache_) &&
+		    syntactic_implication(fb->second(), f2, cache_))
 		  {
 		    result_ = true;
 		    return;
 		  }
 	      if (fu && fu->op() == unop::F)
 		if (f2 == constant::true_instance() &&
-		    syntactic_implication(fu->child(), f1))
+		    syntactic_implication(fu->child(), f1, cache_))
 		  {
 		    result_ = true;
 		    return;
 		  }
-	      if (syntactic_implication(f, f1)
-		  && syntactic_implication(f, f2))
+	      if (syntactic_implication(f, f1, cache_)
+		  && syntactic_implication(f, f2, cache_))
 		result_ = true;
 	      return;
 	    }
@@ -186,13 +187,13 @@ namespace spot
 	    {
 	    case multop::And:
 	      for (unsigned i = 0; i < mos; ++i)
-		if (!syntactic_implication(f, mo->nth(i)))
+		if (!syntactic_implication(f, mo->nth(i), cache_))
 		  return;
 	      result_ = true;
 	      break;
 	    case multop::Or:
 	      for (unsigned i = 0; i < mos && !result_; ++i)
-		if (syntactic_implication(f, mo->nth(i)))
+		if (syntactic_implication(f, mo->nth(i), cache_))
 		  result_ = true;
 	      break;
 	    }
@@ -201,6 +202,7 @@ namespace spot
       protected:
 	bool result_; /* true if f < f1, false otherwise. */
 	const formula* f;
+	reduce_cache* cache_;
       };
 
       /////////////////////////////////////////////////////////////////////////
@@ -209,8 +211,8 @@ namespace spot
       {
       public:
 
-	inf_left_recurse_visitor(const formula *f)
-	  : result_(false), f(f)
+	inf_left_recurse_visitor(const formula *f, reduce_cache* cache)
+	  : result_(false), f(f), cache_(cache)
 	{
 	}
 
@@ -224,8 +226,8 @@ namespace spot
 	{
 	  const binop* fb = dynamic_cast<const binop*>(f);
 	  if (fb && fb->op() == f2->op()
-	      && syntactic_implication(f2->first(), fb->first())
-	      && syntactic_implication(f2->second(), fb->second()))
+	      && syntactic_implication(f2->first(), fb->first(), cache_)
+	      && syntactic_implication(f2->second(), fb->second(), cache_))
 	    return true;
 	  return false;
 	}
@@ -239,7 +241,7 @@ namespace spot
 	void
 	visit(const atomic_prop* ap)
 	{
-	  inf_right_recurse_visitor v(ap);
+	  inf_right_recurse_visitor v(ap, cache_);
 	  const_cast<formula*>(f)->accept(v);
 	  result_ = v.result();
 	}
@@ -247,7 +249,7 @@ namespace spot
 	void
 	visit(const constant* c)
 	{
-	  inf_right_recurse_visitor v(c);
+	  inf_right_recurse_visitor v(c, cache_);
 	  switch (c->val())
 	    {
 	    case constant::True:
@@ -266,7 +268,7 @@ namespace spot
 	visit(const unop* uo)
 	{
 	  const formula* f1 = uo->child();
-	  inf_right_recurse_visitor v(uo);
+	  inf_right_recurse_visitor v(uo, cache_);
 	  switch (uo->op())
 	    {
 	    case unop::Not:
@@ -277,7 +279,7 @@ namespace spot
 	      {
 		const unop* op = dynamic_cast<const unop*>(f);
 		if (op && op->op() == unop::X)
-		  result_ = syntactic_implication(f1, op->child());
+		  result_ = syntactic_implication(f1, op->child(), cache_);
 	      }
 	      return;
 	    case unop::F:
@@ -292,7 +294,7 @@ namespace spot
 		    tmp->destroy();
 		    return;
 		  }
-		if (syntactic_implication(tmp, f))
+		if (syntactic_implication(tmp, f, cache_))
 		  result_ = true;
 		tmp->destroy();
 		return;
@@ -309,7 +311,7 @@ namespace spot
 		    tmp->destroy();
 		    return;
 		  }
-		if (syntactic_implication(tmp, f))
+		if (syntactic_implication(tmp, f, cache_))
 		  result_ = true;
 		tmp->destroy();
 		return;
@@ -343,63 +345,63 @@ namespace spot
 	    case binop::U:
 	      /* (a < c) && (c < d) => a U b < c U d */
 	      if (fb && fb->op() == binop::U)
-		if (syntactic_implication(f1, fb->first()) &&
-		    syntactic_implication(f2, fb->second()))
+		if (syntactic_implication(f1, fb->first(), cache_) &&
+		    syntactic_implication(f2, fb->second(), cache_))
 		  {
 		    result_ = true;
 		    return;
 		  }
 	      if (fu && fu->op() == unop::F)
 		if (f1 == constant::true_instance() &&
-		    syntactic_implication(f2, fu->child()))
+		    syntactic_implication(f2, fu->child(), cache_))
 		  {
 		    result_ = true;
 		    return;
 		  }
-	      if (syntactic_implication(f1, f)
-		  && syntactic_implication(f2, f))
+	      if (syntactic_implication(f1, f, cache_)
+		  && syntactic_implication(f2, f, cache_))
 		result_ = true;
 	      return;
 	    case binop::W:
 	      /* (a < c) && (c < d) => a W b < c W d */
 	      if (fb && fb->op() == binop::W)
-		if (syntactic_implication(f1, fb->first()) &&
-		    syntactic_implication(f2, fb->second()))
+		if (syntactic_implication(f1, fb->first(), cache_) &&
+		    syntactic_implication(f2, fb->second(), cache_))
 		  {
 		    result_ = true;
 		    return;
 		  }
 	      if (fu && fu->op() == unop::G)
 		if (f2 == constant::false_instance() &&
-		    syntactic_implication(f1, fu->child()))
+		    syntactic_implication(f1, fu->child(), cache_))
 		  {
 		    result_ = true;
 		    return;
 		  }
-	      if (syntactic_implication(f1, f)
-		  && syntactic_implication(f2, f))
+	      if (syntactic_implication(f1, f, cache_)
+		  && syntactic_implication(f2, f, cache_))
 		result_ = true;
 	      return;
 	    case binop::R:
 	      if (fu && fu->op() == unop::G)
 		if (f1 == constant::false_instance() &&
-		    syntactic_implication(f2, fu->child()))
+		    syntactic_implication(f2, fu->child(), cache_))
 		  {
 		    result_ = true;
 		    return;
 		  }
-	      if (syntactic_implication(f2, f))
+	      if (syntactic_implication(f2, f, cache_))
 		result_ = true;
 	      return;
 	    case binop::M:
 	      if (fu && fu->op() == unop::F)
 		if (f2 == constant::true_instance() &&
-		    syntactic_implication(f1, fu->child()))
+		    syntactic_implication(f1, fu->child(), cache_))
 		  {
 		    result_ = true;
 		    return;
 		  }
-	      if (syntactic_implication(f2, f))
+	      if (syntactic_implication(f2, f, cache_))
 		result_ = true;
 	      return;
 	    }
@@ -422,12 +424,12 @@ namespace spot
 	    {
 	    case multop::And:
 	      for (unsigned i = 0; (i < mos) && !result_; ++i)
-		if (syntactic_implication(mo->nth(i), f))
+		if (syntactic_implication(mo->nth(i), f, cache_))
 		  result_ = true;
 	      break;
 	    case multop::Or:
 	      for (unsigned i = 0; i < mos; ++i)
-		if (!syntactic_implication(mo->nth(i), f))
+		if (!syntactic_implication(mo->nth(i), f, cache_))
 		  return;
 	      result_ = true;
 	      break;
@@ -437,6 +439,7 @@ namespace spot
       protected:
 	bool result_; /* true if f1 < f, 1 otherwise. */
 	const formula* f;
+	reduce_cache* cache_;
       };
 
     } // anonymous
@@ -444,7 +447,8 @@ namespace spot
     // This is called by syntactic_implication() after the
     // formulae have been normalized.
     bool
-    syntactic_implication(const formula* f1, const formula* f2)
+    syntactic_implication(const formula* f1, const formula* f2,
+			  reduce_cache* cache)
     {
       if (f1 == f2)
 	return true;
@@ -452,22 +456,36 @@ namespace spot
 	  || f1 == constant::false_instance())
 	return true;
 
-      inf_left_recurse_visitor v1(f2);
-      inf_right_recurse_visitor v2(f1);
+      if (cache)
+	{
+	  int known = cache->implication(f1, f2);
+	  if (known >= 0)
+	    return known;
+	}
+
+      bool result = false;
 
+      inf_left_recurse_visitor v1(f2, cache);
       const_cast<formula*>(f1)->accept(v1);
       if (v1.result())
-	return true;
-
-      const_cast<formula*>(f2)->accept(v2);
-      if (v2.result())
-	return true;
+	{
+	  result = true;
+	}
+      else
+	{
+	  inf_right_recurse_visitor v2(f1, cache);
+	  const_cast<formula*>(f2)->accept(v2);
+	  result = v2.result();
+	}
 
-      return false;
+      if (cache)
+	cache->set_implication(f1, f2, result);
+      return result;
     }
 
     bool
-    syntactic_implication_neg(const formula* f1, const formula* f2, bool right)
+    syntactic_implication_neg(const formula* f1, const formula* f2, bool right,
+			      reduce_cache* cache)
     {
       formula* l = f1->clone();
       formula* r = f2->clone();
@@ -492,7 +510,7 @@ namespace spot
       r->destroy();
       r = tmp;
 
-      bool result = syntactic_implication(l, r);
+      bool result = syntactic_implication(l, r, cache);
       l->destroy();
       r->destroy();
       return result;
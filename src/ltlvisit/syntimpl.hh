@@ -28,6 +28,7 @@ namespace spot
 {
   namespace ltl
   {
+    class reduce_cache;
 
     /// \brief Syntactic implication.
     /// \ingroup ltl_misc
@@ -46,7 +47,11 @@ namespace spot
     /// publisher	= {Springer-Verlag}
     /// }
     /// \endverbatim
-    bool syntactic_implication(const formula* f1, const formula* f2);
+    ///
+    /// If \a cache is non-null, it is used to memoize the verdicts
+    /// of this function and of its recursive calls.
+    bool syntactic_implication(const formula* f1, const formula* f2,
+			       reduce_cache* cache = 0);
 
     /// \brief Syntactic implication.
     /// \ingroup ltl_misc
@@ -56,7 +61,7 @@ namespace spot
     ///
     /// \see syntactic_implication
     bool syntactic_implication_neg(const formula* f1, const formula* f2,
-				   bool right);
+				   bool right, reduce_cache* cache = 0);
   }
 }
 
@@ -0,0 +1,162 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#include <new>
+#include <cassert>
+#ifndef HAVE_TLS
+# include <pthread.h>
+#endif
+#include "arena.hh"
+
+#ifndef HAVE_TLS
+// The key of the innermost scope of each thread, created once.
+static pthread_key_t current_arena_key;
+static pthread_once_t current_arena_once = PTHREAD_ONCE_INIT;
+
+extern "C"
+{
+  static void
+  create_current_arena_key()
+  {
+    pthread_key_create(&current_arena_key, 0);
+  }
+}
+#endif
+
+namespace spot
+{
+  namespace
+  {
+#ifdef HAVE_TLS
+    // The innermost scope of each thread.
+    __thread arena_scope* current_arena = 0;
+
+    arena_scope*
+    get_current_arena()
+    {
+      return current_arena;
+    }
+
+    void
+    set_current_arena(arena_scope* a)
+    {
+      current_arena = a;
+    }
+#else
+    arena_scope*
+    get_current_arena()
+    {
+      pthread_once(&current_arena_once, create_current_arena_key);
+      return static_cast<arena_scope*>
+	(pthread_getspecific(current_arena_key));
+    }
+
+    void
+    set_current_arena(arena_scope* a)
+    {
+      pthread_once(&current_arena_once, create_current_arena_key);
+      pthread_setspecific(current_arena_key, a);
+    }
+#endif
+  }
+
+  arena_scope::arena_scope()
+    : previous_(get_current_arena())
+  {
+    set_current_arena(this);
+  }
+
+  arena_scope::~arena_scope()
+  {
+    // Scopes must be closed in the reverse order, by the thread that
+    // opened them.
+    assert(get_current_arena() == this);
+    set_current_arena(previous_);
+    for (fixed_map::iterator i = fixed_.begin(); i != fixed_.end(); ++i)
+      delete i->second;
+  }
+
+  arena_scope*
+  arena_scope::current()
+  {
+    return get_current_arena();
+  }
+
+  fixed_size_pool*
+  arena_scope::fixed_pool(size_t size)
+  {
+    fixed_size_pool*& p = fixed_[size];
+    if (!p)
+      p = new fixed_size_pool(size);
+    return p;
+  }
+
+  size_t
+  arena_scope::allocated_bytes() const
+  {
+    size_t res = multiple_.allocated_bytes();
+    for (fixed_map::const_iterator i = fixed_.begin(); i != fixed_.end(); ++i)
+      res += i->second->allocated_bytes();
+    return res;
+  }
+
+  namespace
+  {
+    // Each arena_object is preceded by the arena it was allocated
+    // from.  The header keeps the alignment of the object.
+    union arena_header
+    {
+      arena_scope* arena;
+      size_t align_[2];
+    };
+  }
+
+  void*
+  arena_object::operator new(size_t size, arena_scope* arena)
+  {
+    assert(arena);
+    arena_header* h = static_cast<arena_header*>
+      (arena->multiple_pool()->allocate(size + sizeof(arena_header)));
+    h->arena = arena;
+    return h + 1;
+  }
+
+  void
+  arena_object::operator delete(void*, arena_scope*)
+  {
+    // The size is not known here.  The block is lost until the
+    // arena is released.
+  }
+
+  void
+  arena_object::operator delete(void* ptr, size_t size)
+  {
+    if (!ptr)
+      return;
+    arena_header* h = static_cast<arena_header*>(ptr) - 1;
+    h->arena->multiple_pool()->deallocate(h, size + sizeof(arena_header));
+  }
+
+  arena_scope*
+  arena_object::arena_of(const void* ptr)
+  {
+    return (static_cast<const arena_header*>(ptr) - 1)->arena;
+  }
+}
@@ -0,0 +1,166 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#ifndef SPOT_MISC_ARENA_HH
+#  define SPOT_MISC_ARENA_HH
+
+#include <cstddef>
+#include <map>
+#include "misc/fixpool.hh"
+#include "misc/mspool.hh"
+
+namespace spot
+{
+
+  /// \brief A region of memory for the states and iterators of a
+  ///        check, released all at once.
+  ///
+  /// The automata that support it (tgba_product, tgba_tba_proxy,
+  /// tgba_sba_proxy, the Kripke structures of the DiVinE interface)
+  /// allocate their states and iterators from the arena that is
+  /// current when they are created, and from the heap otherwise.
+  /// Objects are still recycled one at a time during the check, but
+  /// the emptiness checks created in the scope (couvreur99() and the
+  /// magic searches) no longer destroy the states they have visited
+  /// one by one when they are deleted: their memory is released in
+  /// bulk with the arena.
+  ///
+  /// Using an arena is a promise that all the states visited by
+  /// these checks own nothing but memory from the arena or from
+  /// their automaton (as the states of explicit automata, of the
+  /// DiVinE interface, of tgba_tba_proxy, and of products of these).
+  /// The states of tgba_bdd_concrete, for instance, hold BDDs that
+  /// would never be released.
+  ///
+  /// Scopes may be nested; the innermost one is used.  Every object
+  /// created in a scope (automata, emptiness checks, and their
+  /// states and iterators) must be deleted before the scope ends.
+  ///
+  /// The current scope is kept per thread (in a \c __thread
+  /// variable, or with \c pthread_getspecific() if the compiler does
+  /// not support \c __thread).  An arena_scope, and the objects
+  /// allocated from it, must only be used by the thread that opened
+  /// it: its pools are not thread-safe.
+  class arena_scope
+  {
+  public:
+    /// Open a scope, that becomes the current one.
+    arena_scope();
+    /// Close the scope, and release all its memory.
+    ~arena_scope();
+
+    /// The innermost arena_scope of this thread, or 0 if there is
+    /// none.
+    static arena_scope* current();
+
+    /// A pool of blocks of \a size bytes.
+    fixed_size_pool* fixed_pool(size_t size);
+
+    /// A pool of blocks of any size.
+    multiple_size_pool*
+    multiple_pool()
+    {
+      return &multiple_;
+    }
+
+    /// The number of bytes obtained from the system by this arena.
+    size_t allocated_bytes() const;
+
+  private:
+    // Disallow copy.
+    arena_scope(const arena_scope&);
+    arena_scope& operator=(const arena_scope&);
+
+    arena_scope* previous_;
+    typedef std::map<size_t, fixed_size_pool*> fixed_map;
+    fixed_map fixed_;
+    multiple_size_pool multiple_;
+  };
+
+  /// \brief Base class for objects allocated from an arena_scope.
+  ///
+  /// Objects of derived classes are allocated with
+  /// <code>new(arena) T(...)</code>, and are returned to \c arena when
+  /// deleted.  The arena is recorded in front of each object.
+  ///
+  /// A class whose objects only sometimes come from an arena should
+  /// not derive from arena_object itself, so that the objects
+  /// allocated from the heap pay nothing: allocate
+  /// arena_allocated<T> objects instead when there is an arena.
+  class arena_object
+  {
+  public:
+    static void* operator new(size_t size, arena_scope* arena);
+    // Called if the constructor throws.
+    static void operator delete(void* ptr,
+				arena_scope* arena);
+    static void operator delete(void* ptr,
+				size_t size);
+
+    /// \brief The arena from which the object at \a ptr was
+    ///        allocated.
+    ///
+    /// \a ptr must point to the complete object (e.g., \c this in
+    /// the most derived class).
+    static arena_scope* arena_of(const void* ptr);
+  };
+
+  /// \brief A \a T allocated from an arena_scope.
+  ///
+  /// \a T must have a virtual destructor if arena_allocated<T>
+  /// objects are deleted through a pointer to \a T.  The constructor
+  /// arguments are passed to the constructor of \a T.
+  template <class T>
+  class arena_allocated: public T, public arena_object
+  {
+  public:
+    arena_allocated()
+    {
+    }
+
+    template <class A1>
+    explicit arena_allocated(const A1& a1)
+      : T(a1)
+    {
+    }
+
+    template <class A1, class A2>
+    arena_allocated(const A1& a1, const A2& a2)
+      : T(a1, a2)
+    {
+    }
+
+    template <class A1, class A2, class A3>
+    arena_allocated(const A1& a1, const A2& a2, const A3& a3)
+      : T(a1, a2, a3)
+    {
+    }
+
+    template <class A1, class A2, class A3, class A4, class A5, class A6>
+    arena_allocated(const A1& a1, const A2& a2, const A3& a3,
+		    const A4& a4, const A5& a5, const A6& a6)
+      : T(a1, a2, a3, a4, a5, a6)
+    {
+    }
+  };
+
+}
+
+#endif // SPOT_MISC_ARENA_HH
@@ -35,7 +35,8 @@ namespace spot
   public:
     /// Create a pool allocating objects of \a size bytes.
     fixed_size_pool(size_t size)
-      : freelist_(0), free_start_(0), free_end_(0), chunklist_(0)
+      : freelist_(0), free_start_(0), free_end_(0), chunklist_(0),
+	allocated_(0), used_(0)
     {
       const size_t alignement = 2 * sizeof(size_t);
       size_ = ((size >= sizeof(block_) ? size : sizeof(block_))
@@ -59,6 +60,7 @@ namespace spot
     {
       block_* f = freelist_;
       // If we have free blocks available, return the first one.
+      ++used_;
       if (f)
 	{
 	  freelist_ = f->next;
@@ -77,6 +79,7 @@ namespace spot
 	    throw std::bad_alloc();
 	  c->prev = chunklist_;
 	  chunklist_ = c;
+	  allocated_ += requested;
 
 	  free_start_ = c->data_ + size_;
 	  free_end_ = c->data_ + requested;
@@ -100,6 +103,25 @@ namespace spot
       block_* b = reinterpret_cast<block_*>(const_cast<void*>(ptr));
       b->next = freelist_;
       freelist_ = b;
+      --used_;
+    }
+
+    /// The number of bytes obtained from the system.
+    size_t
+    allocated_bytes() const
+    {
+      return allocated_;
+    }
+
+    /// \brief The number of bytes in the blocks that have been
+    /// allocated and not recycled.
+    ///
+    /// Blocks are counted with the size they have in the pool, which
+    /// may be larger than the size requested.
+    size_t
+    used_bytes() const
+    {
+      return used_ * size_;
     }
 
   private:
@@ -109,6 +131,8 @@ namespace spot
     char* free_end_;
     // chunk = several agglomerated blocks
     union chunk_ { chunk_* prev; char data_[1]; }* chunklist_;
+    size_t allocated_;
+    size_t used_;
   };
 
 }
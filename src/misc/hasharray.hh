@@ -0,0 +1,74 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#ifndef SPOT_MISC_HASHARRAY_HH
+# define SPOT_MISC_HASHARRAY_HH
+
+# include "hashfunc.hh"
+
+namespace spot
+{
+  /// \addtogroup hash_funcs
+  /// @{
+
+  /// \brief Hash an array of integers with spot::wang32_hash().
+  ///
+  /// Each value is combined with the hash of the previous ones.  The
+  /// result fits in 32 bits.
+  inline unsigned
+  wang32_hash_array(const int* array, unsigned size)
+  {
+    unsigned hash = 0;
+    for (unsigned i = 0; i < size; ++i)
+      hash = wang32_hash(hash ^ static_cast<unsigned>(array[i]));
+    return hash;
+  }
+
+  /// \brief Hash of value \a value at position \a slot of an array.
+  ///
+  /// See wang32_sum_hash_array().
+  inline unsigned
+  wang32_slot_hash(unsigned slot, int value)
+  {
+    // 0x9e3779b9 is the golden ratio of 2^32: it spreads the slots
+    // apart, so that small values in different slots do not collide.
+    return wang32_hash(static_cast<unsigned>(value) + slot * 0x9e3779b9U);
+  }
+
+  /// \brief Hash an array of integers as the sum of the hashes of
+  ///        its slots.
+  ///
+  /// Contrary to wang32_hash_array(), this hash can be updated when
+  /// some values of the array change, without looking at the others:
+  /// when the value at position \a i changes from \a a to \a b, add
+  /// wang32_slot_hash(i, b) - wang32_slot_hash(i, a) to the hash.
+  inline unsigned
+  wang32_sum_hash_array(const int* array, unsigned size)
+  {
+    unsigned hash = 0;
+    for (unsigned i = 0; i < size; ++i)
+      hash += wang32_slot_hash(i, array[i]);
+    return hash;
+  }
+
+  /// @}
+}
+
+#endif // SPOT_MISC_HASHARRAY_HH
@@ -59,6 +59,18 @@ namespace spot
     // bits assumes that all objects are aligned on a 8 byte boundary.
     return (key >> 3) * 2654435761U;
   }
+
+  /// \brief Combine the hash value \a seed with the hash of \a key.
+  ///
+  /// This is useful to compute the hash value of a composite object
+  /// out of the hash values of its parts.  The result depends on the
+  /// order in which the parts are combined.  (This is the mixing
+  /// function of Boost's hash_combine.)
+  inline size_t
+  hash_combine(size_t seed, size_t key)
+  {
+    return seed ^ (wang32_hash(key) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+  }
   /// @}
 }
 
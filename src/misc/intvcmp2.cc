@@ -21,6 +21,11 @@
 #include <cstddef>
 #include <cassert>
 #include "intvcmp2.hh"
+#include "simd.hh"
+
+#ifdef SPOT_HAVE_X86_SIMD
+#  include <immintrin.h>
+#endif
 
 #if __GNUC__ >= 3
 #  define likely(expr)   __builtin_expect(!!(expr), 1)
@@ -45,6 +50,40 @@ namespace spot
     // 1110:  2 14-bit values
     // 1111:  1 28-bit value
 
+    const unsigned bits_width[7] = { 1, 3, 5, 7, 9, 14, 28 };
+    const unsigned max_count[8] = { 30, 10, 6, 4, 3, 2, 1, 0 };
+    const unsigned max_allowed[8] = { 1,
+				      (1 << 3) - 1,
+				      (1 << 5) - 1,
+				      (1 << 7) - 1,
+				      (1 << 9) - 1,
+				      (1 << 14) - 1,
+				      (1 << 28) - 1,
+				      -1U };
+    // If we have only X data to compress and they fit with the
+    // current bit width, the following table tells us we should
+    // use bits_width[count_to_level[X - 1]] to limit the number
+    // of trailing zeros we encode.  E.g.  count_to_level[5 - 1]
+    // is 2, which mean that 5 values should be encoded with
+    // bits_width[2] == 5 bits.
+    const unsigned count_to_level[30] =
+      {
+	6, // 1
+	5, // 2
+	4, // 3
+	3, // 4
+	2, // 5
+	2, // 6
+	1, // 7
+	1, // 8
+	1, // 9
+	1, // 10
+	0, 0, 0, 0, 0, // 11-15
+	0, 0, 0, 0, 0, // 16-20
+	0, 0, 0, 0, 0, // 21-25
+	0, 0, 0, 0, 0, // 26-30
+      };
+
     template <class Self>
     class stream_compression_base
     {
@@ -54,195 +93,169 @@ namespace spot
       {
       }
 
-      void run()
+      // Compress the input from position \a pos.
+      void run(unsigned int pos = 0)
       {
-	static const unsigned bits_width[7] = { 1, 3, 5, 7, 9, 14, 28 };
-	static const unsigned max_count[8] = { 30, 10, 6, 4, 3, 2, 1, 0 };
-	static const unsigned max_allowed[8] = { 1,
-						 (1 << 3) - 1,
-						 (1 << 5) - 1,
-						 (1 << 7) - 1,
-						 (1 << 9) - 1,
-						 (1 << 14) - 1,
-						 (1 << 28) - 1,
-						 -1U };
-	// If we have only X data to compress and they fit with the
-	// current bit width, the following table tells us we should
-	// use bits_width[count_to_level[X - 1]] to limit the number
-	// of trailing zeros we encode.  E.g.  count_to_level[5 - 1]
-	// is 2, which mean that 5 values should be encoded with
-	// bits_width[2] == 5 bits.
-	static const unsigned count_to_level[30] =
-	  {
-	    6, // 1
-	    5, // 2
-	    4, // 3
-	    3, // 4
-	    2, // 5
-	    2, // 6
-	    1, // 7
-	    1, // 8
-	    1, // 9
-	    1, // 10
-	    0, 0, 0, 0, 0, // 11-15
-	    0, 0, 0, 0, 0, // 16-20
-	    0, 0, 0, 0, 0, // 21-25
-	    0, 0, 0, 0, 0, // 26-30
-	  };
-
-	unsigned int pos = 0;
 	while (pos < size_)
+	  pos = encode_chunk(pos);
+      }
+
+      // Encode one integer of output, starting at input position
+      // \a pos, and return the position of the next input.
+      unsigned int encode_chunk(unsigned int pos)
+      {
+	unsigned id = 0;	// Current level in the above two tables.
+	unsigned curmax_allowed = max_allowed[id];
+	unsigned compressable = 0; // Number of integer ready to pack.
+	do
 	  {
-	    unsigned id = 0;	// Current level in the above two tables.
-	    unsigned curmax_allowed = max_allowed[id];
-	    unsigned compressable = 0; // Number of integer ready to pack.
-	    do
+	    unsigned int val = self().data_at(pos + compressable);
+	    ++compressable;
+	    while (val > curmax_allowed)
 	      {
-		unsigned int val = self().data_at(pos + compressable);
-		++compressable;
-		while (val > curmax_allowed)
-		  {
-		    curmax_allowed = max_allowed[++id];
-
-		    if (compressable >= max_count[id])
-		      goto fast_encode;
-		  }
-	      }
-	    while (likely(compressable < max_count[id]
-			  && (pos + compressable) < size_));
-
-	    assert(compressable <= max_count[id]);
+		curmax_allowed = max_allowed[++id];
 
-	    // Since we have less data than the current "id" allows,
-	    // try to use more bits so we can encode faster.
-	    id = count_to_level[compressable - 1];
-
-	    if (compressable == max_count[id])
-	      goto fast_encode;
-
-	    // Slow compression for situations where we have
-	    // compressable < max_count[id].  We can only be in
-	    // one of the 3 first "id" (1, 3, or 5 bits);
+		// Encode the previous values if they fill a word at
+		// this level.  VAL itself does not fit (yet), so it
+		// may only be part of the word if more bits are used.
+		if (compressable > max_count[id])
+		  goto fast_encode;
+	      }
+	  }
+	while (likely(compressable < max_count[id]
+		      && (pos + compressable) < size_));
+
+	assert(compressable <= max_count[id]);
+
+	// Since we have less data than the current "id" allows,
+	// try to use more bits so we can encode faster.
+	id = count_to_level[compressable - 1];
+
+	if (compressable == max_count[id])
+	  goto fast_encode;
+
+	// Slow compression for situations where we have
+	// compressable < max_count[id].  We can only be in
+	// one of the 3 first "id" (1, 3, or 5 bits);
+	{
+	  assert(id <= 2);
+	  unsigned bits = bits_width[id];
+	  unsigned finalshifts = (max_count[id] - compressable) * bits;
+	  unsigned output = self().data_at(pos);
+	  while (--compressable)
+	    {
+	      output <<= bits;
+	      output |= self().data_at(++pos);
+	    }
+	  output <<= finalshifts;
+	  output |= id << 30;
+	  self().push_data(output);
+	  return size_;
+	}
+
+      fast_encode:
+	switch (id)
+	  {
+	  case 0: // 30 1-bit values
 	    {
-	      assert(id <= 2);
-	      unsigned bits = bits_width[id];
-	      unsigned finalshifts = (max_count[id] - compressable) * bits;
-	      unsigned output = self().data_at(pos);
-	      while (--compressable)
-		{
-		  output <<= bits;
-		  output |= self().data_at(++pos);
-		}
-	      output <<= finalshifts;
-	      output |= id << 30;
+	      unsigned int output = 0x00 << 30; // 00
+	      output |= self().data_at(pos + 0) << 29;
+	      output |= self().data_at(pos + 1) << 28;
+	      output |= self().data_at(pos + 2) << 27;
+	      output |= self().data_at(pos + 3) << 26;
+	      output |= self().data_at(pos + 4) << 25;
+	      output |= self().data_at(pos + 5) << 24;
+	      output |= self().data_at(pos + 6) << 23;
+	      output |= self().data_at(pos + 7) << 22;
+	      output |= self().data_at(pos + 8) << 21;
+	      output |= self().data_at(pos + 9) << 20;
+	      output |= self().data_at(pos + 10) << 19;
+	      output |= self().data_at(pos + 11) << 18;
+	      output |= self().data_at(pos + 12) << 17;
+	      output |= self().data_at(pos + 13) << 16;
+	      output |= self().data_at(pos + 14) << 15;
+	      output |= self().data_at(pos + 15) << 14;
+	      output |= self().data_at(pos + 16) << 13;
+	      output |= self().data_at(pos + 17) << 12;
+	      output |= self().data_at(pos + 18) << 11;
+	      output |= self().data_at(pos + 19) << 10;
+	      output |= self().data_at(pos + 20) << 9;
+	      output |= self().data_at(pos + 21) << 8;
+	      output |= self().data_at(pos + 22) << 7;
+	      output |= self().data_at(pos + 23) << 6;
+	      output |= self().data_at(pos + 24) << 5;
+	      output |= self().data_at(pos + 25) << 4;
+	      output |= self().data_at(pos + 26) << 3;
+	      output |= self().data_at(pos + 27) << 2;
+	      output |= self().data_at(pos + 28) << 1;
+	      output |= self().data_at(pos + 29);
 	      self().push_data(output);
-	      return;
 	    }
-
-	  fast_encode:
-	    switch (id)
-	      {
-	      case 0: // 30 1-bit values
-		{
-		  unsigned int output = 0x00 << 30; // 00
-		  output |= self().data_at(pos + 0) << 29;
-		  output |= self().data_at(pos + 1) << 28;
-		  output |= self().data_at(pos + 2) << 27;
-		  output |= self().data_at(pos + 3) << 26;
-		  output |= self().data_at(pos + 4) << 25;
-		  output |= self().data_at(pos + 5) << 24;
-		  output |= self().data_at(pos + 6) << 23;
-		  output |= self().data_at(pos + 7) << 20;
-		  output |= self().data_at(pos + 8) << 21;
-		  output |= self().data_at(pos + 9) << 20;
-		  output |= self().data_at(pos + 10) << 19;
-		  output |= self().data_at(pos + 11) << 18;
-		  output |= self().data_at(pos + 12) << 17;
-		  output |= self().data_at(pos + 13) << 16;
-		  output |= self().data_at(pos + 14) << 15;
-		  output |= self().data_at(pos + 15) << 14;
-		  output |= self().data_at(pos + 16) << 13;
-		  output |= self().data_at(pos + 17) << 12;
-		  output |= self().data_at(pos + 18) << 11;
-		  output |= self().data_at(pos + 19) << 10;
-		  output |= self().data_at(pos + 20) << 9;
-		  output |= self().data_at(pos + 21) << 8;
-		  output |= self().data_at(pos + 22) << 7;
-		  output |= self().data_at(pos + 23) << 6;
-		  output |= self().data_at(pos + 24) << 5;
-		  output |= self().data_at(pos + 25) << 4;
-		  output |= self().data_at(pos + 26) << 3;
-		  output |= self().data_at(pos + 27) << 2;
-		  output |= self().data_at(pos + 28) << 1;
-		  output |= self().data_at(pos + 29);
-		  self().push_data(output);
-		}
-		break;
-	      case 1: // 10 3-bit values
-		{
-		  unsigned int output = 0x01 << 30; // 01
-		  output |= self().data_at(pos + 0) << 27;
-		  output |= self().data_at(pos + 1) << 24;
-		  output |= self().data_at(pos + 2) << 21;
-		  output |= self().data_at(pos + 3) << 18;
-		  output |= self().data_at(pos + 4) << 15;
-		  output |= self().data_at(pos + 5) << 12;
-		  output |= self().data_at(pos + 6) << 9;
-		  output |= self().data_at(pos + 7) << 6;
-		  output |= self().data_at(pos + 8) << 3;
-		  output |= self().data_at(pos + 9);
-		  self().push_data(output);
-		}
-		break;
-	      case 2: // 6 5-bit values
-		{
-		  unsigned int output = 0x02 << 30; // 10
-		  output |= self().data_at(pos + 0) << 25;
-		  output |= self().data_at(pos + 1) << 20;
-		  output |= self().data_at(pos + 2) << 15;
-		  output |= self().data_at(pos + 3) << 10;
-		  output |= self().data_at(pos + 4) << 5;
-		  output |= self().data_at(pos + 5);
-		  self().push_data(output);
-		}
-		break;
-	      case 3: // 4 7-bit values
-		{
-		  unsigned int output = 0x0C << 28; // 1100
-		  output |= self().data_at(pos + 0) << 21;
-		  output |= self().data_at(pos + 1) << 14;
-		  output |= self().data_at(pos + 2) << 7;
-		  output |= self().data_at(pos + 3);
-		  self().push_data(output);
-		}
-		break;
-	      case 4: // 3 9-bit values
-		{
-		  unsigned int output = 0x0D << 28; // 1101x (1 bit lost)
-		  output |= self().data_at(pos + 0) << 18;
-		  output |= self().data_at(pos + 1) << 9;
-		  output |= self().data_at(pos + 2);
-		  self().push_data(output);
-		}
-		break;
-	      case 5: // 2 14-bit values
-		{
-		  unsigned int output = 0x0E << 28; // 1110
-		  output |= self().data_at(pos + 0) << 14;
-		  output |= self().data_at(pos + 1);
-		  self().push_data(output);
-		}
-		break;
-	      case 6: // one 28-bit value
-		{
-		  unsigned int output = 0x0F << 28; // 1111
-		  output |= self().data_at(pos + 0);
-		  self().push_data(output);
-		}
-		break;
-	      }
-	      pos += max_count[id];
+	    break;
+	  case 1: // 10 3-bit values
+	    {
+	      unsigned int output = 0x01 << 30; // 01
+	      output |= self().data_at(pos + 0) << 27;
+	      output |= self().data_at(pos + 1) << 24;
+	      output |= self().data_at(pos + 2) << 21;
+	      output |= self().data_at(pos + 3) << 18;
+	      output |= self().data_at(pos + 4) << 15;
+	      output |= self().data_at(pos + 5) << 12;
+	      output |= self().data_at(pos + 6) << 9;
+	      output |= self().data_at(pos + 7) << 6;
+	      output |= self().data_at(pos + 8) << 3;
+	      output |= self().data_at(pos + 9);
+	      self().push_data(output);
+	    }
+	    break;
+	  case 2: // 6 5-bit values
+	    {
+	      unsigned int output = 0x02 << 30; // 10
+	      output |= self().data_at(pos + 0) << 25;
+	      output |= self().data_at(pos + 1) << 20;
+	      output |= self().data_at(pos + 2) << 15;
+	      output |= self().data_at(pos + 3) << 10;
+	      output |= self().data_at(pos + 4) << 5;
+	      output |= self().data_at(pos + 5);
+	      self().push_data(output);
+	    }
+	    break;
+	  case 3: // 4 7-bit values
+	    {
+	      unsigned int output = 0x0C << 28; // 1100
+	      output |= self().data_at(pos + 0) << 21;
+	      output |= self().data_at(pos + 1) << 14;
+	      output |= self().data_at(pos + 2) << 7;
+	      output |= self().data_at(pos + 3);
+	      self().push_data(output);
+	    }
+	    break;
+	  case 4: // 3 9-bit values
+	    {
+	      unsigned int output = 0x0D << 28; // 1101x (1 bit lost)
+	      output |= self().data_at(pos + 0) << 18;
+	      output |= self().data_at(pos + 1) << 9;
+	      output |= self().data_at(pos + 2);
+	      self().push_data(output);
+	    }
+	    break;
+	  case 5: // 2 14-bit values
+	    {
+	      unsigned int output = 0x0E << 28; // 1110
+	      output |= self().data_at(pos + 0) << 14;
+	      output |= self().data_at(pos + 1);
+	      self().push_data(output);
+	    }
+	    break;
+	  case 6: // one 28-bit value
+	    {
+	      unsigned int output = 0x0F << 28; // 1111
+	      output |= self().data_at(pos + 0);
+	      self().push_data(output);
+	    }
+	    break;
 	  }
+	return pos + max_count[id];
       }
 
     protected:
@@ -296,13 +309,306 @@ namespace spot
 
   } // anonymous
 
+#ifdef SPOT_HAVE_X86_SIMD
+  namespace
+  {
+    // Vectorized compression.  The level of each output integer is
+    // the smallest level such that the values it would hold all fit
+    // in bits_width[level] bits (this is the level encode_chunk()
+    // arrives at).  Because max_allowed[level] is a mask of low bits,
+    // the values fit iff their bitwise OR does, so each level is
+    // checked with a few vector ORs and one test.  The last values
+    // of the input, when they do not fill an integer, and values
+    // that need more than 7 bits, are left to encode_chunk().
+
+    struct sse41
+    {
+      // The bitwise OR of the COUNT values at ARRAY, in some lane.
+      SPOT_TARGET("sse4.1") static __m128i
+      or_values(const int* array, unsigned count)
+      {
+	__m128i acc = _mm_setzero_si128();
+	unsigned i = 0;
+	for (; i + 4 <= count; i += 4)
+	  acc = _mm_or_si128(acc, _mm_loadu_si128
+			     (reinterpret_cast<const __m128i*>(array + i)));
+	unsigned rest = 0;
+	for (; i < count; ++i)
+	  rest |= array[i];
+	return _mm_or_si128(acc, _mm_cvtsi32_si128(rest));
+      }
+
+      SPOT_TARGET("sse4.1") static bool
+      fit(const int* array, unsigned count, unsigned id)
+      {
+	return _mm_testz_si128(or_values(array, count),
+			       _mm_set1_epi32(~max_allowed[id]));
+      }
+
+      // Shift the four values at ARRAY left by S0..S3.
+      SPOT_TARGET("sse4.1") static __m128i
+      shift4(const int* array, int s0, int s1, int s2, int s3)
+      {
+	__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(array));
+	return _mm_mullo_epi32(v, _mm_setr_epi32(1 << s0, 1 << s1,
+						 1 << s2, 1 << s3));
+      }
+
+      SPOT_TARGET("sse4.1") static unsigned
+      hor(__m128i v)
+      {
+	v = _mm_or_si128(v, _mm_shuffle_epi32(v, 0x4E));
+	v = _mm_or_si128(v, _mm_shuffle_epi32(v, 0xB1));
+	return _mm_cvtsi128_si32(v);
+      }
+
+      SPOT_TARGET("sse4.1") static unsigned
+      pack(const int* array, unsigned id)
+      {
+	__m128i acc;
+	switch (id)
+	  {
+	  case 0:
+	    acc = shift4(array, 29, 28, 27, 26);
+	    for (int i = 1; i < 7; ++i)
+	      acc = _mm_or_si128(acc, shift4(array + 4 * i,
+					     29 - 4 * i, 28 - 4 * i,
+					     27 - 4 * i, 26 - 4 * i));
+	    return hor(acc) | array[28] << 1 | array[29];
+	  case 1:
+	    acc = _mm_or_si128(shift4(array, 27, 24, 21, 18),
+			       shift4(array + 4, 15, 12, 9, 6));
+	    return 0x01 << 30 | hor(acc) | array[8] << 3 | array[9];
+	  case 2:
+	    acc = shift4(array, 25, 20, 15, 10);
+	    return 0x02 << 30 | hor(acc) | array[4] << 5 | array[5];
+	  default:
+	    return 0x0C << 28 | hor(shift4(array, 21, 14, 7, 0));
+	  }
+      }
+
+      SPOT_TARGET("sse4.1") static void
+      compress(const int* array, size_t n, unsigned pos,
+	       int* dest, size_t& dest_size);
+    };
+
+    struct avx2
+    {
+      // Load the first COUNT (at most 8) values at ARRAY.
+      SPOT_TARGET("avx2") static __m256i
+      load(const int* array, unsigned count)
+      {
+	if (count >= 8)
+	  return
+	    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(array));
+	__m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(count),
+					  _mm256_setr_epi32(0, 1, 2, 3,
+							    4, 5, 6, 7));
+	return _mm256_maskload_epi32(array, mask);
+      }
+
+      SPOT_TARGET("avx2") static bool
+      fit(const int* array, unsigned count, unsigned id)
+      {
+	__m256i acc = load(array, count);
+	for (unsigned i = 8; i < count; i += 8)
+	  acc = _mm256_or_si256(acc, load(array + i, count - i));
+	return _mm256_testz_si256(acc, _mm256_set1_epi32(~max_allowed[id]));
+      }
+
+      // Shift the first COUNT values at ARRAY left by S, S - W,
+      // S - 2W, etc.
+      SPOT_TARGET("avx2") static __m256i
+      shift8(const int* array, int count, int s, int w)
+      {
+	__m256i shifts =
+	  _mm256_sub_epi32(_mm256_set1_epi32(s),
+			   _mm256_mullo_epi32(_mm256_set1_epi32(w),
+					      _mm256_setr_epi32(0, 1, 2, 3,
+								4, 5, 6, 7)));
+	return _mm256_sllv_epi32(load(array, count), shifts);
+      }
+
+      SPOT_TARGET("avx2") static unsigned
+      hor(__m256i v)
+      {
+	__m128i x = _mm_or_si128(_mm256_castsi256_si128(v),
+				 _mm256_extracti128_si256(v, 1));
+	x = _mm_or_si128(x, _mm_shuffle_epi32(x, 0x4E));
+	x = _mm_or_si128(x, _mm_shuffle_epi32(x, 0xB1));
+	return _mm_cvtsi128_si32(x);
+      }
+
+      SPOT_TARGET("avx2") static unsigned
+      pack(const int* array, unsigned id)
+      {
+	switch (id)
+	  {
+	  case 0:
+	    {
+	      __m256i lo = _mm256_or_si256(shift8(array, 8, 29, 1),
+					   shift8(array + 8, 8, 21, 1));
+	      __m256i hi = _mm256_or_si256(shift8(array + 16, 8, 13, 1),
+					   shift8(array + 24, 6, 5, 1));
+	      return hor(_mm256_or_si256(lo, hi));
+	    }
+	  case 1:
+	    return 0x01 << 30 | hor(_mm256_or_si256
+				    (shift8(array, 8, 27, 3),
+				     shift8(array + 8, 2, 3, 3)));
+	  case 2:
+	    return 0x02 << 30 | hor(shift8(array, 6, 25, 5));
+	  default:
+	    return 0x0C << 28 | hor(shift8(array, 4, 21, 7));
+	  }
+      }
+
+      SPOT_TARGET("avx2") static void
+      compress(const int* array, size_t n, unsigned pos,
+	       int* dest, size_t& dest_size);
+    };
+
+    // This is inlined in the compress() function of each instruction
+    // set, so that their fit() and pack() functions can be inlined.
+    template <class isa>
+    inline __attribute__((always_inline)) void
+    compress2_simd(const int* array, size_t n, unsigned pos,
+		   int* dest, size_t& dest_size)
+    {
+      int_array_array_compression c(array, n, dest, dest_size);
+      while (pos < n)
+	{
+	  unsigned left = n - pos;
+	  unsigned id;
+	  unsigned count = 0;
+	  for (id = 0; id < 4; ++id)
+	    {
+	      count = max_count[id] < left ? max_count[id] : left;
+	      if (isa::fit(array + pos, count, id))
+		break;
+	    }
+	  if (id < 4 && count == max_count[id])
+	    {
+	      c.push_data(isa::pack(array + pos, id));
+	      pos += count;
+	    }
+	  else
+	    {
+	      pos = c.encode_chunk(pos);
+	    }
+	}
+    }
+
+    void
+    sse41::compress(const int* array, size_t n, unsigned pos,
+		    int* dest, size_t& dest_size)
+    {
+      compress2_simd<sse41>(array, n, pos, dest, dest_size);
+    }
+
+    void
+    avx2::compress(const int* array, size_t n, unsigned pos,
+		   int* dest, size_t& dest_size)
+    {
+      compress2_simd<avx2>(array, n, pos, dest, dest_size);
+    }
+  }
+#endif
+
+  namespace
+  {
+    // Compress ARRAY from position POS (the start of an output
+    // integer).
+    void
+    compress_from(const int* array, size_t n, unsigned pos,
+		  int* dest, size_t& dest_size)
+    {
+#ifdef SPOT_HAVE_X86_SIMD
+      switch (get_simd_level())
+	{
+	case simd_avx2:
+	  avx2::compress(array, n, pos, dest, dest_size);
+	  return;
+	case simd_sse41:
+	  sse41::compress(array, n, pos, dest, dest_size);
+	  return;
+	case simd_none:
+	  break;
+	}
+#endif
+      int_array_array_compression c(array, n, dest, dest_size);
+      c.run(pos);
+    }
+
+    // The number of values held by the compressed integer VAL.
+    unsigned
+    value_count(unsigned val)
+    {
+      unsigned id = val >> 28;
+      return id < 0x0C ? max_count[id >> 2] : max_count[id - 9];
+    }
+  }
 
   void
   int_array_array_compress2(const int* array, size_t n,
 			    int* dest, size_t& dest_size)
   {
-    int_array_array_compression c(array, n, dest, dest_size);
-    c.run();
+    compress_from(array, n, 0, dest, dest_size);
+  }
+
+  void
+  int_array_array_recompress2(const int* array, size_t n,
+			      size_t first_change,
+			      const int* old, size_t old_size,
+			      int* dest, size_t& dest_size)
+  {
+    assert(old_size <= dest_size);
+
+    // Keep the integers of OLD that would be encoded identically.
+    // The integer that starts at POS with level ID holds
+    // max_count[ID] values, and encode_chunk() chose ID because
+    // these values fit, and because some value in the
+    // max_count[ID - 1] values from POS does not fit at level ID - 1.
+    // If all these values are before FIRST_CHANGE, the integer is
+    // unchanged.
+    if (first_change >= n)
+      {
+	for (size_t i = 0; i < old_size; ++i)
+	  dest[i] = old[i];
+	dest_size = old_size;
+	return;
+      }
+
+    unsigned pos = 0;
+    size_t kept = 0;
+    while (kept < old_size)
+      {
+	unsigned val = old[kept];
+	unsigned count = value_count(val);
+	if (pos + count > first_change)
+	  break;
+	unsigned id = val >> 28;
+	id = id < 0x0C ? id >> 2 : id - 9;
+	if (id > 0)
+	  {
+	    // Look for the value that does not fit at level ID - 1.
+	    unsigned end = pos + max_count[id - 1];
+	    if (end > first_change)
+	      end = first_change;
+	    unsigned i;
+	    for (i = pos; i < end; ++i)
+	      if (static_cast<unsigned>(array[i]) > max_allowed[id - 1])
+		break;
+	    if (i == end && end == first_change)
+	      break;
+	  }
+	dest[kept++] = val;
+	pos += count;
+      }
+
+    size_t rest_size = dest_size - kept;
+    compress_from(array, n, pos, dest + kept, rest_size);
+    dest_size = kept + rest_size;
   }
 
 
@@ -468,11 +774,190 @@ namespace spot
 
   }
 
+#ifdef SPOT_HAVE_X86_SIMD
+  namespace
+  {
+    // Vectorized decompression.  Each compressed integer is
+    // broadcast to all lanes, and each lane extracts one value.  The
+    // values are written exactly where (and only where) the scalar
+    // code writes them.
+
+    struct sse41_unpack
+    {
+      // Store, at RES, the four values of W bits that start at
+      // bit S0..S3 of VAL (counting from the least significant bit).
+      SPOT_TARGET("sse4.1") static void
+      extract4(__m128i val, int* res, int w, int s0, int s1, int s2, int s3)
+      {
+	// (VAL << (32 - S - W)) >> (32 - W), with a multiplication
+	// since SSE has no per-lane shift.
+	__m128i v =
+	  _mm_mullo_epi32(val, _mm_setr_epi32(1U << (32 - s0 - w),
+					      1U << (32 - s1 - w),
+					      1U << (32 - s2 - w),
+					      1U << (32 - s3 - w)));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(res),
+			 _mm_srli_epi32(v, 32 - w));
+      }
+
+      SPOT_TARGET("sse4.1") static unsigned
+      unpack(unsigned val, int* res)
+      {
+	__m128i v = _mm_set1_epi32(val);
+	switch (val >> 28)
+	  {
+	  case 0x00:
+	  case 0x01:
+	  case 0x02:
+	  case 0x03:
+	    for (int i = 0; i < 28; i += 4)
+	      extract4(v, res + i, 1, 29 - i, 28 - i, 27 - i, 26 - i);
+	    res[28] = (val >> 1) & 1;
+	    res[29] = val & 1;
+	    return 30;
+	  case 0x04:
+	  case 0x05:
+	  case 0x06:
+	  case 0x07:
+	    extract4(v, res, 3, 27, 24, 21, 18);
+	    extract4(v, res + 4, 3, 15, 12, 9, 6);
+	    res[8] = (val >> 3) & 0x07;
+	    res[9] = val & 0x07;
+	    return 10;
+	  case 0x08:
+	  case 0x09:
+	  case 0x0A:
+	  case 0x0B:
+	    extract4(v, res, 5, 25, 20, 15, 10);
+	    res[4] = (val >> 5) & 0x1F;
+	    res[5] = val & 0x1F;
+	    return 6;
+	  case 0x0C:
+	    extract4(v, res, 7, 21, 14, 7, 0);
+	    return 4;
+	  case 0x0D:
+	    res[0] = (val >> 18) & 0x1FF;
+	    res[1] = (val >> 9) & 0x1FF;
+	    res[2] = val & 0x1FF;
+	    return 3;
+	  case 0x0E:
+	    res[0] = (val >> 14) & 0x3FFF;
+	    res[1] = val & 0x3FFF;
+	    return 2;
+	  default:
+	    res[0] = val & 0xFFFFFFF;
+	    return 1;
+	  }
+      }
+
+      SPOT_TARGET("sse4.1") static void
+      decompress(const int* array, size_t array_size, int* res);
+    };
+
+    struct avx2_unpack
+    {
+      // Store, at RES, the first COUNT (at most 8) values of W bits
+      // that start at bits S, S - W, S - 2W, etc. of VAL.
+      SPOT_TARGET("avx2") static void
+      extract8(__m256i val, int* res, int count, int w, int s)
+      {
+	__m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	__m256i shifts =
+	  _mm256_sub_epi32(_mm256_set1_epi32(s),
+			   _mm256_mullo_epi32(_mm256_set1_epi32(w), idx));
+	__m256i v = _mm256_and_si256(_mm256_srlv_epi32(val, shifts),
+				     _mm256_set1_epi32((1 << w) - 1));
+	if (count == 8)
+	  _mm256_storeu_si256(reinterpret_cast<__m256i*>(res), v);
+	else
+	  _mm256_maskstore_epi32(res,
+				 _mm256_cmpgt_epi32(_mm256_set1_epi32(count),
+						    idx), v);
+      }
+
+      SPOT_TARGET("avx2") static unsigned
+      unpack(unsigned val, int* res)
+      {
+	__m256i v = _mm256_set1_epi32(val);
+	switch (val >> 28)
+	  {
+	  case 0x00:
+	  case 0x01:
+	  case 0x02:
+	  case 0x03:
+	    extract8(v, res, 8, 1, 29);
+	    extract8(v, res + 8, 8, 1, 21);
+	    extract8(v, res + 16, 8, 1, 13);
+	    extract8(v, res + 24, 6, 1, 5);
+	    return 30;
+	  case 0x04:
+	  case 0x05:
+	  case 0x06:
+	  case 0x07:
+	    extract8(v, res, 8, 3, 27);
+	    res[8] = (val >> 3) & 0x07;
+	    res[9] = val & 0x07;
+	    return 10;
+	  case 0x08:
+	  case 0x09:
+	  case 0x0A:
+	  case 0x0B:
+	    extract8(v, res, 6, 5, 25);
+	    return 6;
+	  case 0x0C:
+	    extract8(v, res, 4, 7, 21);
+	    return 4;
+	  default:
+	    return sse41_unpack::unpack(val, res);
+	  }
+      }
+
+      SPOT_TARGET("avx2") static void
+      decompress(const int* array, size_t array_size, int* res);
+    };
+
+    // Inlined in the decompress() function of each instruction set,
+    // like compress2_simd().
+    template <class isa>
+    inline __attribute__((always_inline)) void
+    decompress2_simd(const int* array, size_t array_size, int* res)
+    {
+      for (size_t i = 0; i < array_size; ++i)
+	res += isa::unpack(array[i], res);
+    }
+
+    void
+    sse41_unpack::decompress(const int* array, size_t array_size, int* res)
+    {
+      decompress2_simd<sse41_unpack>(array, array_size, res);
+    }
+
+    void
+    avx2_unpack::decompress(const int* array, size_t array_size, int* res)
+    {
+      decompress2_simd<avx2_unpack>(array, array_size, res);
+    }
+  }
+#endif
+
 
   void
   int_array_array_decompress2(const int* array, size_t array_size, int* res,
 			      size_t)
   {
+#ifdef SPOT_HAVE_X86_SIMD
+    switch (get_simd_level())
+      {
+      case simd_avx2:
+	avx2_unpack::decompress(array, array_size, res);
+	return;
+      case simd_sse41:
+	sse41_unpack::decompress(array, array_size, res);
+	return;
+      case simd_none:
+	break;
+      }
+#endif
     int_array_array_decompression c(array, array_size, res);
     c.run();
   }
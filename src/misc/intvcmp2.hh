@@ -38,6 +38,22 @@ namespace spot
   int_array_array_compress2(const int* array, size_t n,
 			   int* dest, size_t& dest_size);
 
+  /// \brief Compress an int array that differs from a compressed one
+  ///        only after some position.
+  ///
+  /// \a array has \a n values.  \a old (of size \a old_size) is the
+  /// output of int_array_array_compress2() for an array of \a n values
+  /// that differs from \a array only at positions \a first_change and
+  /// after (\a first_change may be \a n).  The output is that of
+  /// int_array_array_compress2() on \a array, but the compressed
+  /// integers of \a old that would not change are copied rather than
+  /// recomputed.  \a dest_size should be at least \a old_size.
+  void
+  int_array_array_recompress2(const int* array, size_t n,
+			      size_t first_change,
+			      const int* old, size_t old_size,
+			      int* dest, size_t& dest_size);
+
   /// \brief Uncompress an int array of size \a array_size into a int
   ///        array of size \a size.
   ///
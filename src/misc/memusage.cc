@@ -41,4 +41,14 @@ namespace spot
     return size;
   }
 
+  int
+  peak_memusage()
+  {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage))
+      return -1;
+    // ru_maxrss is expressed in kilobytes on Linux.
+    return usage.ru_maxrss;
+  }
+
 }
@@ -30,6 +30,12 @@ namespace spot
   /// \return The total number of pages in use by the program if known.
   /// -1 otherwise.
   int memusage();
+
+  /// \brief Peak resident set size of the program, in kilobytes.
+  ///
+  /// \return The largest amount of physical memory used by the
+  /// program so far if known, -1 otherwise.
+  int peak_memusage();
 }
 
 #endif // SPOT_MISC_MEMUSAGE_HH
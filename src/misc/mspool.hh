@@ -25,7 +25,7 @@
 #include <cstddef>
 #include <cstdlib>
 #include <cassert>
-#include "misc/hash.hh"
+#include <vector>
 
 namespace spot
 {
@@ -33,11 +33,12 @@ namespace spot
   /// A multiple-size memory pool implementation.
   class multiple_size_pool
   {
-    static const size_t alignment_ = 2 * sizeof(size_t) - 1;
+    static const size_t alignment_ = 2 * sizeof(size_t);
   public:
     /// Create a pool.
     multiple_size_pool()
-      : free_start_(0), free_end_(0), chunklist_(0)
+      : free_start_(0), free_end_(0), chunklist_(0),
+	allocated_(0), used_(0)
     {
     }
 
@@ -65,8 +66,13 @@ namespace spot
     allocate(size_t size)
     {
       size = fixsize(size);
+      used_ += size;
 
-      block_*& f = freelist_[size];
+      // Free lists are indexed by size class.
+      size_t cls = size / alignment_;
+      if (cls >= freelist_.size())
+	freelist_.resize(cls + 1, 0);
+      block_*& f = freelist_[cls];
       // If we have free blocks available, return the first one.
       if (f)
 	{
@@ -87,6 +93,7 @@ namespace spot
 	    throw std::bad_alloc();
 	  c->prev = chunklist_;
 	  chunklist_ = c;
+	  allocated_ += requested;
 
 	  free_start_ = c->data_ + size;
 	  free_end_ = c->data_ + requested;
@@ -111,19 +118,40 @@ namespace spot
     {
       assert(ptr);
       size = fixsize(size);
+      used_ -= size;
       block_* b = reinterpret_cast<block_*>(const_cast<void*>(ptr));
-      block_*& f = freelist_[size];
+      assert(size / alignment_ < freelist_.size());
+      block_*& f = freelist_[size / alignment_];
       b->next = f;
       f = b;
     }
 
+    /// The number of bytes obtained from the system.
+    size_t
+    allocated_bytes() const
+    {
+      return allocated_;
+    }
+
+    /// \brief The number of bytes in the blocks that have been
+    /// allocated and not recycled.
+    ///
+    /// Sizes are rounded as by fixsize().
+    size_t
+    used_bytes() const
+    {
+      return used_;
+    }
+
   private:
     struct block_ { block_* next; };
-    Sgi::hash_map<size_t, block_*> freelist_;
+    std::vector<block_*> freelist_;
     char* free_start_;
     char* free_end_;
     // chunk = several agglomerated blocks
     union chunk_ { chunk_* prev; char data_[1]; }* chunklist_;
+    size_t allocated_;
+    size_t used_;
   };
 
 }
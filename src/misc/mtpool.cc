@@ -0,0 +1,257 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#include <new>
+#include <cstdlib>
+#include <algorithm>
+#include <sched.h>
+#include "mtpool.hh"
+
+namespace spot
+{
+  namespace
+  {
+    class lock_guard
+    {
+    public:
+      lock_guard(spin_lock& l)
+	: l_(l)
+      {
+	l_.lock();
+      }
+
+      ~lock_guard()
+      {
+	l_.unlock();
+      }
+
+    private:
+      spin_lock& l_;
+    };
+  }
+
+  void
+  spin_lock::lock_slow()
+  {
+    for (;;)
+      {
+	// Wait for the lock to look free before trying to take it
+	// again, so that waiting threads do not keep stealing the
+	// cache line of the lock from each other.
+	for (unsigned i = 0; i < 1000; ++i)
+	  if (!locked_ && !__sync_lock_test_and_set(&locked_, 1))
+	    return;
+	sched_yield();
+      }
+  }
+
+  pool_depot::pool_depot(unsigned classes, size_t granularity,
+			 unsigned magazine_size)
+    : full_(classes), granularity_(granularity),
+      magazine_size_(magazine_size), free_start_(0), free_end_(0),
+      allocated_(0), free_(0)
+  {
+    assert(classes > 0);
+    assert(granularity >= sizeof(block));
+    assert(magazine_size > 0);
+  }
+
+  pool_depot::~pool_depot()
+  {
+    for (unsigned i = 0; i < chunks_.size(); ++i)
+      free(chunks_[i]);
+  }
+
+  void
+  pool_depot::get(unsigned cls, magazine& mag)
+  {
+    assert(cls < full_.size());
+    assert(!mag.count);
+    const size_t size = block_size(cls);
+    lock_guard g(lock_);
+
+    std::vector<magazine>& f = full_[cls];
+    if (!f.empty())
+      {
+	mag = f.back();
+	f.pop_back();
+	free_ -= mag.count * size;
+	return;
+      }
+
+    // Else, cut a magazine out of the last chunk of allocated
+    // memory.
+
+    // If all the last chunk has been used, allocate one more.
+    if (free_start_ + size > free_end_)
+      {
+	recycle_tail();
+
+	size_t requested = (size > 128 ? size : 128) * 8192 - 64;
+	// All blocks are made of granules, so chunks should be too.
+	requested -= requested % granularity_;
+	chunks_.reserve(chunks_.size() + 1);
+	char* c = static_cast<char*>(malloc(requested));
+	if (!c)
+	  throw std::bad_alloc();
+	chunks_.push_back(c);
+	allocated_ += requested;
+	free_start_ = c;
+	free_end_ = c + requested;
+      }
+
+    size_t n = (free_end_ - free_start_) / size;
+    if (n > magazine_size_)
+      n = magazine_size_;
+    // Link the blocks by increasing addresses.
+    block* head = 0;
+    for (size_t i = n; i > 0; --i)
+      {
+	block* b = reinterpret_cast<block*>(free_start_ + (i - 1) * size);
+	b->next = head;
+	head = b;
+      }
+    free_start_ += n * size;
+    mag.head = head;
+    mag.count = n;
+  }
+
+  void
+  pool_depot::recycle_tail()
+  {
+    while (free_start_ < free_end_)
+      {
+	unsigned cls = (free_end_ - free_start_) / granularity_ - 1;
+	if (cls >= full_.size())
+	  cls = full_.size() - 1;
+	magazine m;
+	m.head = reinterpret_cast<block*>(free_start_);
+	m.head->next = 0;
+	m.count = 1;
+	full_[cls].push_back(m);
+	free_start_ += block_size(cls);
+	free_ += block_size(cls);
+      }
+  }
+
+  void
+  pool_depot::put(unsigned cls, magazine& mag)
+  {
+    assert(cls < full_.size());
+    if (!mag.count)
+      return;
+    {
+      lock_guard g(lock_);
+      full_[cls].push_back(mag);
+      free_ += mag.count * block_size(cls);
+    }
+    mag = magazine();
+  }
+
+  void*
+  pool_depot::allocate_large(size_t size)
+  {
+    void* res = malloc(size);
+    if (!res)
+      throw std::bad_alloc();
+    lock_guard g(lock_);
+    allocated_ += size;
+    return res;
+  }
+
+  void
+  pool_depot::deallocate_large(const void* ptr, size_t size)
+  {
+    assert(ptr);
+    free(const_cast<void*>(ptr));
+    lock_guard g(lock_);
+    allocated_ -= size;
+  }
+
+  size_t
+  pool_depot::allocated_bytes() const
+  {
+    lock_guard g(lock_);
+    return allocated_;
+  }
+
+  size_t
+  pool_depot::free_bytes() const
+  {
+    lock_guard g(lock_);
+    return free_ + (free_end_ - free_start_);
+  }
+
+  pool_cache::pool_cache(pool_depot& depot)
+    : depot_(depot), slots_(depot.classes())
+  {
+  }
+
+  pool_cache::~pool_cache()
+  {
+    flush();
+  }
+
+  void
+  pool_cache::reload(unsigned cls)
+  {
+    slot& s = slots_[cls];
+    assert(!s.loaded.count);
+    if (s.previous.count)
+      std::swap(s.loaded, s.previous);
+    else
+      depot_.get(cls, s.loaded);
+  }
+
+  void
+  pool_cache::unload(unsigned cls)
+  {
+    slot& s = slots_[cls];
+    assert(s.loaded.count == depot_.magazine_size());
+    if (s.previous.count)
+      {
+	depot_.put(cls, s.previous);
+	s.previous = s.loaded;
+	s.loaded = pool_depot::magazine();
+      }
+    else
+      std::swap(s.loaded, s.previous);
+  }
+
+  void
+  pool_cache::flush()
+  {
+    for (unsigned cls = 0; cls < slots_.size(); ++cls)
+      {
+	depot_.put(cls, slots_[cls].loaded);
+	depot_.put(cls, slots_[cls].previous);
+      }
+  }
+
+  size_t
+  pool_cache::cached_bytes() const
+  {
+    size_t res = 0;
+    for (unsigned cls = 0; cls < slots_.size(); ++cls)
+      res += ((slots_[cls].loaded.count + slots_[cls].previous.count)
+	      * depot_.block_size(cls));
+    return res;
+  }
+}
@@ -0,0 +1,437 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#ifndef SPOT_MISC_MTPOOL_HH
+#  define SPOT_MISC_MTPOOL_HH
+
+#include <cstddef>
+#include <cassert>
+#include <vector>
+
+namespace spot
+{
+
+  /// \brief A lock for very short critical sections.
+  ///
+  /// A thread that finds the lock taken spins for a while, and then
+  /// yields the processor until the lock is released.
+  class spin_lock
+  {
+  public:
+    spin_lock()
+      : locked_(0)
+    {
+    }
+
+    void
+    lock()
+    {
+      if (__sync_lock_test_and_set(&locked_, 1))
+	lock_slow();
+    }
+
+    void
+    unlock()
+    {
+      __sync_lock_release(&locked_);
+    }
+
+  private:
+    void lock_slow();
+
+    volatile int locked_;
+  };
+
+  /// \brief The part of a concurrent pool that is shared by all
+  ///        threads.
+  ///
+  /// The depot owns the chunks of memory of the pool, and keeps the
+  /// free blocks that are not in the cache of some thread.  Blocks
+  /// are sorted in size classes: blocks of class \c c have
+  /// <code>(c + 1) * granularity</code> bytes.  They are exchanged
+  /// with the caches by \e magazines, i.e., lists of (at most
+  /// magazine_size()) blocks of the same class, so that the lock of
+  /// the depot is only taken once every magazine_size() operations of
+  /// a thread.
+  ///
+  /// You should not need to use this class directly: see
+  /// concurrent_fixed_size_pool and concurrent_multiple_size_pool.
+  class pool_depot
+  {
+  public:
+    struct block
+    {
+      block* next;
+    };
+
+    struct magazine
+    {
+      magazine()
+	: head(0), count(0)
+      {
+      }
+
+      block* head;
+      unsigned count;
+    };
+
+    pool_depot(unsigned classes, size_t granularity,
+	       unsigned magazine_size);
+    /// Free all the memory of the pool.
+    ~pool_depot();
+
+    /// Fill the empty magazine \a mag with blocks of class \a cls.
+    void get(unsigned cls, magazine& mag);
+    /// Take all the blocks of \a mag, of class \a cls.
+    void put(unsigned cls, magazine& mag);
+
+    /// \brief Allocate \a size bytes directly from the system.
+    ///
+    /// This is for blocks too large for any size class.
+    void* allocate_large(size_t size);
+    /// Release a block returned by allocate_large().
+    void deallocate_large(const void* ptr, size_t size);
+
+    /// The number of blocks in a full magazine.
+    unsigned
+    magazine_size() const
+    {
+      return magazine_size_;
+    }
+
+    /// The size of the blocks of class \a cls.
+    size_t
+    block_size(unsigned cls) const
+    {
+      return (cls + 1) * granularity_;
+    }
+
+    /// The number of size classes.
+    unsigned
+    classes() const
+    {
+      return full_.size();
+    }
+
+    /// The number of bytes obtained from the system.
+    size_t allocated_bytes() const;
+    /// \brief The number of bytes that the depot can give to the
+    /// caches without asking the system.
+    ///
+    /// This counts the free blocks of the depot, and the part of its
+    /// last chunk that has not been cut into blocks yet.
+    size_t free_bytes() const;
+
+  private:
+    // Cut the rest of the last chunk into blocks as large as
+    // possible, and add them to the free blocks.  The lock should be
+    // held.
+    void recycle_tail();
+
+    // Not implemented.
+    pool_depot(const pool_depot&);
+    pool_depot& operator=(const pool_depot&);
+
+    mutable spin_lock lock_;
+    std::vector<std::vector<magazine> > full_;
+    size_t granularity_;
+    unsigned magazine_size_;
+    char* free_start_;
+    char* free_end_;
+    // chunk = several agglomerated blocks
+    std::vector<char*> chunks_;
+    size_t allocated_;
+    size_t free_;
+  };
+
+  /// \brief The cache of one thread, in front of a pool_depot.
+  ///
+  /// The cache keeps two magazines per size class: blocks are
+  /// allocated from and released to the \e loaded one, and the \e
+  /// previous one is always either full or empty.  When the loaded
+  /// magazine is empty (on allocation) or full (on release), it is
+  /// swapped with the previous one if that helps, or else a
+  /// magazine is exchanged with the depot.  So a thread that
+  /// allocates and releases blocks in turn never takes the lock.
+  ///
+  /// A cache must not be used by several threads at the same time.
+  /// Its blocks are given back to the depot when it is destroyed, so
+  /// it should be destroyed before the depot.
+  class pool_cache
+  {
+  public:
+    pool_cache(pool_depot& depot);
+    ~pool_cache();
+
+    void*
+    allocate(unsigned cls)
+    {
+      assert(cls < slots_.size());
+      pool_depot::magazine& m = slots_[cls].loaded;
+      if (!m.count)
+	reload(cls);
+      pool_depot::block* b = m.head;
+      m.head = b->next;
+      --m.count;
+      return b;
+    }
+
+    void
+    deallocate(const void* ptr, unsigned cls)
+    {
+      assert(ptr);
+      assert(cls < slots_.size());
+      pool_depot::magazine& m = slots_[cls].loaded;
+      if (m.count == depot_.magazine_size())
+	unload(cls);
+      pool_depot::block* b =
+	reinterpret_cast<pool_depot::block*>(const_cast<void*>(ptr));
+      b->next = m.head;
+      m.head = b;
+      ++m.count;
+    }
+
+    /// Give all the blocks of this cache back to the depot.
+    void flush();
+
+    /// The number of bytes in the free blocks of this cache.
+    size_t cached_bytes() const;
+
+    pool_depot&
+    depot() const
+    {
+      return depot_;
+    }
+
+  private:
+    void reload(unsigned cls);
+    void unload(unsigned cls);
+
+    // Not implemented.
+    pool_cache(const pool_cache&);
+    pool_cache& operator=(const pool_cache&);
+
+    struct slot
+    {
+      pool_depot::magazine loaded;
+      pool_depot::magazine previous;
+    };
+    pool_depot& depot_;
+    std::vector<slot> slots_;
+  };
+
+  /// \brief A fixed-size memory pool that can be shared by several
+  ///        threads.
+  ///
+  /// This offers the same service as fixed_size_pool, except that
+  /// each thread allocates and releases blocks through its own
+  /// concurrent_fixed_size_pool::cache.  A block can be released
+  /// through a different cache than the one that allocated it.
+  class concurrent_fixed_size_pool
+  {
+  public:
+    /// \brief Create a pool allocating objects of \a size bytes.
+    ///
+    /// Blocks are exchanged between the caches and the pool by
+    /// groups of \a magazine_size.
+    concurrent_fixed_size_pool(size_t size, unsigned magazine_size = 64)
+      : depot_(1, fixsize(size), magazine_size)
+    {
+    }
+
+    /// The per-thread interface to a concurrent_fixed_size_pool.
+    class cache
+    {
+    public:
+      cache(concurrent_fixed_size_pool& pool)
+	: cache_(pool.depot_)
+      {
+      }
+
+      /// Allocate a block.
+      void*
+      allocate()
+      {
+	return cache_.allocate(0);
+      }
+
+      /// \brief Recycle a block.
+      ///
+      /// As in fixed_size_pool, the memory is kept by the pool.
+      void
+      deallocate(const void* ptr)
+      {
+	cache_.deallocate(ptr, 0);
+      }
+
+      /// Give all the free blocks of this cache back to the pool.
+      void
+      flush()
+      {
+	cache_.flush();
+      }
+
+      /// The number of bytes in the free blocks of this cache.
+      size_t
+      cached_bytes() const
+      {
+	return cache_.cached_bytes();
+      }
+
+    private:
+      pool_cache cache_;
+    };
+
+    /// The number of bytes obtained from the system.
+    size_t
+    allocated_bytes() const
+    {
+      return depot_.allocated_bytes();
+    }
+
+    /// \brief The number of bytes available in the pool, outside the
+    /// caches.
+    ///
+    /// The memory in use is allocated_bytes() minus free_bytes()
+    /// minus the cached_bytes() of all caches.
+    size_t
+    free_bytes() const
+    {
+      return depot_.free_bytes();
+    }
+
+  private:
+    static size_t
+    fixsize(size_t size)
+    {
+      const size_t alignment = 2 * sizeof(size_t);
+      if (size < sizeof(pool_depot::block))
+	size = sizeof(pool_depot::block);
+      return (size + alignment - 1) & ~(alignment - 1);
+    }
+
+    pool_depot depot_;
+    friend class cache;
+  };
+
+  /// \brief A multiple-size memory pool that can be shared by several
+  ///        threads.
+  ///
+  /// This offers the same service as multiple_size_pool, through
+  /// one concurrent_multiple_size_pool::cache per thread.  Sizes are
+  /// rounded to a multiple of <code>2 * sizeof(size_t)</code>, and
+  /// blocks larger than the \a max_size given to the constructor are
+  /// allocated directly from the system.
+  class concurrent_multiple_size_pool
+  {
+    static const size_t alignment_ = 2 * sizeof(size_t);
+  public:
+    concurrent_multiple_size_pool(size_t max_size = 4096,
+				  unsigned magazine_size = 64)
+      : depot_((max_size + alignment_ - 1) / alignment_, alignment_,
+	       magazine_size)
+    {
+    }
+
+    /// The per-thread interface to a concurrent_multiple_size_pool.
+    class cache
+    {
+    public:
+      cache(concurrent_multiple_size_pool& pool)
+	: cache_(pool.depot_)
+      {
+      }
+
+      /// Allocate \a size bytes of memory.
+      void*
+      allocate(size_t size)
+      {
+	unsigned cls = size_class(size);
+	if (cls >= cache_.depot().classes())
+	  return cache_.depot().allocate_large(size);
+	return cache_.allocate(cls);
+      }
+
+      /// \brief Recycle \a size bytes of memory.
+      ///
+      /// The size argument should be the same as the one passed to
+      /// allocate().
+      void
+      deallocate(const void* ptr, size_t size)
+      {
+	unsigned cls = size_class(size);
+	if (cls >= cache_.depot().classes())
+	  cache_.depot().deallocate_large(ptr, size);
+	else
+	  cache_.deallocate(ptr, cls);
+      }
+
+      /// Give all the free blocks of this cache back to the pool.
+      void
+      flush()
+      {
+	cache_.flush();
+      }
+
+      /// The number of bytes in the free blocks of this cache.
+      size_t
+      cached_bytes() const
+      {
+	return cache_.cached_bytes();
+      }
+
+    private:
+      static unsigned
+      size_class(size_t size)
+      {
+	return size ? (size - 1) / alignment_ : 0;
+      }
+
+      pool_cache cache_;
+    };
+
+    /// \brief The number of bytes obtained from the system.
+    ///
+    /// This includes the blocks larger than the maximum size.
+    size_t
+    allocated_bytes() const
+    {
+      return depot_.allocated_bytes();
+    }
+
+    /// \brief The number of bytes available in the pool, outside the
+    /// caches.
+    ///
+    /// The memory in use is allocated_bytes() minus free_bytes()
+    /// minus the cached_bytes() of all caches.
+    size_t
+    free_bytes() const
+    {
+      return depot_.free_bytes();
+    }
+
+  private:
+    pool_depot depot_;
+    friend class cache;
+  };
+
+}
+
+#endif // SPOT_MISC_MTPOOL_HH
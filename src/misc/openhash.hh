@@ -0,0 +1,260 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#ifndef SPOT_MISC_OPENHASH_HH
+#  define SPOT_MISC_OPENHASH_HH
+
+#include <cstddef>
+#include <cassert>
+
+namespace spot
+{
+
+  /// \brief An open-addressing hash set of pointers.
+  /// \ingroup misc_tools
+  ///
+  /// This is meant to implement unique tables: each element is stored
+  /// with its hash value, and lookups are done with a hash value and
+  /// a predicate, so that one can look for an object that has not
+  /// been constructed yet.
+  ///
+  /// The table uses linear probing over a power-of-two number of
+  /// slots, and is kept at most half full.  Erasure shifts the
+  /// following elements backward instead of leaving tombstones, and
+  /// the table shrinks when it becomes mostly empty.
+  template <class T>
+  class open_hash_set
+  {
+    struct slot
+    {
+      size_t hash;
+      T* elem;
+    };
+
+  public:
+    /// Create an empty table with \a capacity slots (rounded up to
+    /// a power of two).
+    open_hash_set(size_t capacity = 64)
+      : size_(0)
+    {
+      cap_ = 8;
+      while (cap_ < capacity)
+	cap_ <<= 1;
+      min_cap_ = cap_;
+      table_ = alloc_(cap_);
+    }
+
+    ~open_hash_set()
+    {
+      delete[] table_;
+    }
+
+    /// \brief Look for an element.
+    ///
+    /// Return the first element whose hash is \a hash and for which
+    /// \a pred returns true, or 0 if there is no such element.
+    template <class Pred>
+    T*
+    find(size_t hash, const Pred& pred) const
+    {
+      size_t mask = cap_ - 1;
+      for (size_t i = hash & mask; table_[i].elem; i = (i + 1) & mask)
+	if (table_[i].hash == hash && pred(table_[i].elem))
+	  return table_[i].elem;
+      return 0;
+    }
+
+    /// \brief Insert \a elem with hash value \a hash.
+    ///
+    /// The element should not already be in the table.
+    void
+    insert(size_t hash, T* elem)
+    {
+      assert(elem);
+      if (2 * (size_ + 1) > cap_)
+	resize_(cap_ * 2);
+      place_(hash, elem);
+      ++size_;
+    }
+
+    /// \brief Remove \a elem, previously inserted with \a hash.
+    void
+    erase(size_t hash, const T* elem)
+    {
+      size_t mask = cap_ - 1;
+      size_t i = hash & mask;
+      while (table_[i].elem != elem)
+	{
+	  assert(table_[i].elem);
+	  i = (i + 1) & mask;
+	}
+      // Shift backward the elements of the probe sequence that
+      // would not be reachable anymore once slot i is emptied.
+      size_t j = i;
+      for (;;)
+	{
+	  j = (j + 1) & mask;
+	  if (!table_[j].elem)
+	    break;
+	  size_t home = table_[j].hash & mask;
+	  bool stay;
+	  if (i <= j)
+	    stay = i < home && home <= j;
+	  else
+	    stay = i < home || home <= j;
+	  if (stay)
+	    continue;
+	  table_[i] = table_[j];
+	  i = j;
+	}
+      table_[i].elem = 0;
+      --size_;
+      if (cap_ > min_cap_ && 8 * size_ < cap_)
+	resize_(cap_ / 2);
+    }
+
+    /// Number of elements in the table.
+    size_t
+    size() const
+    {
+      return size_;
+    }
+
+    /// Number of slots in the table.
+    size_t
+    capacity() const
+    {
+      return cap_;
+    }
+
+    /// Number of bytes used by the table.
+    size_t
+    memory() const
+    {
+      return sizeof(*this) + cap_ * sizeof(slot);
+    }
+
+    /// Iterate over the elements of the table.
+    class iterator
+    {
+    public:
+      iterator(const slot* pos, const slot* end)
+	: pos_(pos), end_(end)
+      {
+	skip_();
+      }
+
+      T*
+      operator*() const
+      {
+	return pos_->elem;
+      }
+
+      iterator&
+      operator++()
+      {
+	++pos_;
+	skip_();
+	return *this;
+      }
+
+      bool
+      operator==(const iterator& other) const
+      {
+	return pos_ == other.pos_;
+      }
+
+      bool
+      operator!=(const iterator& other) const
+      {
+	return pos_ != other.pos_;
+      }
+
+    private:
+      void
+      skip_()
+      {
+	while (pos_ != end_ && !pos_->elem)
+	  ++pos_;
+      }
+
+      const slot* pos_;
+      const slot* end_;
+    };
+
+    iterator
+    begin() const
+    {
+      return iterator(table_, table_ + cap_);
+    }
+
+    iterator
+    end() const
+    {
+      return iterator(table_ + cap_, table_ + cap_);
+    }
+
+  private:
+    // Disallow copy.
+    open_hash_set(const open_hash_set<T>&);
+    open_hash_set<T>& operator=(const open_hash_set<T>&);
+
+    static slot*
+    alloc_(size_t n)
+    {
+      slot* t = new slot[n];
+      for (size_t i = 0; i < n; ++i)
+	t[i].elem = 0;
+      return t;
+    }
+
+    void
+    place_(size_t hash, T* elem)
+    {
+      size_t mask = cap_ - 1;
+      size_t i = hash & mask;
+      while (table_[i].elem)
+	i = (i + 1) & mask;
+      table_[i].hash = hash;
+      table_[i].elem = elem;
+    }
+
+    void
+    resize_(size_t n)
+    {
+      slot* old = table_;
+      size_t old_cap = cap_;
+      cap_ = n;
+      table_ = alloc_(cap_);
+      for (size_t i = 0; i < old_cap; ++i)
+	if (old[i].elem)
+	  place_(old[i].hash, old[i].elem);
+      delete[] old;
+    }
+
+    slot* table_;
+    size_t cap_;
+    size_t min_cap_;
+    size_t size_;
+  };
+
+}
+
+#endif // SPOT_MISC_OPENHASH_HH
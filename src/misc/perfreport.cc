@@ -0,0 +1,129 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#include "perfreport.hh"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <bdd.h>
+#include "escape.hh"
+#include "memusage.hh"
+#include "timer.hh"
+
+namespace spot
+{
+  perf_report::perf_report(const std::string& tool)
+    : tool_(tool)
+  {
+  }
+
+  void
+  perf_report::add_timers(const std::string& name, const timer_map& tm)
+  {
+    timers_.push_back(std::make_pair(name, &tm));
+  }
+
+  void
+  perf_report::add(const std::string& section, const std::string& key,
+		   double value)
+  {
+    sections_[section][key] = value;
+  }
+
+  void
+  perf_report::add_bdd_stats()
+  {
+    bddStat s;
+    bdd_stats(&s);
+    add("bdd", "produced", s.produced);
+    add("bdd", "nodes", s.nodenum);
+    add("bdd", "max_nodes", s.maxnodenum);
+    add("bdd", "free_nodes", s.freenodes);
+    add("bdd", "variables", s.varnum);
+    add("bdd", "cache_size", s.cachesize);
+    add("bdd", "gc_count", s.gbcnum);
+  }
+
+  std::string
+  perf_report::numbered_section(const std::string& section, unsigned n)
+  {
+    std::ostringstream s;
+    s << section << " " << n;
+    return s.str();
+  }
+
+  std::ostream&
+  perf_report::print_json(std::ostream& os) const
+  {
+    // timer_map::print() may have left std::fixed on the stream.
+    std::ios::fmtflags old = os.flags();
+    std::streamsize prec = os.precision();
+    os.unsetf(std::ios::floatfield);
+    os << std::setprecision(15);
+
+    os << "{ \"tool\": \"";
+    escape_str(os, tool_) << "\"," << std::endl
+			  << "  \"peak_rss_kb\": " << peak_memusage() << ","
+			  << std::endl << "  \"timers\": {";
+    const char* sep = "";
+    for (timers::const_iterator i = timers_.begin();
+	 i != timers_.end(); ++i)
+      {
+	os << sep << std::endl << "    \"";
+	escape_str(os, i->first) << "\": ";
+	i->second->print_json(os);
+	sep = ",";
+      }
+    os << " }," << std::endl << "  \"counters\": {";
+    sep = "";
+    for (sections::const_iterator i = sections_.begin();
+	 i != sections_.end(); ++i)
+      {
+	os << sep << std::endl << "    \"";
+	escape_str(os, i->first) << "\": {";
+	const char* sep2 = " ";
+	for (counters::const_iterator j = i->second.begin();
+	     j != i->second.end(); ++j)
+	  {
+	    os << sep2 << "\"";
+	    escape_str(os, j->first) << "\": " << j->second;
+	    sep2 = ", ";
+	  }
+	os << " }";
+	sep = ",";
+      }
+    os << " } }" << std::endl;
+
+    os.flags(old);
+    os.precision(prec);
+    return os;
+  }
+
+  bool
+  perf_report::print_json(const std::string& filename) const
+  {
+    std::ofstream out(filename.c_str());
+    if (!out)
+      return false;
+    print_json(out);
+    return !!out;
+  }
+}
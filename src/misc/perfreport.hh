@@ -0,0 +1,116 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#ifndef SPOT_MISC_PERFREPORT_HH
+# define SPOT_MISC_PERFREPORT_HH
+
+# include <iosfwd>
+# include <map>
+# include <string>
+# include <vector>
+
+namespace spot
+{
+  class timer_map;
+
+  /// \addtogroup misc_tools
+  /// @{
+
+  /// \brief A machine-readable summary of the performance of a run.
+  ///
+  /// A perf_report gathers the timers of a program, counters grouped
+  /// in named sections, the counters of BuDDy, and the peak resident
+  /// set size of the program, and prints them as a JSON object:
+  ///
+  /// \code
+  /// { "tool": "ltl2tgba",
+  ///   "peak_rss_kb": 5412,
+  ///   "timers": { "main": [ ... ] },
+  ///   "counters": { "bdd": { "produced": 1234, ... }, ... } }
+  /// \endcode
+  ///
+  /// The format of each array of timers is described in
+  /// timer_map::print_json().
+  class perf_report
+  {
+  public:
+    perf_report(const std::string& tool);
+
+    /// \brief Report the timers of \a tm under the name \a name.
+    ///
+    /// \a tm is only read by print_json(), so it must live until
+    /// then.
+    void add_timers(const std::string& name, const timer_map& tm);
+
+    /// \brief Set counter \a key of section \a section to \a value.
+    ///
+    /// A repeated measure, such as each check of an emptiness check
+    /// that searches for several accepting runs, should go to its own
+    /// section; see numbered_section().
+    void add(const std::string& section, const std::string& key,
+	     double value);
+
+    /// \brief Report all counters of \a s in section \a section.
+    ///
+    /// \a s should be a spot::unsigned_statistics, or any class with
+    /// a compatible \c stats map.
+    template<class Stats>
+    void
+    add_stats(const std::string& section, const Stats& s)
+    {
+      typename Stats::stats_map::const_iterator i;
+      for (i = s.stats.begin(); i != s.stats.end(); ++i)
+	add(section, i->first, (s.*i->second)());
+    }
+
+    /// \brief Report the current counters of BuDDy in section "bdd".
+    ///
+    /// This includes the number of nodes produced, allocated and
+    /// free, and the number of garbage collections.
+    void add_bdd_stats();
+
+    /// \brief The name of the \a n-th section called \a section.
+    ///
+    /// Return \a section followed by a space and \a n, e.g.,
+    /// "emptiness check 2".
+    static std::string numbered_section(const std::string& section,
+					unsigned n);
+
+    /// Print the report as a JSON object.
+    std::ostream& print_json(std::ostream& os) const;
+
+    /// \brief Print the report as a JSON object in \a filename.
+    ///
+    /// \return false if \a filename could not be written.
+    bool print_json(const std::string& filename) const;
+
+  private:
+    std::string tool_;
+    typedef std::vector<std::pair<std::string, const timer_map*> > timers;
+    timers timers_;
+    typedef std::map<std::string, double> counters;
+    typedef std::map<std::string, counters> sections;
+    sections sections_;
+  };
+
+  /// @}
+}
+
+#endif // SPOT_MISC_PERFREPORT_HH
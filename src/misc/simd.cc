@@ -0,0 +1,71 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#include "simd.hh"
+
+namespace spot
+{
+  namespace
+  {
+    simd_level
+    detect_simd_level()
+    {
+#ifdef SPOT_HAVE_X86_SIMD
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2"))
+	return simd_avx2;
+      if (__builtin_cpu_supports("sse4.1"))
+	return simd_sse41;
+#endif
+      return simd_none;
+    }
+
+    const simd_level supported_level = detect_simd_level();
+    simd_level current_level = supported_level;
+  }
+
+  simd_level
+  get_simd_level()
+  {
+    return current_level;
+  }
+
+  simd_level
+  set_simd_level(simd_level level)
+  {
+    current_level = level < supported_level ? level : supported_level;
+    return current_level;
+  }
+
+  const char*
+  simd_level_name(simd_level level)
+  {
+    switch (level)
+      {
+      case simd_none:
+	return "none";
+      case simd_sse41:
+	return "sse4.1";
+      case simd_avx2:
+	return "avx2";
+      }
+    return "?";
+  }
+}
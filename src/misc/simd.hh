@@ -0,0 +1,66 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#ifndef SPOT_MISC_SIMD_HH
+# define SPOT_MISC_SIMD_HH
+
+// Vectorized code paths are only compiled with compilers that accept
+// per-function target attributes (GCC 4.9, Clang 3.8), on x86_64.
+# if defined(__x86_64__) \
+  && (defined(__clang__) \
+      ? (__clang_major__ > 3 || (__clang_major__ == 3 \
+				 && __clang_minor__ >= 8)) \
+      : (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+#  define SPOT_HAVE_X86_SIMD 1
+#  define SPOT_TARGET(isa) __attribute__((target(isa)))
+# endif
+
+namespace spot
+{
+  /// \addtogroup misc_tools
+  /// @{
+
+  /// \brief Instruction sets used by vectorized code paths.
+  ///
+  /// Functions that have vectorized implementations (such as
+  /// int_array_array_compress2()) produce exactly the same results
+  /// whatever the instruction set used.
+  enum simd_level { simd_none, simd_sse41, simd_avx2 };
+
+  /// \brief The instruction set used by vectorized code paths.
+  ///
+  /// This is the best one supported by the processor, unless
+  /// set_simd_level() was called.
+  simd_level get_simd_level();
+
+  /// \brief Restrict the instruction set used by vectorized code paths.
+  ///
+  /// \a level is lowered to what the processor supports.  Returns the
+  /// level actually selected.  This is mostly useful to compare the
+  /// vectorized and scalar code paths.
+  simd_level set_simd_level(simd_level level);
+
+  /// The name of \a level ("none", "sse4.1", or "avx2").
+  const char* simd_level_name(simd_level level);
+
+  /// @}
+}
+
+#endif // SPOT_MISC_SIMD_HH
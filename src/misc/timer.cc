@@ -22,8 +22,10 @@
 // 02111-1307, USA.
 
 #include "timer.hh"
+#include "escape.hh"
 #include <iostream>
 #include <iomanip>
+#include <unistd.h>
 
 namespace spot
 {
@@ -95,4 +97,54 @@ namespace spot
     return os;
   }
 
+  std::ostream&
+  timer_map::print_json(std::ostream& os) const
+  {
+    std::ios::fmtflags old = os.flags();
+    std::streamsize prec = os.precision();
+    os << std::fixed << std::setprecision(6);
+    print_json(os, "", "");
+    os.flags(old);
+    os.precision(prec);
+    return os;
+  }
+
+  std::ostream&
+  timer_map::print_json(std::ostream& os, const std::string& parent,
+			const std::string& indent) const
+  {
+    static const double ticks = sysconf(_SC_CLK_TCK);
+    std::map<std::string, std::string>::const_iterator p;
+    const char* sep = "";
+    os << "[";
+    for (tm_type::const_iterator i = tm.begin(); i != tm.end(); ++i)
+      {
+	// Timers whose enclosing phase has been canceled are shown at
+	// the top level.
+	p = parent_.find(i->first);
+	const std::string& up =
+	  (p == parent_.end() || tm.find(p->second) == tm.end())
+	  ? std::string() : p->second;
+	if (up != parent)
+	  continue;
+	const spot::timer& t = i->second.first;
+	os << sep << std::endl << indent << "  { \"name\": \"";
+	escape_str(os, i->first)
+	  << "\"," << std::endl << indent << "    \"count\": "
+	  << i->second.second
+	  << ", \"user\": " << t.utime() / ticks
+	  << ", \"system\": " << t.stime() / ticks
+	  << ", \"cpu\": " << (t.utime() + t.stime()) / ticks
+	  << ", \"wall\": " << t.walltime()
+	  << ", \"peak_rss_kb\": " << t.peak_rss()
+	  << "," << std::endl << indent << "    \"phases\": ";
+	print_json(os, i->first, indent + "    ");
+	os << " }";
+	sep = ",";
+      }
+    if (*sep)
+      os << std::endl << indent;
+    return os << "]";
+  }
+
 }
@@ -28,22 +28,28 @@
 # include <iosfwd>
 # include <string>
 # include <map>
+# include <vector>
 # include <sys/times.h>
+# include <sys/time.h>
+# include "memusage.hh"
 
 namespace spot
 {
   /// \addtogroup misc_tools
   /// @{
 
-  /// A structure to record elapsed time in clock ticks.
+  /// \brief A structure to record elapsed time.
+  ///
+  /// CPU times are in clock ticks, wall-clock time in seconds.
   struct time_info
   {
     time_info()
-      : utime(), stime(0)
+      : utime(), stime(0), wtime(0.)
     {
     }
     clock_t utime;
     clock_t stime;
+    double wtime;
   };
 
   /// A timekeeper that accumulate interval of time.
@@ -51,7 +57,7 @@ namespace spot
   {
   public:
     timer()
-      : running(false)
+      : peak_rss_(-1), running(false)
     {
     }
 
@@ -65,6 +71,7 @@ namespace spot
       times(&tmp);
       start_.utime = tmp.tms_utime;
       start_.stime = tmp.tms_stime;
+      start_.wtime = wall_clock();
     }
 
     /// Stop a time interval and update the sum of all intervals.
@@ -75,6 +82,10 @@ namespace spot
       times(&tmp);
       total_.utime += tmp.tms_utime - start_.utime;
       total_.stime += tmp.tms_stime - start_.stime;
+      total_.wtime += wall_clock() - start_.wtime;
+      int rss = peak_memusage();
+      if (rss > peak_rss_)
+	peak_rss_ = rss;
       assert(running);
       running = false;
     }
@@ -99,6 +110,28 @@ namespace spot
       return total_.stime;
     }
 
+    /// \brief Return the wall-clock time of all accumulated
+    /// intervals, in seconds.
+    ///
+    /// Any time interval that has been start()ed but not stop()ed
+    /// will not be accounted for.
+    double
+    walltime() const
+    {
+      return total_.wtime;
+    }
+
+    /// \brief Return the peak resident set size of the program at the
+    /// end of the last interval, in kilobytes.
+    ///
+    /// This is the largest memory footprint reached by the program
+    /// so far, not only during the intervals of this timer.  It is
+    /// -1 if unknown, or if no interval has been stop()ed.
+    int
+    peak_rss() const
+    {
+      return peak_rss_;
+    }
 
     /// \brief Whether the timer is running.
     bool
@@ -108,8 +141,17 @@ namespace spot
     }
 
   protected:
+    static double
+    wall_clock()
+    {
+      struct timeval tv;
+      gettimeofday(&tv, 0);
+      return tv.tv_sec + tv.tv_usec / 1e6;
+    }
+
     time_info start_;
     time_info total_;
+    int peak_rss_;
     bool running;
   };
 
@@ -117,6 +159,10 @@ namespace spot
   ///
   /// Timer_map also keeps track of the number of measures each timer
   /// has performed.
+  ///
+  /// A timer started while other timers of the map are running is
+  /// considered a sub-phase of the most recently started of them.
+  /// This nesting is only used by print_json().
   class timer_map
   {
   public:
@@ -129,9 +175,16 @@ namespace spot
     void
     start(const std::string& name)
     {
-      item_type& it = tm[name];
-      it.first.start();
-      ++it.second;
+      tm_type::iterator i = tm.find(name);
+      if (i == tm.end())
+	{
+	  i = tm.insert(std::make_pair(name, item_type())).first;
+	  if (!running_.empty())
+	    parent_[name] = running_.back();
+	}
+      i->second.first.start();
+      ++i->second.second;
+      running_.push_back(name);
     }
 
     /// \brief Stop timer \a name.
@@ -141,6 +194,7 @@ namespace spot
     stop(const std::string& name)
     {
       tm[name].first.stop();
+      pop_running(name);
     }
 
     /// \brief Cancel timer \a name.
@@ -156,8 +210,12 @@ namespace spot
       tm_type::iterator i = tm.find(name);
       assert(i != tm.end());
       assert(0 < i->second.second);
+      pop_running(name);
       if (0 == --i->second.second)
-	tm.erase(i);
+	{
+	  tm.erase(i);
+	  parent_.erase(name);
+	}
     }
 
     /// Return the timer \a name.
@@ -191,17 +249,48 @@ namespace spot
     std::ostream&
     print(std::ostream& os) const;
 
+    /// \brief Format information about all timers as a JSON array.
+    ///
+    /// Each element describes a timer, with its user, system, and
+    /// wall-clock times in seconds, its number of measures, the peak
+    /// resident set size of the program at the end of its last
+    /// measure, and the array of its sub-phases.
+    std::ostream&
+    print_json(std::ostream& os) const;
+
     /// \brief Remove information about all timers.
     void
     reset_all()
     {
       tm.clear();
+      parent_.clear();
+      running_.clear();
     }
 
   protected:
+    void
+    pop_running(const std::string& name)
+    {
+      std::vector<std::string>::reverse_iterator i;
+      for (i = running_.rbegin(); i != running_.rend(); ++i)
+	if (*i == name)
+	  {
+	    running_.erase(--i.base());
+	    break;
+	  }
+    }
+
+    std::ostream&
+    print_json(std::ostream& os, const std::string& parent,
+	       const std::string& indent) const;
+
     typedef std::pair<spot::timer, int> item_type;
     typedef std::map<std::string, item_type> tm_type;
     tm_type tm;
+    // Name of the enclosing phase of each nested timer.
+    std::map<std::string, std::string> parent_;
+    // Names of the running timers, in the order they were started.
+    std::vector<std::string> running_;
   };
 
   /// @}
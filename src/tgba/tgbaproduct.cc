@@ -24,6 +24,7 @@
 #include "tgbaproduct.hh"
 #include <string>
 #include <cassert>
+#include "misc/arena.hh"
 #include "misc/hashfunc.hh"
 #include "kripke/kripke.hh"
 
@@ -277,11 +278,16 @@ namespace spot
   // tgba_product
 
   tgba_product::tgba_product(const tgba* left, const tgba* right)
-    : dict_(left->get_dict()), left_(left), right_(right),
-      pool_(sizeof(state_product))
+    : dict_(left->get_dict()), left_(left), right_(right)
   {
     assert(dict_ == right_->get_dict());
 
+    arena_ = arena_scope::current();
+    if (arena_)
+      pool_ = arena_->fixed_pool(sizeof(state_product));
+    else
+      pool_ = new fixed_size_pool(sizeof(state_product));
+
     // If one of the side is a Kripke structure, it is easier to deal
     // with (we don't have to fix the acceptance conditions, and
     // computing the successors can be improved a bit).
@@ -360,14 +366,16 @@ namespace spot
 	last_support_variables_input_->destroy();
 	last_support_variables_input_ = 0;
       }
+    if (!arena_)
+      delete pool_;
   }
 
   state*
   tgba_product::get_init_state() const
   {
-    fixed_size_pool* p = const_cast<fixed_size_pool*>(&pool_);
-    return new(p->allocate()) state_product(left_->get_init_state(),
-					    right_->get_init_state(), p);
+    return new(pool_->allocate()) state_product(left_->get_init_state(),
+						right_->get_init_state(),
+						pool_);
   }
 
   tgba_succ_iterator*
@@ -392,15 +400,25 @@ namespace spot
     tgba_succ_iterator* ri = right_->succ_iter(s->right(),
 					       global_state, global_automaton);
 
-    fixed_size_pool* p = const_cast<fixed_size_pool*>(&pool_);
     if (left_kripke_)
-      return new tgba_succ_iterator_product_kripke(li, ri, p);
-    else
-      return new tgba_succ_iterator_product(li, ri,
-					    left_acc_complement_,
-					    right_acc_complement_,
-					    right_common_acc_,
-					    p);
+      {
+	typedef tgba_succ_iterator_product_kripke iter;
+	if (arena_)
+	  return new(arena_) arena_allocated<iter>(li, ri, pool_);
+	return new iter(li, ri, pool_);
+      }
+    typedef tgba_succ_iterator_product iter;
+    if (arena_)
+      return new(arena_) arena_allocated<iter>(li, ri,
+					       left_acc_complement_,
+					       right_acc_complement_,
+					       right_common_acc_,
+					       pool_);
+    return new iter(li, ri,
+		    left_acc_complement_,
+		    right_acc_complement_,
+		    right_common_acc_,
+		    pool_);
   }
 
   bdd
@@ -495,9 +513,8 @@ namespace spot
   state*
   tgba_product_init::get_init_state() const
   {
-    fixed_size_pool* p = const_cast<fixed_size_pool*>(&pool_);
-    return new(p->allocate()) state_product(left_init_->clone(),
-					    right_init_->clone(), p);
+    return new(pool_->allocate()) state_product(left_init_->clone(),
+						right_init_->clone(), pool_);
   }
 
 }
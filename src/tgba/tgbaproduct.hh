@@ -29,6 +29,7 @@
 
 namespace spot
 {
+  class arena_scope;
 
   /// \brief A state for spot::tgba_product.
   /// \ingroup tgba_on_the_fly_algorithms
@@ -79,6 +80,9 @@ namespace spot
 
 
   /// \brief A lazy product.  (States are computed on the fly.)
+  ///
+  /// A product created in an arena_scope allocates its states and
+  /// iterators from the arena.
   class tgba_product: public tgba
   {
   public:
@@ -123,7 +127,10 @@ namespace spot
     bdd all_acceptance_conditions_;
     bdd neg_acceptance_conditions_;
     bddPair* right_common_acc_;
-    fixed_size_pool pool_;
+    /// The arena of the states and iterators, or 0.
+    arena_scope* arena_;
+    /// Pool of the states: that of the arena, or our own.
+    fixed_size_pool* pool_;
 
   private:
     // Disallow copy.
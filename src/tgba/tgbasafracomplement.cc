@@ -18,9 +18,10 @@
 // Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
 // 02111-1307, USA.
 
-#include <set>
 #include <map>
-#include <deque>
+#include <vector>
+#include <algorithm>
+#include <iterator>
 #include <cassert>
 #include <sstream>
 #include <boost/dynamic_bitset.hpp>
@@ -29,6 +30,7 @@
 #include "tgba/tgbatba.hh"
 #include "tgba/bdddict.hh"
 #include "tgba/state.hh"
+#include "misc/hash.hh"
 #include "misc/hashfunc.hh"
 #include "ltlast/formula.hh"
 #include "ltlast/constant.hh"
@@ -41,425 +43,423 @@ namespace spot
 
   namespace
   {
-    // forward decl.
-    struct safra_tree;
-    struct safra_tree_ptr_less_than:
-      public std::binary_function<const safra_tree*, const safra_tree*, bool>
-    {
-      bool
-      operator()(const safra_tree* left,
-                 const safra_tree* right) const;
-    };
-
-    /// \brief Automaton with Safra's tree as states.
-    struct safra_tree_automaton
-    {
-      safra_tree_automaton(const tgba* sba);
-      ~safra_tree_automaton();
-      typedef std::map<bdd, const safra_tree*, bdd_less_than> transition_list;
-      typedef
-      std::map<safra_tree*, transition_list, safra_tree_ptr_less_than>
-      automaton_t;
-      automaton_t automaton;
-
-      /// \brief The number of acceptance pairs of this Rabin (Streett)
-      /// automaton.
-      int get_nb_acceptance_pairs() const;
-      safra_tree* get_initial_state() const;
-      void set_initial_state(safra_tree* s);
-    private:
-      mutable int max_nb_pairs_;
-      safra_tree* initial_state;
-      const tgba* a_;
-    };
-
     /// \brief A Safra tree, used as state during the determinization
-    /// of a Büchi automaton
+    /// of a Bchi automaton
     ///
     /// It is the key structure of the construction.
     /// Each node of the tree has:
     ///  - A \a name,
-    ///  - A subset of states of the original Büchi automaton (\a nodes),
+    ///  - A subset of states of the original Bchi automaton,
     ///  - A flag that is \a marked to denote vertical merge of nodes,
-    ///  - A list of \a children.
+    ///  - A list of children.
     ///
-    /// This class implements operations:
-    ///  - To compute the successor of this tree,
-    ///  - To retrive acceptance condition on this tree.
+    /// The tree is flattened: its nodes are listed in preorder, older
+    /// children first, and each node is encoded as its name, its
+    /// mark, its number of children, the size of its subset, and the
+    /// numbers of the states of its subset in increasing order.  This
+    /// encoding is canonical, so the trees built by the construction
+    /// are hash-consed and identified by a dense number.
     /// \see safra_determinisation.
-    struct safra_tree
+    typedef std::vector<int> safra_tree;
+
+    struct safra_tree_hash
     {
-      typedef std::set<const state*, state_ptr_less_than> subset_t;
-      typedef std::list<safra_tree*> child_list;
-      typedef std::multimap<bdd, const state*, bdd_less_than> tr_cache_t;
-      typedef std::map<const state*, tr_cache_t,
-                       state_ptr_less_than> cache_t;
+      size_t
+      operator()(const safra_tree& t) const
+      {
+        size_t h = t.size();
+        for (safra_tree::const_iterator i = t.begin(); i != t.end(); ++i)
+          h = hash_combine(h, *i);
+        return h;
+      }
+    };
 
-      safra_tree();
-      safra_tree(const safra_tree& other);
-      safra_tree(const subset_t& nodes, safra_tree* p, int n);
-      ~safra_tree();
+    /// \brief Automaton with Safra's tree as states.
+    struct safra_tree_automaton
+    {
+      safra_tree_automaton(const tgba* sba);
+      ~safra_tree_automaton();
+      typedef std::vector<std::pair<bdd, unsigned> > transition_list;
+      typedef Sgi::hash_map<safra_tree, unsigned, safra_tree_hash> tree_map;
 
-      const safra_tree& operator=(const safra_tree& other);
-      int compare(const safra_tree* other) const;
-      size_t hash() const;
+      /// The trees, by number.  The initial state is number 0.
+      std::vector<const safra_tree*> trees;
+      /// The successors of each tree, by letter.
+      std::vector<transition_list> transitions;
 
-      void add_node(const state* s);
-      int max_name() const;
+      /// \brief Return the number of \a t, adding it if it is new.
+      unsigned number(const safra_tree& t);
 
-      // Operations to get successors of a tree.
-      safra_tree* branch_accepting(const tgba_sba_proxy& a);
-      safra_tree* succ_create(const bdd& condition,
-                              cache_t& cache_transition);
-      safra_tree* normalize_siblings();
-      safra_tree* remove_empty();
-      safra_tree* mark();
+      /// \brief The number of acceptance pairs of this Rabin (Streett)
+      /// automaton.
+      int get_nb_acceptance_pairs() const;
 
       // To get Rabin/Streett acceptance conditions.
-      void getL(bitset_t& bitset) const;
-      void getU(bitset_t& bitset) const;
-
-      /// \brief Does this node the root of the tree?
-      bool is_parent() const
-      {
-        return parent == 0;
-      }
-
-      bool marked;
-      int name;
-      subset_t nodes;
-      child_list children;
+      void getL(unsigned t, bitset_t& bitset) const;
+      void getU(unsigned t, bitset_t& bitset) const;
     private:
-      void remove_node_from_children(const state* state);
-      int get_new_name() const;
-      mutable std::deque<int> free_names_; // Some free names.
-      safra_tree* parent;
+      tree_map numbers_;
+      mutable int max_nb_pairs_;
+      const tgba* a_;
     };
 
-    safra_tree::safra_tree()
-      : marked(false), name(0)
-    {
-      parent = 0;
-    }
-
-    /// \brief Copy the tree \a other, and set \c marked to false.
-    safra_tree::safra_tree(const safra_tree& other)
-      : marked(false)
+    unsigned
+    safra_tree_automaton::number(const safra_tree& t)
     {
-      name = other.name;
-      parent = 0;
-      nodes = other.nodes;
-      for (child_list::const_iterator i = other.children.begin();
-           i != other.children.end(); ++i)
+      std::pair<tree_map::iterator, bool> res =
+        numbers_.insert(std::make_pair(t, trees.size()));
+      if (res.second)
       {
-        safra_tree* c = new safra_tree(**i);
-        c->parent = this;
-        children.push_back(c);
+        trees.push_back(&res.first->first);
+        transitions.push_back(transition_list());
       }
+      return res.first->second;
     }
 
-    safra_tree::safra_tree(const subset_t& nodes, safra_tree* p, int n)
-      : marked(false), name(n), nodes(nodes)
-    {
-      parent = p;
-    }
+    /*-----------------------.
+    | Acceptances conditions |
+    `-----------------------*/
 
-    safra_tree::~safra_tree()
+    /// Returns in which sets L (the semantic differs according to Rabin or
+    /// Streett) the state-tree \a t is included.
+    ///
+    /// \param bitset a bitset of size \c this->get_nb_acceptance_pairs()
+    /// filled with FALSE bits.
+    /// \return bitset[i] will be true if this state-tree is included in L_i
+    void
+    safra_tree_automaton::getL(unsigned t, bitset_t& bitset) const
     {
-      for (child_list::iterator i = children.begin(); i != children.end(); ++i)
-        delete *i;
-
-      for (subset_t::iterator i = nodes.begin(); i != nodes.end(); ++i)
-        (*i)->destroy();
+      const safra_tree& tree = *trees[t];
+      for (unsigned pos = 0; pos < tree.size(); pos += 4 + tree[pos + 3])
+      {
+        assert(bitset.size() > static_cast<unsigned>(tree[pos]));
+        if (tree[pos + 1] && tree[pos + 3])
+          bitset[tree[pos]] = true;
+      }
     }
 
-    const safra_tree&
-    safra_tree::operator=(const safra_tree& other)
+    /// Returns in which sets U (the semantic differs according to Rabin or
+    /// Streett) the state-tree \a t is included.
+    ///
+    /// \param bitset a bitset of size \c this->get_nb_acceptance_pairs()
+    /// filled with TRUE bits.
+    /// \return bitset[i] will be true if this state-tree is included in U_i
+    void
+    safra_tree_automaton::getU(unsigned t, bitset_t& bitset) const
     {
-      if (this != &other)
+      const safra_tree& tree = *trees[t];
+      for (unsigned pos = 0; pos < tree.size(); pos += 4 + tree[pos + 3])
       {
-        this->~safra_tree();
-        new (this) safra_tree(other);
+        assert(bitset.size() > static_cast<unsigned>(tree[pos]));
+        if (tree[pos + 3])
+          bitset[tree[pos]] = false;
       }
-      return *this;
     }
 
-    /// \brief Compare two safra trees.
+    /// \brief Algorithm to determinize Bchi automaton.
+    ///
+    /// Determinization of a Bchi automaton into a Rabin automaton
+    /// using the Safra's construction.
     ///
-    /// \param other
+    /// This construction is presented in:
+    /// @PhDThesis{      safra.89.phd,
+    ///     author     = {Shmuel Safra},
+    ///     title      = {Complexity of Automata on Infinite Objects},
+    ///     school     = {The Weizmann Institute of Science},
+    ///     year       = {1989},
+    ///     address    = {Rehovot, Israel},
+    ///     month      = mar
+    /// }
     ///
-    /// \return 0 if the trees are the same. Otherwise
-    /// a signed value.
-    int safra_tree::compare(const safra_tree* other) const
+    /// The states of the Bchi automaton are numbered once and for
+    /// all.  The letters are split into classes on which all the
+    /// transitions of a state agree, and the successors of a state
+    /// are computed once for each of its classes and shared by all
+    /// the trees.  Each successor tree is built
+    /// in a small pointer-free tree, then flattened and looked up in
+    /// the hash table of the trees already built.
+    class safra_determinisation
     {
-      int subset_compare = 0;
-      subset_t::const_iterator in1 = nodes.begin();
-      subset_t::const_iterator in2 = other->nodes.begin();
-
-      if (nodes.size() != other->nodes.size())
-        return (nodes.size() - other->nodes.size());
-
-      if (name != other->name)
-        return name - other->name;
-
-      for (; in1 != nodes.end() && in2 != other->nodes.end(); ++in1, ++in2)
-        if ((subset_compare = (*in1)->compare(*in2)) != 0)
-          break;
-
-      if (subset_compare != 0)
-        return subset_compare;
-
-      child_list::const_iterator ic1 = children.begin();
-      child_list::const_iterator ic2 = other->children.begin();
-
-      if (children.size() != other->children.size())
-        return (children.size() - other->children.size());
+    public:
+      static safra_tree_automaton* create_safra_automaton(const tgba* a);
+    private:
+      safra_determinisation(const tgba_sba_proxy* sba);
+      void build(safra_tree_automaton* st);
 
-      for (; ic1 != children.end() && ic2 != other->children.end();
-           ++ic1, ++ic2)
+      // Operations to get successors of a tree.
+      unsigned decode(const safra_tree& t, unsigned& pos);
+      void encode(unsigned n, safra_tree& t) const;
+      int get_new_name();
+      void branch_accepting(unsigned n);
+      void succ_create();
+      void normalize_siblings(unsigned n);
+      void remove_nodes(unsigned n, const std::vector<unsigned>& states);
+      void remove_empty(unsigned n);
+      void mark(unsigned n);
+
+      // The Bchi automaton, with states numbered from 0 (the initial
+      // state).
+      struct arc
       {
-        int compare_value = (*ic1)->compare(*ic2);
-        if (compare_value != 0)
-          return compare_value;
-      }
-
-      if (marked != other->marked)
-        return (marked) ? -1 : 1;
-
-      return 0;
-    }
-
+        bdd cond;
+        unsigned dst;
+      };
+      std::vector<std::vector<arc> > arcs_;
+      std::vector<bool> accepting_;
+      // The partition of the letters into the classes on which all
+      // the transitions of each state agree, and the successors of
+      // the state, in increasing order, for each of these classes.
+      std::vector<std::vector<bdd> > classes_;
+      std::vector<std::vector<std::vector<unsigned> > > class_succ_;
+      // The class of each state of the tree for the current letter.
+      std::vector<unsigned> letter_class_;
+
+      // The tree under construction.  Node 0 is the root.
+      struct node
+      {
+        int name;
+        bool marked;
+        std::vector<unsigned> nodes;
+        std::vector<unsigned> children;
+      };
+      std::vector<node> tree_;
+      std::vector<bool> used_names_;
+    };
 
-    /// \brief Hash a safra tree.
-    size_t
-    safra_tree::hash() const
+    safra_determinisation::safra_determinisation(const tgba_sba_proxy* sba)
     {
-      size_t hash = 0;
-      hash ^= wang32_hash(name);
-      hash ^= wang32_hash(marked);
-
-      for (subset_t::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
-        hash ^= (*i)->hash();
-
-      for (child_list::const_iterator i = children.begin();
-           i != children.end();
-           ++i)
-        hash ^= (*i)->hash();
+      typedef Sgi::hash_map<const state*, unsigned,
+                            state_ptr_hash, state_ptr_equal> state_map;
+      state_map seen;
+      std::vector<const state*> todo;
+      const state* init = sba->get_init_state();
+      seen[init] = 0;
+      todo.push_back(init);
+      for (unsigned n = 0; n < todo.size(); ++n)
+      {
+        std::vector<arc> out;
+        tgba_succ_iterator* i = sba->succ_iter(todo[n]);
+        for (i->first(); !i->done(); i->next())
+        {
+          const state* dst = i->current_state();
+          std::pair<state_map::iterator, bool> res =
+            seen.insert(std::make_pair(dst, todo.size()));
+          if (res.second)
+            todo.push_back(dst);
+          else
+            dst->destroy();
+          arc a = { i->current_condition(), res.first->second };
+          out.push_back(a);
+        }
+        delete i;
 
-      return hash;
-    }
+        // Split the letters with the condition of each transition.
+        std::vector<bdd> classes(1, bddtrue);
+        for (unsigned j = 0; j < out.size(); ++j)
+        {
+          std::vector<bdd> split;
+          for (unsigned k = 0; k < classes.size(); ++k)
+          {
+            bdd in = classes[k] & out[j].cond;
+            bdd not_in = classes[k] - out[j].cond;
+            if (in != bddfalse)
+              split.push_back(in);
+            if (not_in != bddfalse)
+              split.push_back(not_in);
+          }
+          classes.swap(split);
+        }
+        std::vector<std::vector<unsigned> > succs(classes.size());
+        for (unsigned k = 0; k < classes.size(); ++k)
+        {
+          for (unsigned j = 0; j < out.size(); ++j)
+            if ((out[j].cond & classes[k]) != bddfalse)
+              succs[k].push_back(out[j].dst);
+          std::sort(succs[k].begin(), succs[k].end());
+          succs[k].erase(std::unique(succs[k].begin(), succs[k].end()),
+                         succs[k].end());
+        }
 
-    void
-    safra_tree::add_node(const state* s)
-    {
-      nodes.insert(s);
+        arcs_.push_back(std::vector<arc>());
+        arcs_.back().swap(out);
+        accepting_.push_back(sba->state_is_accepting(todo[n]));
+        classes_.push_back(std::vector<bdd>());
+        classes_.back().swap(classes);
+        class_succ_.push_back(std::vector<std::vector<unsigned> >());
+        class_succ_.back().swap(succs);
+      }
+      for (unsigned n = 0; n < todo.size(); ++n)
+        todo[n]->destroy();
+      letter_class_.resize(todo.size());
     }
 
     /*---------------------------------.
     | Operations to compute successors |
     `---------------------------------*/
 
-    int
-    safra_tree::max_name() const
-    {
-      int max_name = name;
-      for (child_list::const_iterator i = children.begin();
-           i != children.end(); ++i)
-        max_name = std::max(max_name, (*i)->max_name());
-      return max_name;
-    }
-
-    /// \brief Get an unused name in the tree for a new node.
+    /// \brief Read the node of \a t at \a pos, and its descendants.
     ///
-    /// The root of the tree maintains a list of unused names.
-    /// When this list is empty, new names are computed.
-    int
-    safra_tree::get_new_name() const
+    /// Marks are not read: they are recomputed for each successor.
+    unsigned
+    safra_determinisation::decode(const safra_tree& t, unsigned& pos)
     {
-      if (parent == 0)
+      unsigned n = tree_.size();
+      tree_.push_back(node());
+      int name = t[pos];
+      unsigned nb_children = t[pos + 2];
+      unsigned nb_nodes = t[pos + 3];
+      tree_[n].name = name;
+      tree_[n].marked = false;
+      tree_[n].nodes.assign(t.begin() + pos + 4,
+                            t.begin() + pos + 4 + nb_nodes);
+      if (used_names_.size() <= static_cast<unsigned>(name))
+        used_names_.resize(name + 1, false);
+      used_names_[name] = true;
+      pos += 4 + nb_nodes;
+      for (unsigned i = 0; i < nb_children; ++i)
       {
-        if (free_names_.empty())
-        {
-          std::set<int> used_names;
-          std::deque<const safra_tree*> queue;
-          queue.push_back(this);
-          while (!queue.empty())
-          {
-            const safra_tree* current = queue.front();
-            queue.pop_front();
-            used_names.insert(current->name);
-            for (child_list::const_iterator i = current->children.begin();
-                 i != current->children.end(); ++i)
-              queue.push_back(*i);
-          }
-
-          int l = 0;
-          int nb_found = 0;
-          std::set<int>::const_iterator i = used_names.begin();
-          while (i != used_names.end() && nb_found != 3)
-          {
-            if (l != *i)
-            {
-              free_names_.push_back(l);
-              ++nb_found;
-            }
-            else
-              ++i;
-            ++l;
-          }
+        unsigned c = decode(t, pos);
+        tree_[n].children.push_back(c);
+      }
+      return n;
+    }
 
-          while (nb_found++ < 3)
-            free_names_.push_back(l++);
-        }
+    void
+    safra_determinisation::encode(unsigned n, safra_tree& t) const
+    {
+      const node& x = tree_[n];
+      t.push_back(x.name);
+      t.push_back(x.marked);
+      t.push_back(x.children.size());
+      t.push_back(x.nodes.size());
+      t.insert(t.end(), x.nodes.begin(), x.nodes.end());
+      for (unsigned i = 0; i < x.children.size(); ++i)
+        encode(x.children[i], t);
+    }
 
-        int result = free_names_.front();
-        free_names_.pop_front();
-        return result;
-      }
+    /// \brief Get the smallest name unused in the tree for a new node.
+    int
+    safra_determinisation::get_new_name()
+    {
+      unsigned l = 0;
+      while (l < used_names_.size() && used_names_[l])
+        ++l;
+      if (l == used_names_.size())
+        used_names_.push_back(true);
       else
-        return parent->get_new_name();
+        used_names_[l] = true;
+      return l;
     }
 
     /// If the node has an accepting state in its label, a new child
     /// is inserted with the set of all accepting states of \c nodes
     /// as label and an unused name.
-    safra_tree*
-    safra_tree::branch_accepting(const tgba_sba_proxy& a)
+    void
+    safra_determinisation::branch_accepting(unsigned n)
     {
-      for (child_list::iterator i = children.begin(); i != children.end(); ++i)
-        (*i)->branch_accepting(a);
-
-      subset_t subset;
-      for (subset_t::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
-        if (a.state_is_accepting(*i))
-          subset.insert(*i);
+      unsigned nb_children = tree_[n].children.size();
+      for (unsigned i = 0; i < nb_children; ++i)
+        branch_accepting(tree_[n].children[i]);
 
-      if (!subset.empty())
-        children.push_back(new safra_tree(subset, this, get_new_name()));
+      node c;
+      for (unsigned i = 0; i < tree_[n].nodes.size(); ++i)
+        if (accepting_[tree_[n].nodes[i]])
+          c.nodes.push_back(tree_[n].nodes[i]);
 
-      return this;
+      if (!c.nodes.empty())
+      {
+        c.name = get_new_name();
+        c.marked = false;
+        tree_[n].children.push_back(tree_.size());
+        tree_.push_back(c);
+      }
     }
 
     /// \brief A powerset construction.
     ///
-    /// The successors of each state in \c nodes with \a condition
-    /// as atomic property remplace the current \c nodes set.
-    ///
-    /// @param cache_transition is a map of the form: state -> bdd -> state.
-    ///        Only states present in \c nodes are keys of the map.
-    /// @param condition is an atomic property. We are looking for successors
-    ///        of this atomic property.
-    safra_tree*
-    safra_tree::succ_create(const bdd& condition,
-                            cache_t& cache_transition)
+    /// The successors of each state in \c nodes on the current letter
+    /// (whose class for each state is in \c letter_class_) remplace
+    /// the current \c nodes set, in every node of the tree.
+    void
+    safra_determinisation::succ_create()
     {
-      subset_t new_subset;
-
-      for (subset_t::iterator i = nodes.begin(); i != nodes.end(); ++i)
+      for (unsigned n = 0; n < tree_.size(); ++n)
       {
-        if (cache_transition.find(*i) == cache_transition.end())
-          continue;
-
-        tr_cache_t transitions = cache_transition[*i];
-        for (tr_cache_t::const_iterator t_it = transitions.begin();
-             t_it != transitions.end();
-             ++t_it)
+        std::vector<unsigned> new_subset;
+        const std::vector<unsigned>& nodes = tree_[n].nodes;
+        for (unsigned i = 0; i < nodes.size(); ++i)
         {
-          if ((t_it->first & condition) != bddfalse)
-          {
-            if (new_subset.find(t_it->second) == new_subset.end())
-            {
-              const state* s = t_it->second->clone();
-              new_subset.insert(s);
-            }
-          }
+          const std::vector<unsigned>& dst =
+            class_succ_[nodes[i]][letter_class_[nodes[i]]];
+          new_subset.insert(new_subset.end(), dst.begin(), dst.end());
         }
+        std::sort(new_subset.begin(), new_subset.end());
+        new_subset.erase(std::unique(new_subset.begin(), new_subset.end()),
+                         new_subset.end());
+        tree_[n].nodes.swap(new_subset);
       }
-      nodes = new_subset;
-
-      for (child_list::iterator i = children.begin(); i != children.end(); ++i)
-        (*i)->succ_create(condition, cache_transition);
-
-      return this;
     }
 
     /// \brief Horizontal Merge
     ///
     /// If many children share the same state in their labels, we must keep
     /// only one occurrence (in the older node).
-    safra_tree*
-    safra_tree::normalize_siblings()
+    void
+    safra_determinisation::normalize_siblings(unsigned n)
     {
-      std::set<const state*, state_ptr_less_than> node_set;
-      for (child_list::iterator child_it = children.begin();
-           child_it != children.end();
-           ++child_it)
+      std::vector<unsigned> node_set;
+      for (unsigned i = 0; i < tree_[n].children.size(); ++i)
       {
-        subset_t::iterator node_it = (*child_it)->nodes.begin();
-        while (node_it != (*child_it)->nodes.end())
-        {
-          if (node_set.find(*node_it) != node_set.end())
-          {
-            const state* s = *node_it;
-            (*child_it)->remove_node_from_children(*node_it);
-            (*child_it)->nodes.erase(node_it++);
-            s->destroy();
-          }
-          else
-          {
-            node_set.insert(*node_it);
-            ++node_it;
-          }
-        }
-
-        (*child_it)->normalize_siblings();
+        unsigned c = tree_[n].children[i];
+        std::vector<unsigned> shared;
+        std::set_intersection(tree_[c].nodes.begin(), tree_[c].nodes.end(),
+                              node_set.begin(), node_set.end(),
+                              std::back_inserter(shared));
+        if (!shared.empty())
+          remove_nodes(c, shared);
+
+        std::vector<unsigned> merged;
+        std::set_union(tree_[c].nodes.begin(), tree_[c].nodes.end(),
+                       node_set.begin(), node_set.end(),
+                       std::back_inserter(merged));
+        node_set.swap(merged);
+
+        normalize_siblings(c);
       }
-
-      return this;
     }
 
-    /// \brief Remove recursively all the occurrences of \c state in the label.
+    /// \brief Remove recursively all the occurrences of \a states in
+    /// the label of \a n and of its descendants.
     void
-    safra_tree::remove_node_from_children(const state* state)
+    safra_determinisation::remove_nodes(unsigned n,
+                                        const std::vector<unsigned>& states)
     {
-      for (child_list::iterator child_it = children.begin();
-           child_it != children.end();
-           ++child_it)
-      {
-        subset_t::iterator it = (*child_it)->nodes.find(state);
-        if (it != (*child_it)->nodes.end())
-        {
-          const spot::state* s = *it;
-          (*child_it)->nodes.erase(it);
-          s->destroy();
-        }
-        (*child_it)->remove_node_from_children(state);
-      }
+      std::vector<unsigned> kept;
+      std::set_difference(tree_[n].nodes.begin(), tree_[n].nodes.end(),
+                          states.begin(), states.end(),
+                          std::back_inserter(kept));
+      tree_[n].nodes.swap(kept);
+      for (unsigned i = 0; i < tree_[n].children.size(); ++i)
+        remove_nodes(tree_[n].children[i], states);
     }
 
     /// \brief Remove empty nodes
     ///
     /// If a child of the node has an empty label, we remove this child.
-    safra_tree*
-    safra_tree::remove_empty()
+    void
+    safra_determinisation::remove_empty(unsigned n)
     {
-      child_list::iterator child_it = children.begin();
-      while (child_it != children.end())
+      std::vector<unsigned> kept;
+      for (unsigned i = 0; i < tree_[n].children.size(); ++i)
       {
-        if ((*child_it)->nodes.empty())
-        {
-          safra_tree* to_delete = *child_it;
-          child_it = children.erase(child_it);
-          delete to_delete;
-        }
-        else
+        unsigned c = tree_[n].children[i];
+        if (!tree_[c].nodes.empty())
         {
-          (*child_it)->remove_empty();
-          ++child_it;
+          remove_empty(c);
+          kept.push_back(c);
         }
       }
-
-      return this;
+      tree_[n].children.swap(kept);
     }
 
     /// \brief Vertical merge
@@ -467,342 +467,142 @@ namespace spot
     /// If a parent has the same states as its childen in its label,
     /// All the children a deleted and the node is marked. This mean
     /// an accepting infinite run is found.
-    safra_tree*
-    safra_tree::mark()
+    void
+    safra_determinisation::mark(unsigned n)
     {
-      std::set<const state*, state_ptr_less_than> node_set;
-      for (child_list::const_iterator child_it = children.begin();
-           child_it != children.end();
-           ++child_it)
-      {
-        node_set.insert((*child_it)->nodes.begin(), (*child_it)->nodes.end());
-        (*child_it)->mark();
-      }
-
-      char same = node_set.size() == nodes.size();
-
-      if (same)
+      std::vector<unsigned> node_set;
+      for (unsigned i = 0; i < tree_[n].children.size(); ++i)
       {
-        subset_t::const_iterator i = node_set.begin();
-        subset_t::const_iterator j = nodes.begin();
-
-        while (i != node_set.end() && j != nodes.end())
-        {
-          if ((*i)->compare(*j) != 0)
-          {
-            same = 0;
-            break;
-          }
-          ++i;
-          ++j;
-        }
+        unsigned c = tree_[n].children[i];
+        std::vector<unsigned> merged;
+        std::set_union(tree_[c].nodes.begin(), tree_[c].nodes.end(),
+                       node_set.begin(), node_set.end(),
+                       std::back_inserter(merged));
+        node_set.swap(merged);
+        mark(c);
       }
 
-      if (same)
+      if (node_set == tree_[n].nodes)
       {
-        marked = true;
-        for (child_list::iterator i = children.begin();
-             i != children.end();
-             ++i)
-          delete *i;
-        children = child_list();
+        tree_[n].marked = true;
+        tree_[n].children.clear();
       }
-
-      return this;
-    }
-
-    /*-----------------------.
-    | Acceptances conditions |
-    `-----------------------*/
-
-    /// Returns in which sets L (the semantic differs according to Rabin or
-    /// Streett) the state-tree is included.
-    ///
-    /// \param bitset a bitset of size \c this->get_nb_acceptance_pairs()
-    /// filled with FALSE bits.
-    /// \return bitset[i] will be true if this state-tree is included in L_i
-    void
-    safra_tree::getL(bitset_t& bitset) const
-    {
-      assert(bitset.size() > static_cast<unsigned>(name));
-      if (marked && !nodes.empty())
-        bitset[name] = true;
-      for (child_list::const_iterator i = children.begin();
-           i != children.end();
-           ++i)
-        (*i)->getL(bitset);
-    }
-
-    /// Returns in which sets U (the semantic differs according to Rabin or
-    /// Streett) the state-tree is included.
-    ///
-    /// \param bitset a bitset of size \c this->get_nb_acceptance_pairs()
-    /// filled with TRUE bits.
-    /// \return bitset[i] will be true if this state-tree is included in U_i
-    void
-    safra_tree::getU(bitset_t& bitset) const
-    {
-      assert(bitset.size() > static_cast<unsigned>(name));
-      if (!nodes.empty())
-        bitset[name] = false;
-      for (child_list::const_iterator i = children.begin();
-           i != children.end();
-           ++i)
-        (*i)->getU(bitset);
     }
 
-    bool
-    safra_tree_ptr_less_than::operator()(const safra_tree* left,
-                                         const safra_tree* right) const
-    {
-      assert(left);
-      return left->compare(right) < 0;
-    }
-
-    struct safra_tree_ptr_equal:
-      public std::unary_function<const safra_tree*, bool>
-    {
-      safra_tree_ptr_equal(const safra_tree* left)
-        : left_(left) {}
-
-      bool
-      operator()(const safra_tree* right) const
-      {
-        return left_->compare(right) == 0;
-      }
-    private:
-      const safra_tree* left_;
-    };
-
-    /// \brief Algorithm to determinize Büchi automaton.
-    ///
-    /// Determinization of a Büchi automaton into a Rabin automaton
-    /// using the Safra's construction.
-    ///
-    /// This construction is presented in:
-    /// @PhDThesis{      safra.89.phd,
-    ///     author     = {Shmuel Safra},
-    ///     title      = {Complexity of Automata on Infinite Objects},
-    ///     school     = {The Weizmann Institute of Science},
-    ///     year       = {1989},
-    ///     address    = {Rehovot, Israel},
-    ///     month      = mar
-    /// }
-    ///
-    class safra_determinisation
-    {
-    public:
-      static safra_tree_automaton* create_safra_automaton(const tgba* a);
-    private:
-      typedef std::set<int> atomic_list_t;
-      typedef std::set<bdd, bdd_less_than> conjunction_list_t;
-      static void retrieve_atomics(const safra_tree* node, tgba_sba_proxy* sba,
-                                   safra_tree::cache_t& cache,
-                                   atomic_list_t& atomic_list);
-      static void set_atomic_list(atomic_list_t& list, bdd condition);
-      static conjunction_list_t
-      get_conj_list(const atomic_list_t& atomics);
-    };
-
     /// \brief The body of Safra's construction.
     safra_tree_automaton*
     safra_determinisation::create_safra_automaton(const tgba* a)
     {
       // initialization.
       tgba_sba_proxy* sba = new tgba_sba_proxy(a);
-
       safra_tree_automaton* st = new safra_tree_automaton(sba);
-
-      std::deque<safra_tree*> queue;
-      safra_tree* q0 = new safra_tree();
-      q0->add_node(sba->get_init_state());
-      queue.push_back(q0);
-      st->set_initial_state(q0);
-
-      // main loop
-      while (!queue.empty())
-      {
-        safra_tree* current = queue.front();
-        // safra_tree* node = new safra_tree(*current);
-
-        // Get conjunction list and save successors.
-        safra_tree::cache_t cache;
-        atomic_list_t atomic_list;
-        retrieve_atomics(current, sba, cache, atomic_list);
-        conjunction_list_t conjunction = get_conj_list(atomic_list);
-
-        // Create successors of the Safra's tree.
-        safra_tree_automaton::transition_list transitions;
-        for (conjunction_list_t::const_iterator i = conjunction.begin();
-             i != conjunction.end(); ++i)
-        {
-          safra_tree* successor = new safra_tree(*current);
-          successor->branch_accepting(sba); // Step 2
-          successor->succ_create(*i, cache); // Step 3
-          successor->normalize_siblings(); // Step 4
-          successor->remove_empty(); // Step 5
-          successor->mark(); // Step 6
-
-          bool delete_this_successor = true;
-          safra_tree_ptr_equal comparator(successor);
-          if (st->automaton.find(successor) != st->automaton.end())
-          {
-            transitions[*i] = st->automaton.find(successor)->first;
-          }
-          else
-          {
-            std::deque<safra_tree*>::iterator item_in_queue =
-              std::find_if(queue.begin(), queue.end(), comparator);
-            if (item_in_queue != queue.end())
-            {
-              transitions[*i] = *item_in_queue;
-            }
-            else
-            {
-              delete_this_successor = false;
-              transitions[*i] = successor;
-              queue.push_back(successor);
-            }
-          }
-          if (delete_this_successor)
-            delete successor;
-        }
-
-        if (st->automaton.find(current) == st->automaton.end())
-          st->automaton[current] = transitions;
-
-        queue.pop_front();
-
-        for (safra_tree::cache_t::iterator i = cache.begin();
-             i != cache.end();
-             ++i)
-          for (safra_tree::tr_cache_t::iterator j = i->second.begin();
-               j != i->second.end();
-               ++j)
-            j->second->destroy();
-        // delete node;
-      }
-
-      // delete sba;
+      safra_determinisation d(sba);
+      d.build(st);
       return st;
     }
 
-    /// Retrieve all atomics properties that are in successors formulae
-    /// of the states in the label of the node.
     void
-    safra_determinisation::retrieve_atomics(const safra_tree* node,
-                                            tgba_sba_proxy* sba,
-                                            safra_tree::cache_t& cache,
-                                            atomic_list_t& atomic_list)
+    safra_determinisation::build(safra_tree_automaton* st)
     {
-      for (safra_tree::subset_t::iterator it = node->nodes.begin();
-           it != node->nodes.end();
-           ++it)
+      // The initial tree is a root named 0 labeled by the initial state.
+      safra_tree q0;
+      q0.push_back(0);
+      q0.push_back(false);
+      q0.push_back(0);
+      q0.push_back(1);
+      q0.push_back(0);
+      st->number(q0);
+
+      // main loop
+      for (unsigned t = 0; t < st->trees.size(); ++t)
       {
-        safra_tree::tr_cache_t transitions;
-        tgba_succ_iterator* iterator = sba->succ_iter(*it);
-        for (iterator->first(); !iterator->done(); iterator->next())
+        tree_.clear();
+        used_names_.clear();
+        unsigned pos = 0;
+        decode(*st->trees[t], pos);
+        branch_accepting(0); // Step 2
+        std::vector<node> branched;
+        branched.swap(tree_);
+
+        // The letters are the intersections of the classes of the
+        // states of the tree (all of them are in the root), so that
+        // each state has the same successors on all the letters of a
+        // class.  letter_classes[i][j] is the class of root[j] that
+        // contains letters[i].
+        const std::vector<unsigned>& root = branched[0].nodes;
+        std::vector<bdd> letters(1, bddtrue);
+        std::vector<std::vector<unsigned> > letter_classes(1);
+        for (unsigned j = 0; j < root.size(); ++j)
         {
-          bdd condition = iterator->current_condition();
-          typedef std::pair<bdd, const state*> bdd_state;
-          transitions.insert(bdd_state(condition, iterator->current_state()));
-          set_atomic_list(atomic_list, condition);
+          const std::vector<bdd>& classes = classes_[root[j]];
+          std::vector<bdd> split;
+          std::vector<std::vector<unsigned> > split_classes;
+          for (unsigned i = 0; i < letters.size(); ++i)
+            for (unsigned k = 0; k < classes.size(); ++k)
+            {
+              bdd l = letters[i] & classes[k];
+              if (l == bddfalse)
+                continue;
+              split.push_back(l);
+              split_classes.push_back(letter_classes[i]);
+              split_classes.back().push_back(k);
+            }
+          letters.swap(split);
+          letter_classes.swap(split_classes);
         }
-        delete iterator;
-        cache[*it] = transitions;
-      }
-    }
 
-    /// Insert in \a list atomic properties of the formula \a c.
-    void
-    safra_determinisation::set_atomic_list(atomic_list_t& list, bdd c)
-    {
-      bdd current = bdd_satone(c);
-      while (current != bddtrue && current != bddfalse)
-      {
-        list.insert(bdd_var(current));
-        bdd high = bdd_high(current);
-        if (high == bddfalse)
-          current = bdd_low(current);
-        else
-          current = high;
-      }
-    }
-
-    /// From the list of atomic properties \a atomics, create the list
-    /// of all the conjunctions of properties.
-    safra_determinisation::conjunction_list_t
-    safra_determinisation::get_conj_list(const atomic_list_t& atomics)
-    {
-      conjunction_list_t list;
-      unsigned atomics_size = atomics.size();
-
-      assert(atomics_size < 32);
-      for (unsigned i = 1; i <= static_cast<unsigned>(1 << atomics_size); ++i)
-      {
-        bdd result = bddtrue;
-        unsigned position = 1;
-        for (atomic_list_t::const_iterator a_it = atomics.begin();
-             a_it != atomics.end();
-             ++a_it, position <<= 1)
+        // Create successors of the Safra's tree.
+        safra_tree_automaton::transition_list transitions;
+        std::vector<bool> names(used_names_);
+        for (unsigned i = 0; i < letters.size(); ++i)
         {
-          bdd this_atomic;
-          if (position & i)
-            this_atomic = bdd_ithvar(*a_it);
-          else
-            this_atomic = bdd_nithvar(*a_it);
-          result = bdd_apply(result, this_atomic, bddop_and);
+          for (unsigned j = 0; j < root.size(); ++j)
+            letter_class_[root[j]] = letter_classes[i][j];
+          tree_ = branched;
+          used_names_ = names;
+          succ_create(); // Step 3
+          normalize_siblings(0); // Step 4
+          remove_empty(0); // Step 5
+          mark(0); // Step 6
+
+          safra_tree successor;
+          encode(0, successor);
+          transitions.push_back(std::make_pair(letters[i],
+                                               st->number(successor)));
         }
-        list.insert(result);
+        st->transitions[t].swap(transitions);
       }
-
-      return list;
     }
 
     // Safra's test part. Dot output.
     //////////////////////////////
     namespace test
     {
-      void print_safra_tree(const safra_tree* this_node,
-                            std::map<int, int>& node_names,
-                            int& current_node,
-                            int nb_accepting_conditions)
+      void print_safra_tree(const safra_tree& tree, unsigned t,
+                            unsigned& pos, const std::string& conditions)
       {
-        std::string conditions;
-        if (this_node->is_parent())
-        {
-          bitset_t l(nb_accepting_conditions);
-          bitset_t u(nb_accepting_conditions);
-          u.flip();
-          this_node->getL(l);
-          this_node->getU(u);
-          std::stringstream s;
-          s << "\\nL:" << l << ", U:" << u;
-          conditions = s.str();
-        }
-
-        std::cout << "node" << this_node << "[label=\"";
-        std::cout << this_node->name << "|";
-        for (safra_tree::subset_t::const_iterator j = this_node->nodes.begin();
-             j != this_node->nodes.end();
-             ++j)
-        {
-          if (node_names.find((*j)->hash()) == node_names.end())
-            node_names[(*j)->hash()] = current_node++;
-          std::cout << node_names[(*j)->hash()] << ", ";
-        }
-        std::cout << conditions;
-        if (this_node->marked)
+        unsigned self = pos;
+        unsigned nb_children = tree[pos + 2];
+        unsigned nb_nodes = tree[pos + 3];
+
+        std::cout << "node" << t << "_" << self << "[label=\"";
+        std::cout << tree[pos] << "|";
+        for (unsigned j = 0; j < nb_nodes; ++j)
+          std::cout << tree[pos + 4 + j] << ", ";
+        if (self == 0)
+          std::cout << conditions;
+        if (tree[pos + 1])
           std::cout << "\", style=filled, fillcolor=\"gray";
 
         std::cout << "\"];" << std::endl;
 
-        safra_tree::child_list::const_iterator i = this_node->children.begin();
-        for (; i != this_node->children.end(); ++i)
+        pos += 4 + nb_nodes;
+        for (unsigned i = 0; i < nb_children; ++i)
         {
-          print_safra_tree(*i, node_names, current_node,
-                           nb_accepting_conditions);
-          std::cout << "node" << this_node << " -> node" << *i
+          unsigned child = pos;
+          print_safra_tree(tree, t, pos, conditions);
+          std::cout << "node" << t << "_" << self
+                    << " -> node" << t << "_" << child
                     << "[color=\"red\", arrowhead=\"none\"];"
                     << std::endl;
         }
@@ -810,33 +610,35 @@ namespace spot
 
       void print_safra_automaton(safra_tree_automaton* a)
       {
-        safra_tree_automaton::automaton_t node_list = a->automaton;
-        typedef safra_tree_automaton::automaton_t::reverse_iterator
-          automaton_cit;
         typedef safra_tree_automaton::transition_list::const_iterator
           trans_cit;
-        std::map<int, int> node_names;
-        int current_node = 0;
         int nb_accepting_conditions = a->get_nb_acceptance_pairs();
 
         std::cout << "digraph A {" << std::endl;
 
-	/// GCC 3.3 complains if a const_reverse_iterator is used.
-	/// error: no match for 'operator!='
-        for (automaton_cit i = a->automaton.rbegin();
-             i != a->automaton.rend();
-             ++i)
+        for (unsigned i = 0; i < a->trees.size(); ++i)
         {
-          std::cout << "subgraph sg" << i->first << "{" << std::endl;
-          print_safra_tree(i->first, node_names, current_node,
-                           nb_accepting_conditions);
+          bitset_t l(nb_accepting_conditions);
+          bitset_t u(nb_accepting_conditions);
+          u.flip();
+          a->getL(i, l);
+          a->getU(i, u);
+          std::stringstream s;
+          s << "\\nL:" << l << ", U:" << u;
+
+          std::cout << "subgraph sg" << i << "{" << std::endl;
+          unsigned pos = 0;
+          print_safra_tree(*a->trees[i], i, pos, s.str());
           std::cout << "}" << std::endl;
 
           // Successors.
-          for (trans_cit j = i->second.begin(); j != i->second.end(); ++j)
-            std::cout << "node" << i->first << "->"
-                      << "node" << j->second <<
-              " [label=\"" << bddset << j->first << "\"];" << std::endl;
+          const safra_tree_automaton::transition_list& tr =
+            a->transitions[i];
+          for (trans_cit j = tr.begin(); j != tr.end(); ++j)
+            std::cout << "node" << i << "_0->"
+                      << "node" << j->second << "_0"
+                      << " [label=\"" << bddset << j->first << "\"];"
+                      << std::endl;
         }
 
         std::cout << "}" << std::endl;
@@ -851,12 +653,12 @@ namespace spot
     class state_complement : public state
     {
     public:
-      state_complement(bitset_t U, bitset_t L, const safra_tree* tree,
+      state_complement(bitset_t U, bitset_t L, unsigned tree,
                        bool use_bitset = true);
       state_complement(const state_complement& other);
 
-      /// \return the safra tree associated to this state.
-      const safra_tree* get_safra() const
+      /// \return the number of the safra tree associated to this state.
+      unsigned get_safra() const
       {
         return tree;
       }
@@ -892,12 +694,12 @@ namespace spot
     private:
       bitset_t U;
       bitset_t L;
-      const safra_tree* tree;
+      unsigned tree;
       bool use_bitset;
     };
 
     state_complement::state_complement(bitset_t L, bitset_t U,
-                                       const safra_tree* tree,
+                                       unsigned tree,
                                        bool use_bitset)
       : state(), U(U), L(L), tree(tree), use_bitset(use_bitset)
     {
@@ -929,13 +731,15 @@ namespace spot
         return (L < s->L) ? -1 : 1;
       if (use_bitset != s->use_bitset)
         return use_bitset - s->use_bitset;
-      return tree->compare(s->tree);
+      if (tree != s->tree)
+        return (tree < s->tree) ? -1 : 1;
+      return 0;
     }
 
     size_t
     state_complement::hash() const
     {
-      size_t hash = tree->hash();
+      size_t hash = wang32_hash(tree);
       hash ^= wang32_hash(use_bitset);
 
       size_t size_bitset = L.size();
@@ -1054,19 +858,13 @@ namespace spot
   ////////////////////////
 
   safra_tree_automaton::safra_tree_automaton(const tgba* a)
-    : max_nb_pairs_(-1), initial_state(0), a_(a)
+    : max_nb_pairs_(-1), a_(a)
   {
     a->get_dict()->register_all_variables_of(a, this);
   }
 
   safra_tree_automaton::~safra_tree_automaton()
   {
-    for (automaton_t::iterator i = automaton.begin();
-         i != automaton.end();
-         ++i)
-    {
-      delete i->first;
-    }
     delete a_;
   }
 
@@ -1077,25 +875,15 @@ namespace spot
       return max_nb_pairs_;
 
     int max = -1;
-    for (automaton_t::const_iterator i = automaton.begin();
-         i != automaton.end();
-         ++i)
-      max = std::max(max, i->first->max_name());
+    for (unsigned i = 0; i < trees.size(); ++i)
+    {
+      const safra_tree& t = *trees[i];
+      for (unsigned pos = 0; pos < t.size(); pos += 4 + t[pos + 3])
+        max = std::max(max, t[pos]);
+    }
     return max_nb_pairs_ = max + 1;
   }
 
-  safra_tree*
-  safra_tree_automaton::get_initial_state() const
-  {
-    return initial_state;
-  }
-
-  void
-  safra_tree_automaton::set_initial_state(safra_tree* s)
-  {
-    initial_state = s;
-  }
-
   // End of the safra construction
   //////////////////////////////////////////
 
@@ -1144,7 +932,7 @@ namespace spot
   {
     safra_tree_automaton* a = static_cast<safra_tree_automaton*>(safra_);
     bitset_t empty(a->get_nb_acceptance_pairs());
-    return new state_complement(empty, empty, a->get_initial_state(), false);
+    return new state_complement(empty, empty, 0, false);
   }
 
 
@@ -1191,85 +979,80 @@ namespace spot
     const state_complement* s =
       down_cast<const state_complement*>(local_state);
     assert(s);
-    safra_tree_automaton::automaton_t::const_iterator tr =
-      a->automaton.find(const_cast<safra_tree*>(s->get_safra()));
+    const safra_tree_automaton::transition_list& tr =
+      a->transitions[s->get_safra()];
 
     typedef safra_tree_automaton::transition_list::const_iterator trans_iter;
 
-    if (tr != a->automaton.end())
-    {
-      bdd condition = bddfalse;
-      tgba_safra_complement_succ_iterator::succ_list_t succ_list;
-      int nb_acceptance_pairs = a->get_nb_acceptance_pairs();
-      bitset_t e(nb_acceptance_pairs);
+    bdd condition = bddfalse;
+    tgba_safra_complement_succ_iterator::succ_list_t succ_list;
+    int nb_acceptance_pairs = a->get_nb_acceptance_pairs();
+    bitset_t e(nb_acceptance_pairs);
 
-      if (!s->get_use_bitset()) // if \delta'(q, a)
+    if (!s->get_use_bitset()) // if \delta'(q, a)
+    {
+      for (trans_iter i = tr.begin(); i != tr.end(); ++i)
       {
-        for (trans_iter i = tr->second.begin(); i != tr->second.end(); ++i)
-        {
-          state_complement* s1 = new state_complement(e, e, i->second, false);
-          state_complement* s2 = new state_complement(e, e, i->second, true);
-          succ_list.insert(std::make_pair(i->first, s1));
-          succ_list.insert(std::make_pair(i->first, s2));
-        }
+        state_complement* s1 = new state_complement(e, e, i->second, false);
+        state_complement* s2 = new state_complement(e, e, i->second, true);
+        succ_list.insert(std::make_pair(i->first, s1));
+        succ_list.insert(std::make_pair(i->first, s2));
       }
-      else
-      {
-        bitset_t l(nb_acceptance_pairs);
-        bitset_t u(nb_acceptance_pairs);
-        u.flip();
-        s->get_safra()->getL(l); // {i : q \in L_i}
-        s->get_safra()->getU(u); // {j : q \in U_i}
-        state_complement* st;
+    }
+    else
+    {
+      bitset_t l(nb_acceptance_pairs);
+      bitset_t u(nb_acceptance_pairs);
+      u.flip();
+      a->getL(s->get_safra(), l); // {i : q \in L_i}
+      a->getU(s->get_safra(), u); // {j : q \in U_i}
+      state_complement* st;
 
 #if TRANSFORM_TO_TBA
-        bitset_t newI = s->get_L() | l; // {I' = I \cup {i : q \in L_i}}
-        bitset_t newJ = s->get_U() | u; // {J' = J \cup {j : q \in U_i}}
+      bitset_t newI = s->get_L() | l; // {I' = I \cup {i : q \in L_i}}
+      bitset_t newJ = s->get_U() | u; // {J' = J \cup {j : q \in U_i}}
 
-        if (newI.is_subset_of(newJ)) // \delta'((q, I, J), a) if I'\subseteq J'
-        {
-          for (trans_iter i = tr->second.begin(); i != tr->second.end(); ++i)
-          {
-            st = new state_complement(e, e, i->second, true);
-            succ_list.insert(std::make_pair(i->first, st));
-          }
-          condition = the_acceptance_cond_;
-        }
-        else  // \delta'((q, I, J), a)
+      if (newI.is_subset_of(newJ)) // \delta'((q, I, J), a) if I'\subseteq J'
+      {
+        for (trans_iter i = tr.begin(); i != tr.end(); ++i)
         {
-          for (trans_iter i = tr->second.begin(); i != tr->second.end(); ++i)
-          {
-            st = new state_complement(newI, newJ, i->second, true);
-            succ_list.insert(std::make_pair(i->first, st));
-          }
+          st = new state_complement(e, e, i->second, true);
+          succ_list.insert(std::make_pair(i->first, st));
         }
-#else
-        bitset_t S = s->get_L();
-        bitset_t pending = (S | l) - u;  // {pending = S \cup {i : q \in L_i}
-                                          // \setminus {j : q \in U_j})}
-        for (trans_iter i = tr->second.begin(); i != tr->second.end(); ++i)
+        condition = the_acceptance_cond_;
+      }
+      else  // \delta'((q, I, J), a)
+      {
+        for (trans_iter i = tr.begin(); i != tr.end(); ++i)
         {
-          st = new state_complement(pending, e, i->second, true);
+          st = new state_complement(newI, newJ, i->second, true);
           succ_list.insert(std::make_pair(i->first, st));
         }
+      }
+#else
+      bitset_t S = s->get_L();
+      bitset_t pending = (S | l) - u;  // {pending = S \cup {i : q \in L_i}
+                                        // \setminus {j : q \in U_j})}
+      for (trans_iter i = tr.begin(); i != tr.end(); ++i)
+      {
+        st = new state_complement(pending, e, i->second, true);
+        succ_list.insert(std::make_pair(i->first, st));
+      }
 
-        for (unsigned i = 0; i < l.size(); ++i)
+      for (unsigned i = 0; i < l.size(); ++i)
+      {
+        if (!S[i])
         {
-          if (!S[i])
-          {
-            if (condition == bddfalse)
-              condition = bdd_ithvar(acceptance_cond_vec_[i]);
-            else
-              condition &= bdd_ithvar(acceptance_cond_vec_[i]);
-          }
+          if (condition == bddfalse)
+            condition = bdd_ithvar(acceptance_cond_vec_[i]);
+          else
+            condition &= bdd_ithvar(acceptance_cond_vec_[i]);
         }
-#endif
       }
-
-      return new tgba_safra_complement_succ_iterator(succ_list, condition);
+#endif
     }
-    assert("Safra automaton does not find this node");
-    return 0;
+
+    return new tgba_safra_complement_succ_iterator(succ_list, condition);
   }
 
   bdd_dict*
@@ -1313,16 +1096,13 @@ namespace spot
     const safra_tree_automaton* a = static_cast<safra_tree_automaton*>(safra_);
     const state_complement* s = down_cast<const state_complement*>(state);
     assert(s);
-    typedef safra_tree_automaton::automaton_t::const_iterator auto_it;
     typedef safra_tree_automaton::transition_list::const_iterator trans_it;
-    auto_it node(a->automaton.find(const_cast<safra_tree*>(s->get_safra())));
-
-    if (node == a->automaton.end())
-      return bddtrue;
+    const safra_tree_automaton::transition_list& node =
+      a->transitions[s->get_safra()];
 
     bdd res = bddtrue;
     trans_it i;
-    for (i = node->second.begin(); i != node->second.end(); ++i)
+    for (i = node.begin(); i != node.end(); ++i)
       res |= i->first;
     return res;
   }
@@ -1333,16 +1113,13 @@ namespace spot
     const safra_tree_automaton* a = static_cast<safra_tree_automaton*>(safra_);
     const state_complement* s = down_cast<const state_complement*>(state);
     assert(s);
-    typedef safra_tree_automaton::automaton_t::const_iterator auto_it;
     typedef safra_tree_automaton::transition_list::const_iterator trans_it;
-    auto_it node(a->automaton.find(const_cast<safra_tree*>(s->get_safra())));
-
-    if (node == a->automaton.end())
-      return bddtrue;
+    const safra_tree_automaton::transition_list& node =
+      a->transitions[s->get_safra()];
 
     bdd res = bddtrue;
     trans_it i;
-    for (i = node->second.begin(); i != node->second.end(); ++i)
+    for (i = node.begin(); i != node.end(); ++i)
       res &= bdd_support(i->first);
     return res;
   }
@@ -25,6 +25,7 @@
 #include "tgbatba.hh"
 #include "bddprint.hh"
 #include "ltlast/constant.hh"
+#include "misc/arena.hh"
 #include "misc/hashfunc.hh"
 
 namespace spot
@@ -105,6 +106,34 @@ namespace spot
       iterator acc_;
     };
 
+    /// \brief A state_tba_proxy allocated from an arena, as are its
+    /// clones.
+    class arena_state_tba_proxy: public state_tba_proxy, public arena_object
+    {
+      typedef tgba_tba_proxy::cycle_list::const_iterator iterator;
+    public:
+      arena_state_tba_proxy(state* s, iterator acc)
+	: state_tba_proxy(s, acc)
+      {
+      }
+
+      virtual
+      state_tba_proxy* clone() const
+      {
+	return new(arena_of(this)) arena_state_tba_proxy(*this);
+      }
+    };
+
+    /// Create a state_tba_proxy, from \a arena unless it is 0.
+    state_tba_proxy*
+    new_state_tba_proxy(arena_scope* arena, state* s,
+			tgba_tba_proxy::cycle_list::const_iterator acc)
+    {
+      if (arena)
+	return new(arena) arena_state_tba_proxy(s, acc);
+      return new state_tba_proxy(s, acc);
+    }
+
 
     typedef std::pair<const state_tba_proxy*, bool> state_ptr_bool_t;
 
@@ -136,7 +165,8 @@ namespace spot
 				   iterator expected,
 				   const list& cycle,
 				   bdd the_acceptance_cond,
-				   const tgba_tba_proxy* aut)
+				   const tgba_tba_proxy* aut,
+				   arena_scope* arena)
 	: the_acceptance_cond_(the_acceptance_cond)
       {
 	for (it->first(); !it->done(); it->next())
@@ -193,7 +223,7 @@ namespace spot
 	    while (next != expected && (acc & *next) == *next)
 	      ++next;
 	  next_is_set:
-	    state_tba_proxy* dest = new state_tba_proxy(odest, next);
+	    state_tba_proxy* dest = new_state_tba_proxy(arena, odest, next);
 	    // Is DEST already reachable with the same value of ACCEPTING?
 	    state_ptr_bool_t key(dest, accepting);
 	    transmap_t::iterator id = transmap_.find(key);
@@ -276,7 +306,7 @@ namespace spot
   } // anonymous
 
   tgba_tba_proxy::tgba_tba_proxy(const tgba* a)
-    : a_(a)
+    : a_(a), arena_(arena_scope::current())
   {
     // We will use one acceptance condition for this automata.
     // Let's call it Acc[True].
@@ -325,7 +355,8 @@ namespace spot
   state*
   tgba_tba_proxy::get_init_state() const
   {
-    return new state_tba_proxy(a_->get_init_state(), acc_cycle_.begin());
+    return new_state_tba_proxy(arena_, a_->get_init_state(),
+			       acc_cycle_.begin());
   }
 
   tgba_succ_iterator*
@@ -342,7 +373,7 @@ namespace spot
 
     return new tgba_tba_proxy_succ_iterator(it, s->acceptance_iterator(),
 					    acc_cycle_, the_acceptance_cond_,
-					    this);
+					    this, arena_);
   }
 
   bdd
@@ -474,7 +505,7 @@ namespace spot
   state*
   tgba_sba_proxy::get_init_state() const
   {
-    return new state_tba_proxy(a_->get_init_state(), cycle_start_);
+    return new_state_tba_proxy(arena_, a_->get_init_state(), cycle_start_);
   }
 
   bool
@@ -31,6 +31,7 @@
 
 namespace spot
 {
+  class arena_scope;
 
   /// \brief Degeneralize a spot::tgba on the fly, producing a TBA.
   /// \ingroup tgba_on_the_fly_algorithms
@@ -93,6 +94,8 @@ namespace spot
 
     cycle_list acc_cycle_;
     const tgba* a_;
+    /// The arena of the states, or 0.
+    arena_scope* arena_;
   private:
     bdd the_acceptance_cond_;
     typedef Sgi::hash_map<const state*, bdd,
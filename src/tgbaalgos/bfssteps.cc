@@ -1,3 +1,5 @@
+// Copyright (C) 2011 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE).
 // Copyright (C) 2004  Laboratoire d'Informatique de Paris 6 (LIP6),
 // dpartement Systmes Rpartis Coopratifs (SRC), Universit Pierre
 // et Marie Curie.
@@ -37,25 +39,24 @@ namespace spot
   }
 
   void
-  bfs_steps::finalize(const std::map<const state*, tgba_run::step,
-                state_ptr_less_than>& father, const tgba_run::step& s,
-                const state* start, tgba_run::steps& l)
+  bfs_steps::finalize(const father_map& father, const tgba_run::step& s,
+		      const state* start, tgba_run::steps& l)
   {
+    // Collect the path backward, and append it to l in reverse.
     tgba_run::steps p;
     tgba_run::step current = s;
     for (;;)
       {
         tgba_run::step tmp = current;
         tmp.s = tmp.s->clone();
-        p.push_front(tmp);
+        p.push_back(tmp);
         if (current.s == start)
           break;
-        std::map<const state*, tgba_run::step,
-            state_ptr_less_than>::const_iterator it = father.find(current.s);
+        father_map::const_iterator it = father.find(current.s);
         assert(it != father.end());
         current = it->second;
       }
-    l.splice(l.end(), p);
+    l.insert(l.end(), p.rbegin(), p.rend());
   }
 
   const state*
@@ -63,8 +64,7 @@ namespace spot
   {
     // Records backlinks to parent state during the BFS.
     // (This also stores the propositions of this link.)
-    std::map<const state*, tgba_run::step,
-      state_ptr_less_than> father;
+    father_map father;
     // BFS queue.
     std::deque<const state*> todo;
     // Initial state.
@@ -96,11 +96,8 @@ namespace spot
 
 	    // Common case: record backlinks and continue BFS
 	    // for unvisited states.
-	    if (father.find(dest) == father.end())
-	      {
-		todo.push_back(dest);
-		father[dest] = s;
-	      }
+	    if (father.insert(std::make_pair(dest, s)).second)
+	      todo.push_back(dest);
 	  }
 	delete i;
       }
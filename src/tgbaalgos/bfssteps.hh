@@ -24,7 +24,7 @@
 #ifndef SPOT_TGBAALGOS_BFSSTEPS_HH
 # define SPOT_TGBAALGOS_BFSSTEPS_HH
 
-#include <map>
+#include "misc/hash.hh"
 #include "tgba/state.hh"
 #include "emptiness.hh"
 
@@ -43,12 +43,22 @@ namespace spot
   class bfs_steps
   {
   public:
+    /// \brief Backlinks recorded during the search.
+    ///
+    /// Because filter() returns a unique state* for each state,
+    /// states can be looked up by address, without calling
+    /// state::hash() or state::compare().
+    typedef Sgi::hash_map<const state*, tgba_run::step,
+			  ptr_hash<state> > father_map;
+
     bfs_steps(const tgba* a);
     virtual ~bfs_steps();
 
     /// \brief Start the search from \a start, and append the
     /// resulting path (if any) to \a l.
     ///
+    /// \a start should be a state* as returned by filter().
+    ///
     /// \return the destination state of the last step (not included
     /// in \a l) if a matching path was found, or 0 otherwise.
     const state* search(const state* start, tgba_run::steps& l);
@@ -60,7 +70,8 @@ namespace spot
     /// state* that search() has just allocated (using
     /// tgba_succ_iterator::current_state()), and the return of this
     /// function should be a state* that does not need to be freed by
-    /// search().
+    /// search().  Two calls for the same state must return the same
+    /// state*, because search() identifies states by address.
     ///
     /// If you already have a map or a set which uses states as keys,
     /// you should probably arrange for filter() to return these keys,
@@ -93,8 +104,7 @@ namespace spot
     /// resulting path to \a l.  This seldom needs to be overridden,
     /// unless you do not want \a l to be updated (in which case an empty
     /// finalize() will do).
-    virtual void finalize(const std::map<const state*, tgba_run::step,
-			                 state_ptr_less_than>& father,
+    virtual void finalize(const father_map& father,
 			  const tgba_run::step& s,
 			  const state* start,
 			  tgba_run::steps& l);
@@ -0,0 +1,203 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#include <cassert>
+#include <iostream>
+#include "compactrun.hh"
+#include "emptiness.hh"
+#include "tgba/tgba.hh"
+#include "tgba/bddprint.hh"
+
+namespace spot
+{
+  namespace
+  {
+    // Follow a compact run, keeping only the current state alive.
+    class compact_run_walker
+    {
+    public:
+      compact_run_walker(const tgba* a)
+	: a_(a), s_(a->get_init_state())
+      {
+      }
+
+      ~compact_run_walker()
+      {
+	s_->destroy();
+      }
+
+      const state*
+      current_state() const
+      {
+	return s_;
+      }
+
+      // Take the n-th transition leaving the current state.
+      void
+      follow(unsigned n, bdd& label, bdd& acc)
+      {
+	tgba_succ_iterator* i = a_->succ_iter(s_);
+	i->first();
+	for (; n > 0; --n)
+	  {
+	    assert(!i->done());
+	    i->next();
+	  }
+	assert(!i->done());
+	label = i->current_condition();
+	acc = i->current_acceptance_conditions();
+	const state* dest = i->current_state();
+	delete i;
+	s_->destroy();
+	s_ = dest;
+      }
+
+    private:
+      const tgba* a_;
+      const state* s_;
+    };
+
+    // Find the position of the transition labeled by \a label and
+    // \a acc between \a src and \a dest.  Return false if there is
+    // no such transition.
+    bool
+    find_step(const tgba* a, const state* src, const bdd& label,
+	      const bdd& acc, const state* dest, unsigned& n)
+    {
+      tgba_succ_iterator* i = a->succ_iter(src);
+      bool found = false;
+      for (i->first(), n = 0; !i->done(); i->next(), ++n)
+	{
+	  if (i->current_condition() != label
+	      || i->current_acceptance_conditions() != acc)
+	    continue;
+	  const state* s = i->current_state();
+	  found = !s->compare(dest);
+	  s->destroy();
+	  if (found)
+	    break;
+	}
+      delete i;
+      return found;
+    }
+
+    bool
+    compact_steps(const tgba* a, const tgba_run::steps& l,
+		  const state* after, compact_tgba_run::steps& res)
+    {
+      res.reserve(l.size());
+      for (tgba_run::steps::const_iterator i = l.begin(); i != l.end();)
+	{
+	  const state* src = i->s;
+	  const bdd& label = i->label;
+	  const bdd& acc = i->acc;
+	  ++i;
+	  const state* dest = i == l.end() ? after : i->s;
+	  unsigned n;
+	  if (!find_step(a, src, label, acc, dest, n))
+	    return false;
+	  res.push_back(n);
+	}
+      return true;
+    }
+
+    void
+    expand_steps(compact_run_walker& w, const compact_tgba_run::steps& l,
+		 tgba_run::steps& res)
+    {
+      res.reserve(l.size());
+      for (compact_tgba_run::steps::const_iterator i = l.begin();
+	   i != l.end(); ++i)
+	{
+	  tgba_run::step st = { w.current_state()->clone(),
+				bddfalse, bddfalse };
+	  w.follow(*i, st.label, st.acc);
+	  res.push_back(st);
+	}
+    }
+
+    void
+    print_steps(std::ostream& os, const tgba* a, compact_run_walker& w,
+		const compact_tgba_run::steps& l)
+    {
+      bdd_dict* d = a->get_dict();
+      for (compact_tgba_run::steps::const_iterator i = l.begin();
+	   i != l.end(); ++i)
+	{
+	  os << "  " << a->format_state(w.current_state()) << std::endl;
+	  bdd label;
+	  bdd acc;
+	  w.follow(*i, label, acc);
+	  os << "  |  ";
+	  bdd_print_formula(os, d, label);
+	  os << "\t";
+	  bdd_print_accset(os, d, acc);
+	  os << std::endl;
+	}
+    }
+  }
+
+  compact_tgba_run*
+  compact_run(const tgba* a, const tgba_run* run)
+  {
+    if (run->cycle.empty())
+      return 0;
+    const state* loop = run->cycle.front().s;
+
+    // The run must start on the initial state.
+    const state* init = a->get_init_state();
+    const state* first = run->prefix.empty() ? loop : run->prefix.front().s;
+    bool ok = !init->compare(first);
+    init->destroy();
+
+    compact_tgba_run* res = new compact_tgba_run;
+    if (!ok
+	|| !compact_steps(a, run->prefix, loop, res->prefix)
+	|| !compact_steps(a, run->cycle, loop, res->cycle))
+      {
+	delete res;
+	return 0;
+      }
+    return res;
+  }
+
+  tgba_run*
+  expand_run(const tgba* a, const compact_tgba_run* run)
+  {
+    tgba_run* res = new tgba_run;
+    compact_run_walker w(a);
+    expand_steps(w, run->prefix, res->prefix);
+    expand_steps(w, run->cycle, res->cycle);
+    return res;
+  }
+
+  std::ostream&
+  print_tgba_run(std::ostream& os,
+		 const tgba* a,
+		 const compact_tgba_run* run)
+  {
+    compact_run_walker w(a);
+    os << "Prefix:" << std::endl;
+    print_steps(os, a, w, run->prefix);
+    os << "Cycle:" << std::endl;
+    print_steps(os, a, w, run->cycle);
+    return os;
+  }
+}
@@ -0,0 +1,74 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#ifndef SPOT_TGBAALGOS_COMPACTRUN_HH
+# define SPOT_TGBAALGOS_COMPACTRUN_HH
+
+#include <iosfwd>
+#include <vector>
+
+namespace spot
+{
+  struct tgba_run;
+  class tgba;
+
+  /// \addtogroup tgba_run
+  /// @{
+
+  /// \brief An accepted run of a tgba, stored as successor numbers.
+  ///
+  /// Each step records the position of the transition taken, in the
+  /// order in which tgba::succ_iter() enumerates the successors of
+  /// the current state.  States, labels, and acceptance conditions
+  /// are regenerated from the automaton when needed, so a step costs
+  /// an unsigned instead of a cloned state and two BDDs.
+  ///
+  /// This assumes that the automaton enumerates the successors of a
+  /// state in the same order each time it is asked to.
+  struct compact_tgba_run
+  {
+    typedef std::vector<unsigned> steps;
+
+    steps prefix;
+    steps cycle;
+  };
+
+  /// \brief Compress a tgba_run.
+  ///
+  /// \return a new compact_tgba_run, or 0 if \a run is not a run of
+  /// \a a.
+  compact_tgba_run* compact_run(const tgba* a, const tgba_run* run);
+
+  /// \brief Rebuild the tgba_run of \a a corresponding to \a run.
+  tgba_run* expand_run(const tgba* a, const compact_tgba_run* run);
+
+  /// \brief Display a compact_tgba_run.
+  ///
+  /// The output is the same as that of print_tgba_run() on the
+  /// expanded run, but states are generated one step at a time, and
+  /// destroyed as soon as they have been printed.
+  std::ostream& print_tgba_run(std::ostream& os,
+			       const tgba* a,
+			       const compact_tgba_run* run);
+
+  /// @}
+}
+
+#endif // SPOT_TGBAALGOS_COMPACTRUN_HH
@@ -21,7 +21,17 @@
 #include <iostream>
 #include <string>
 #include <queue>
+#include <stack>
+#include <vector>
+#include <cerrno>
+#include <poll.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #include "tgba/tgbaexplicit.hh"
+#include "tgba/tgbaproduct.hh"
+#include "emptiness.hh"
 #include "cutscc.hh"
 
 namespace spot
@@ -407,4 +417,141 @@ namespace spot
     }
     return iter_count;
   }
+
+  namespace
+  {
+    // A worker process, and the read end of a pipe whose write end
+    // only the worker holds: it reaches end-of-file when the worker
+    // exits.
+    struct split_worker
+    {
+      pid_t pid;
+      int fd;
+    };
+
+    // Check the product of A and B in a new process, described in W.
+    // The exit status of the process is 1 if the product has an
+    // accepting run, 0 if it has none, and 2 on error.  Return false
+    // if the process could not be started.
+    bool
+    spawn_check(const tgba* a, const tgba* b, const char* algo,
+		split_worker& w)
+    {
+      int fds[2];
+      if (pipe(fds) < 0)
+	return false;
+      pid_t pid = fork();
+      if (pid < 0)
+      {
+	close(fds[0]);
+	close(fds[1]);
+	return false;
+      }
+      if (pid > 0)
+      {
+	close(fds[1]);
+	w.pid = pid;
+	w.fd = fds[0];
+	return true;
+      }
+      // Worker.  Never return to the caller, and leave its
+      // buffered output alone.  The caller may ignore SIGTERM, but
+      // it must still be able to stop us.
+      close(fds[0]);
+      signal(SIGTERM, SIG_DFL);
+      const char* err;
+      emptiness_check_instantiator* inst =
+	emptiness_check_instantiator::construct(algo, &err);
+      if (!inst)
+	_exit(2);
+      tgba_product p(a, b);
+      emptiness_check* ec = inst->instantiate(&p);
+      if (!ec)
+	_exit(2);
+      emptiness_check_result* res = ec->check();
+      _exit(res ? 1 : 0);
+    }
+
+    // Reap the worker W, and return its exit status (2 if it did not
+    // exit normally).
+    int
+    reap_worker(const split_worker& w)
+    {
+      close(w.fd);
+      int status;
+      while (waitpid(w.pid, &status, 0) < 0)
+	if (errno != EINTR)
+	  return 2;
+      return WIFEXITED(status) ? WEXITSTATUS(status) : 2;
+    }
+  }
+
+  int split_emptiness_check(const tgba* model,
+			    const std::list<tgba*>& split,
+			    unsigned jobs, const char* algo)
+  {
+    if (jobs == 0)
+      jobs = 1;
+    std::list<tgba*>::const_iterator it = split.begin();
+    std::vector<split_worker> running;
+    int res = 0;
+    while (res == 0 && (it != split.end() || !running.empty()))
+    {
+      // Start a worker for each remaining product, as long as there
+      // are free slots.
+      while (it != split.end() && running.size() < jobs)
+      {
+	split_worker w;
+	if (!spawn_check(model, *it, algo, w))
+	{
+	  res = -1;
+	  break;
+	}
+	running.push_back(w);
+	++it;
+      }
+      if (running.empty())
+	break;
+
+      // Wait until some workers exit.
+      std::vector<pollfd> fds(running.size());
+      for (unsigned i = 0; i < running.size(); ++i)
+      {
+	fds[i].fd = running[i].fd;
+	fds[i].events = POLLIN;
+      }
+      if (poll(&fds[0], fds.size(), -1) < 0)
+      {
+	if (errno == EINTR)
+	  continue;
+	res = -1;
+	break;
+      }
+      std::vector<split_worker> still_running;
+      for (unsigned i = 0; i < running.size(); ++i)
+      {
+	if (!fds[i].revents)
+	{
+	  still_running.push_back(running[i]);
+	  continue;
+	}
+	// An accepting run is an answer, even if another worker
+	// failed.
+	int status = reap_worker(running[i]);
+	if (status == 1)
+	  res = 1;
+	else if (status != 0 && res == 0)
+	  res = -1;
+      }
+      running.swap(still_running);
+    }
+
+    // Stop the workers that are still running: either the answer is
+    // known, or it cannot be computed.
+    for (unsigned i = 0; i < running.size(); ++i)
+      kill(running[i].pid, SIGTERM);
+    for (unsigned i = 0; i < running.size(); ++i)
+      reap_worker(running[i]);
+    return res;
+  }
 }
@@ -23,6 +23,7 @@
 # define SPOT_TGBAALGOS_CUTSCC_HH
 
 #include <iosfwd>
+#include <list>
 #include <set>
 #include <vector>
 #include "tgba/public.hh"
@@ -41,6 +42,27 @@ namespace spot
   std::list<tgba*> split_tgba(tgba* a, const scc_map& m,
 			      unsigned split_number);
 
+  /// \brief Check the products of \a model with the automata of \a
+  /// split concurrently.
+  ///
+  /// Each product is checked by the emptiness check \a algo (see
+  /// emptiness_check_instantiator::construct()) in its own worker
+  /// process, because BuDDy cannot be shared between threads.  At
+  /// most \a jobs workers run at the same time.  The other workers
+  /// are stopped as soon as one of them finds an accepting run, or
+  /// one of them fails.
+  ///
+  /// The workers stay in the process group of the caller, so that
+  /// they are interrupted with it from the terminal.  They are
+  /// waited for and killed individually: the other children of the
+  /// caller are left alone.
+  ///
+  /// \return 1 if one of the products has an accepting run, 0 if
+  /// none has, and -1 if a worker could not be started or failed.
+  /// All the workers have been reaped on return.
+  int split_emptiness_check(const tgba* model,
+			    const std::list<tgba*>& split,
+			    unsigned jobs, const char* algo = "Cou99");
 }
 
 #endif // SPOT_TGBAALGOS_CUTSCC_HH
@@ -0,0 +1,253 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#include <cassert>
+#include <deque>
+#include <vector>
+#include "degen.hh"
+#include "tgba/tgbaexplicit.hh"
+#include "tgbaalgos/scc.hh"
+#include "ltlast/constant.hh"
+#include "misc/hash.hh"
+
+namespace spot
+{
+  namespace
+  {
+    // A transition of the input automaton, between numbered states.
+    struct edge
+    {
+      unsigned dest;
+      bdd cond;
+      bdd acc;
+    };
+
+    // A transition of the output automaton, before it is created.
+    struct out_edge
+    {
+      int dest;
+      bool accepting;
+      bdd cond;
+    };
+  }
+
+  tgba_explicit_number*
+  degeneralize(const tgba* a, bool state_based)
+  {
+    scc_map sm(a);
+    sm.build_map();
+
+    // Number the states of A, and record their SCC.  The states are
+    // owned by SM.
+    typedef Sgi::hash_map<const state*, unsigned,
+			  state_ptr_hash, state_ptr_equal> num_map;
+    num_map num;
+    std::vector<const state*> states;
+    std::vector<unsigned> scc_of;
+    unsigned scc_count = sm.scc_count();
+    for (unsigned n = 0; n < scc_count; ++n)
+      {
+	const std::vector<const state*>& st = sm.states_of(n);
+	std::vector<const state*>::const_iterator i;
+	for (i = st.begin(); i != st.end(); ++i)
+	  {
+	    num[*i] = states.size();
+	    states.push_back(*i);
+	    scc_of.push_back(n);
+	  }
+      }
+    unsigned count = states.size();
+
+    // Read the transitions of A once.  For each state, also compute
+    // the acceptance conditions common to all its outgoing
+    // transitions (as tgba_tba_proxy does), and whether it has a
+    // self-loop carrying all acceptance conditions.
+    bdd all = a->all_acceptance_conditions();
+    std::vector<std::vector<edge> > edges(count);
+    std::vector<bdd> common(count);
+    std::vector<bool> acc_loop(count);
+    for (unsigned s = 0; s < count; ++s)
+      {
+	bdd c = all;
+	tgba_succ_iterator* it = a->succ_iter(states[s]);
+	for (it->first(); !it->done(); it->next())
+	  {
+	    const state* dest = it->current_state();
+	    num_map::const_iterator d = num.find(dest);
+	    assert(d != num.end());
+	    dest->destroy();
+	    edge e;
+	    e.dest = d->second;
+	    e.cond = it->current_condition();
+	    e.acc = it->current_acceptance_conditions();
+	    c &= e.acc;
+	    if (e.dest == s && e.acc == all)
+	      acc_loop[s] = true;
+	    edges[s].push_back(e);
+	  }
+	delete it;
+	common[s] = c;
+      }
+
+    // The cycle of expected acceptance conditions, in the same order
+    // as tgba_tba_proxy.  As in tgba_sba_proxy, bddtrue denotes the
+    // (N+1)th level, whose states are accepting.  It is also the
+    // only level when there is no acceptance condition.
+    std::vector<bdd> order;
+    for (bdd left = all; left != bddfalse;)
+      {
+	bdd next = bdd_satone(left);
+	left -= next;
+	order.push_back(next);
+      }
+    unsigned nacc = order.size();
+    if (state_based || nacc == 0)
+      order.push_back(bddtrue);
+    unsigned levels = order.size();
+
+    // The level at which each state is entered from another SCC.
+    // Levels do not matter in non-accepting SCCs: level 0 is always
+    // used there.
+    std::vector<unsigned> entry(count);
+    for (unsigned s = 0; s < count; ++s)
+      {
+	unsigned l = 0;
+	if (sm.accepting(scc_of[s]))
+	  {
+	    if (state_based && nacc > 0 && acc_loop[s])
+	      {
+		// Start on an accepting state, so that S is not
+		// duplicated (see tgba_sba_proxy).
+		l = nacc;
+	      }
+	    else
+	      {
+		// Skip the conditions that any cycle through S sees.
+		while (l < nacc && (common[s] & order[l]) == order[l])
+		  ++l;
+		if (l == levels)
+		  l = 0;
+	      }
+	  }
+	entry[s] = l;
+      }
+
+    tgba_explicit_number* res = new tgba_explicit_number(a->get_dict());
+    res->declare_acceptance_condition(ltl::constant::true_instance());
+    bdd res_acc = res->all_acceptance_conditions();
+
+    // Number of the output state of each (state, level) pair, or -1.
+    std::vector<int> out(count * levels, -1);
+    std::deque<unsigned> todo;
+    int out_count = 0;
+    {
+      state* init = a->get_init_state();
+      unsigned i = num[init];
+      init->destroy();
+      unsigned p = i * levels + entry[i];
+      out[p] = out_count++;
+      res->set_init_state(out[p]);
+      todo.push_back(p);
+    }
+
+    std::vector<out_edge> succ;
+    while (!todo.empty())
+      {
+	unsigned p = todo.front();
+	todo.pop_front();
+	unsigned s = p / levels;
+	unsigned l = p % levels;
+	bool on_true = order[l] == bddtrue;
+
+	succ.clear();
+	std::vector<edge>::const_iterator e;
+	for (e = edges[s].begin(); e != edges[s].end(); ++e)
+	  {
+	    unsigned d = e->dest;
+	    unsigned next;
+	    bool accepting;
+	    if (scc_of[d] != scc_of[s] || !sm.accepting(scc_of[d]))
+	      {
+		// This transition cannot be part of an accepting
+		// cycle.  It is only marked as accepting when leaving
+		// an accepting state, to keep the result state-based.
+		next = entry[d];
+		accepting = on_true;
+	      }
+	    else
+	      {
+		// Same as tgba_tba_proxy_succ_iterator.
+		bdd acc = e->acc | common[d];
+		next = l;
+		if (!on_true)
+		  {
+		    while (next < levels
+			   && (acc & order[next]) == order[next])
+		      ++next;
+		  }
+		if (!on_true && next < levels)
+		  {
+		    accepting = false;
+		  }
+		else
+		  {
+		    accepting = true;
+		    next = 0;
+		    while (next != l && (acc & order[next]) == order[next])
+		      ++next;
+		  }
+	      }
+
+	    unsigned q = d * levels + next;
+	    if (out[q] < 0)
+	      {
+		out[q] = out_count++;
+		todo.push_back(q);
+	      }
+
+	    // Merge transitions with the same destination and
+	    // acceptance.
+	    std::vector<out_edge>::iterator o;
+	    for (o = succ.begin(); o != succ.end(); ++o)
+	      if (o->dest == out[q] && o->accepting == accepting)
+		{
+		  o->cond |= e->cond;
+		  break;
+		}
+	    if (o == succ.end())
+	      {
+		out_edge oe = { out[q], accepting, e->cond };
+		succ.push_back(oe);
+	      }
+	  }
+
+	std::vector<out_edge>::const_iterator o;
+	for (o = succ.begin(); o != succ.end(); ++o)
+	  {
+	    tgba_explicit::transition* t =
+	      res->create_transition(out[p], o->dest);
+	    res->add_conditions(t, o->cond);
+	    if (o->accepting)
+	      res->add_acceptance_conditions(t, res_acc);
+	  }
+      }
+    return res;
+  }
+}
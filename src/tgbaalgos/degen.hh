@@ -0,0 +1,50 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#ifndef SPOT_TGBAALGOS_DEGEN_HH
+# define SPOT_TGBAALGOS_DEGEN_HH
+
+namespace spot
+{
+  class tgba;
+  class tgba_explicit_number;
+
+  /// \brief Degeneralize a spot::tgba into an explicit automaton.
+  /// \ingroup tgba_misc
+  ///
+  /// This builds the same kind of automaton as tgba_tba_proxy (or
+  /// tgba_sba_proxy if \a state_based is set), but the result is
+  /// constructed once and for all as a spot::tgba_explicit_number
+  /// with a single acceptance condition.  It is therefore cheaper
+  /// to explore several times.
+  ///
+  /// The SCCs of \a a are used to keep the result small: the level
+  /// of the degeneralization counter is reset when entering a new
+  /// SCC, and it is not tracked at all in non-accepting SCCs, whose
+  /// transitions are never accepting.
+  ///
+  /// When \a state_based is set, all the transitions leaving a state
+  /// are accepting if one of them is, so the result can be seen as
+  /// a State-based Bchi Automaton.
+  tgba_explicit_number* degeneralize(const tgba* a,
+				     bool state_based = false);
+}
+
+#endif // SPOT_TGBAALGOS_DEGEN_HH
@@ -49,6 +49,8 @@ namespace spot
 
   tgba_run::tgba_run(const tgba_run& run)
   {
+    prefix.reserve(run.prefix.size());
+    cycle.reserve(run.cycle.size());
     for (steps::const_iterator i = run.prefix.begin();
 	 i != run.prefix.end(); ++i)
       {
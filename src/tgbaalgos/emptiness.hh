@@ -23,7 +23,7 @@
 # define SPOT_TGBAALGOS_EMPTINESS_HH
 
 #include <map>
-#include <list>
+#include <vector>
 #include <iosfwd>
 #include <bdd.h>
 #include "misc/optionmap.hh"
@@ -258,7 +258,12 @@ namespace spot
       bdd acc;
     };
 
-    typedef std::list<step> steps;
+    /// \brief A sequence of steps.
+    ///
+    /// Steps are stored contiguously, so long runs do not pay for a
+    /// list node per step.  See compact_tgba_run for a smaller
+    /// representation that does not store the states.
+    typedef std::vector<step> steps;
 
     steps prefix;
     steps cycle;
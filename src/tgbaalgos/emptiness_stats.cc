@@ -0,0 +1,115 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#include <csignal>
+#include <iostream>
+#include <iomanip>
+#include <sys/time.h>
+#include "emptiness_stats.hh"
+#include "misc/memusage.hh"
+
+namespace spot
+{
+  namespace
+  {
+    // Number of transitions between two looks at the clock.
+    const unsigned check_step = 1 << 14;
+
+    volatile sig_atomic_t sigusr1_received = 0;
+
+    void
+    on_sigusr1(int)
+    {
+      sigusr1_received = 1;
+    }
+
+    double
+    wall_clock()
+    {
+      struct timeval tv;
+      gettimeofday(&tv, 0);
+      return tv.tv_sec + tv.tv_usec / 1e6;
+    }
+  }
+
+  ec_progress::~ec_progress()
+  {
+  }
+
+  void
+  ec_progress::report_on_sigusr1()
+  {
+    signal(SIGUSR1, on_sigusr1);
+  }
+
+  ec_progress_printer::ec_progress_printer(std::ostream& os)
+    : os_(os), start_(wall_clock()), last_time_(start_), last_states_(0)
+  {
+  }
+
+  void
+  ec_progress_printer::progress(const ec_statistics& stats)
+  {
+    double now = wall_clock();
+    double rate = 0.;
+    if (now > last_time_ && stats.states() >= last_states_)
+      rate = (stats.states() - last_states_) / (now - last_time_);
+    last_time_ = now;
+    last_states_ = stats.states();
+
+    std::ios::fmtflags old = os_.flags();
+    std::streamsize prec = os_.precision();
+    os_ << std::fixed << std::setprecision(1)
+	<< "progress: " << now - start_ << "s, "
+	<< stats.states() << " states, "
+	<< stats.transitions() << " transitions, depth "
+	<< stats.depth() << " (max. " << stats.max_depth() << "), "
+	<< std::setprecision(0) << rate << " states/s, "
+	<< peak_memusage() << " kB peak RSS" << std::endl;
+    os_.flags(old);
+    os_.precision(prec);
+  }
+
+  void
+  ec_statistics::set_progress(ec_progress* p, double interval)
+  {
+    progress_ = p;
+    interval_ = interval;
+    next_report_ = wall_clock() + interval;
+    next_check_ = p ? transitions_ + check_step : 0;
+  }
+
+  void
+  ec_statistics::check_progress()
+  {
+    // transitions_ has wrapped around with no progress receiver.
+    if (!progress_)
+      return;
+    next_check_ = transitions_ + check_step;
+    double now = wall_clock();
+    bool periodic = interval_ > 0. && now >= next_report_;
+    if (!periodic && !sigusr1_received)
+      return;
+    sigusr1_received = 0;
+    if (periodic)
+      next_report_ = now + interval_;
+    progress_->progress(*this);
+  }
+}
@@ -1,3 +1,5 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE).
 // Copyright (C) 2004, 2005  Laboratoire d'Informatique de Paris 6 (LIP6),
 // dpartement Systmes Rpartis Coopratifs (SRC), Universit Pierre
 // et Marie Curie.
@@ -23,6 +25,7 @@
 # define SPOT_TGBAALGOS_EMPTINESS_STATS_HH
 
 #include <cassert>
+#include <iosfwd>
 #include <map>
 #include "misc/ltstr.hh"
 
@@ -115,6 +118,47 @@ namespace spot
     bool set;
   };
 
+  class ec_statistics;
+
+  /// \brief Receive progress reports from a running emptiness check.
+  ///
+  /// See ec_statistics::set_progress().
+  class ec_progress
+  {
+  public:
+    virtual ~ec_progress();
+
+    /// Called with the statistics of the running emptiness check.
+    virtual void progress(const ec_statistics& stats) = 0;
+
+    /// \brief Also report progress when the process receives SIGUSR1.
+    ///
+    /// This installs a signal handler that raises a flag, checked by
+    /// the emptiness checks whenever they look at the clock.
+    static void report_on_sigusr1();
+  };
+
+  /// \brief Print one line per progress report.
+  ///
+  /// Each line gives the time elapsed since the creation of the
+  /// printer, the number of states and transitions visited, the
+  /// current and maximal depth, the number of states visited per
+  /// second since the previous report, and the peak resident set size
+  /// of the program.
+  class ec_progress_printer: public ec_progress
+  {
+  public:
+    ec_progress_printer(std::ostream& os);
+
+    virtual void progress(const ec_statistics& stats);
+
+  private:
+    std::ostream& os_;
+    double start_;
+    double last_time_;
+    unsigned last_states_;
+  };
+
   /// \brief Emptiness-check statistics
   ///
   /// Implementations of spot::emptiness_check may also implement
@@ -124,7 +168,8 @@ namespace spot
   {
   public :
     ec_statistics()
-    : states_(0), transitions_(0), depth_(0), max_depth_(0)
+    : states_(0), transitions_(0), depth_(0), max_depth_(0),
+      progress_(0), interval_(0.), next_report_(0.), next_check_(0)
     {
       stats["states"] =
 	static_cast<unsigned_statistics::unsigned_fun>(&ec_statistics::states);
@@ -151,7 +196,8 @@ namespace spot
     void
     inc_transitions()
     {
-      ++transitions_;
+      if (++transitions_ == next_check_)
+	check_progress();
     }
 
     void
@@ -193,11 +239,27 @@ namespace spot
       return depth_;
     }
 
+    /// \brief Report the progress of the emptiness check to \a p.
+    ///
+    /// \a p is called every \a interval seconds (never if \a interval
+    /// is 0), and after the process has received SIGUSR1 if
+    /// ec_progress::report_on_sigusr1() was called.  The clock is
+    /// only looked at every few thousand transitions, so the search
+    /// pays one comparison per transition.  Pass 0 as \a p to stop
+    /// reporting.
+    void set_progress(ec_progress* p, double interval = 10.);
+
   private :
+    void check_progress();
+
     unsigned states_;		/// number of disctint visited states
     unsigned transitions_;	/// number of visited transitions
     unsigned depth_;		/// maximal depth of the stack(s)
     unsigned max_depth_;	/// maximal depth of the stack(s)
+    ec_progress* progress_;	/// receiver of progress reports
+    double interval_;		/// seconds between two reports
+    double next_report_;	/// time of the next report
+    unsigned next_check_;	/// transition count of the next check
   };
 
   /// \brief Accepting Run Search statistics.
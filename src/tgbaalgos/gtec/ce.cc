@@ -21,6 +21,7 @@
 // Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
 // 02111-1307, USA.
 
+#include <algorithm>
 #include "ce.hh"
 #include "tgbaalgos/bfssteps.hh"
 #include "misc/hash.hh"
@@ -147,8 +148,7 @@ namespace spot
     assert(cycle_ep_it != run_->cycle.end());
 
     // Now shift the cycle so it starts on cycle_entry_point.
-    run_->cycle.splice(run_->cycle.end(), run_->cycle,
-		       run_->cycle.begin(), cycle_ep_it);
+    std::rotate(run_->cycle.begin(), cycle_ep_it, run_->cycle.end());
 
     return run_;
   }
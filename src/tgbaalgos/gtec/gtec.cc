@@ -168,6 +168,7 @@ namespace spot
     {
       state* init = ecs_->aut->get_init_state();
       ecs_->h->insert(init, 1);
+      inc_states();
       ecs_->root.push(1);
       arc.push(bddfalse);
       tgba_succ_iterator* iter = ecs_->aut->succ_iter(init);
@@ -238,6 +239,7 @@ namespace spot
 	    // Yes.  Number it, stack it, and register its successors
 	    // for later processing.
 	    ecs_->h->insert(dest, ++num);
+	    inc_states();
 	    ecs_->root.push(num);
 	    arc.push(acc);
 	    tgba_succ_iterator* iter = ecs_->aut->succ_iter(dest);
@@ -351,6 +353,7 @@ namespace spot
     // Setup depth-first search from the initial state.
     const state* i = ecs_->aut->get_init_state();
     ecs_->h->insert(i, ++num);
+    inc_states();
     ecs_->root.push(num);
     todo.push_back(todo_item(i, num, this));
     inc_depth(1);
@@ -509,6 +512,7 @@ namespace spot
 	    queue.erase(old);
 	    dec_depth();
 	    ecs_->h->insert(succ.s, ++num);
+	    inc_states();
 	    ecs_->root.push(num);
 	    arc.push(succ.acc);
 	    todo.push_back(todo_item(succ.s, num, this));
@@ -22,6 +22,7 @@
 // 02111-1307, USA.
 
 #include "nsheap.hh"
+#include "misc/arena.hh"
 
 namespace spot
 {
@@ -77,8 +78,15 @@ namespace spot
     };
   } // anonymous
 
+  numbered_state_heap_hash_map::numbered_state_heap_hash_map()
+    : destroy_states_(!arena_scope::current())
+  {
+  }
+
   numbered_state_heap_hash_map::~numbered_state_heap_hash_map()
   {
+    if (!destroy_states_)
+      return;
     // Free keys in H.
     hash_type::iterator i = h.begin();
     while (i != h.end())
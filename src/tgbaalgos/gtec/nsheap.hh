@@ -104,10 +104,15 @@ namespace spot
     virtual numbered_state_heap* build() const = 0;
   };
 
-  /// A straightforward implementation of numbered_state_heap with a hash map.
+  /// \brief A straightforward implementation of numbered_state_heap
+  /// with a hash map.
+  ///
+  /// A heap created in an arena_scope does not destroy its states
+  /// when it is deleted: they are released with the arena.
   class numbered_state_heap_hash_map : public numbered_state_heap
   {
   public:
+    numbered_state_heap_hash_map();
     virtual ~numbered_state_heap_hash_map();
 
     virtual state_index find(const state* s) const;
@@ -124,6 +129,7 @@ namespace spot
 			  state_ptr_hash, state_ptr_equal> hash_type;
   protected:
     hash_type h;		///< Map of visited states.
+    bool destroy_states_;	///< Whether to destroy the states on exit.
   };
 
   /// \brief Factory for numbered_state_heap_hash_map.
@@ -31,6 +31,7 @@
 #endif
 
 #include <cassert>
+#include <algorithm>
 #include <utility>
 #include <vector>
 #include "tgba/tgba.hh"
@@ -309,7 +310,7 @@ namespace spot
 	  assert(scc_root >= 0);
 
 	  // Construct the prefix by unwinding the DFS stack before
-	  // scc_root.
+	  // scc_root.  The steps are collected backward.
 	  int father = data.stack[scc_root].pre;
 	  while (father >= 0)
 	    {
@@ -319,9 +320,10 @@ namespace spot
 		  data.stack[father].lasttr->current_condition(),
 		  data.stack[father].lasttr->current_acceptance_conditions()
 		};
-	      res->prefix.push_front(st);
+	      res->prefix.push_back(st);
 	      father = data.stack[father].pre;
 	    }
+	  std::reverse(res->prefix.begin(), res->prefix.end());
 
 	  // Construct the cycle in two phases.  A first BFS finds the
 	  // shortest path from scc_root to an accepting transition.
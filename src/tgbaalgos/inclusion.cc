@@ -0,0 +1,884 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#include <cassert>
+#include <deque>
+#include <utility>
+#include <vector>
+#include "inclusion.hh"
+#include "emptiness.hh"
+#include "sccfilter.hh"
+#include "tgba/tgbatba.hh"
+#include "misc/hash.hh"
+#include "misc/hashfunc.hh"
+
+namespace spot
+{
+  namespace
+  {
+    // A state of the complement of the SBA: one entry per state of
+    // the SBA, -1 for states outside the current subset, and
+    // 2 * rank + 1 or 2 * rank for states that are, or are not, in
+    // the set of even-ranked states still awaited by the breakpoint.
+    typedef std::vector<int> ranking;
+
+    inline int
+    rank_of(int v)
+    {
+      return v >> 1;
+    }
+
+    inline bool
+    awaited(int v)
+    {
+      return v & 1;
+    }
+
+    struct ranking_hash
+    {
+      size_t
+      operator()(const ranking& r) const
+      {
+	size_t h = r.size();
+	for (ranking::const_iterator i = r.begin(); i != r.end(); ++i)
+	  h = hash_combine(h, *i);
+	return h;
+      }
+    };
+
+    struct pair_hash
+    {
+      size_t
+      operator()(const std::pair<unsigned, unsigned>& p) const
+      {
+	return hash_combine(wang32_hash(p.first), p.second);
+      }
+    };
+
+    // Whether the language of D includes that of C.  It does if D
+    // ranks a subset of the states ranked by C, and gives them
+    // ranks at least as high.  (The breakpoint does not matter: if
+    // every path of the run DAG is eventually stuck in odd ranks,
+    // any breakpoint empties infinitely often.)
+    bool
+    subsumes(const ranking& d, const ranking& c)
+    {
+      unsigned n = d.size();
+      for (unsigned i = 0; i < n; ++i)
+	if (d[i] >= 0 && (c[i] < 0 || rank_of(d[i]) < rank_of(c[i])))
+	  return false;
+      return true;
+    }
+
+    struct sba_arc
+    {
+      bdd cond;
+      unsigned dst;
+    };
+
+    // Part of the alphabet on which a state of the complement has
+    // the same successors, and the highest ranking of these
+    // successors.
+    struct letter
+    {
+      bdd cond;
+      ranking top;
+    };
+    typedef std::vector<letter> letters;
+
+    // Successors of a product state sharing a state of A and a
+    // letter, enumerated from the highest ranks down.
+    struct group
+    {
+      unsigned a_dst;
+      bdd label;
+      bdd acc;
+      const ranking* top;
+    };
+
+    struct edge
+    {
+      unsigned dst;
+      bdd label;
+      bdd acc;
+      bool c_acc;
+    };
+
+    struct frame
+    {
+      unsigned p;
+      std::vector<group> groups;
+      unsigned gi;
+      // Current ranks of the group, and its maximal successor if it
+      // has been produced.
+      std::vector<int> odo;
+      unsigned gmax;
+      bool odd_tried;
+    };
+
+    class inclusion_search
+    {
+    public:
+      inclusion_search(const tgba* a, const tgba* b)
+	: a_(a), all_acc_(a->all_acceptance_conditions()), num_(0)
+      {
+	// States of B that cannot reach an accepting cycle would only
+	// enlarge the rankings.
+	tgba* useful = scc_filter(b);
+	explore_b(useful);
+	delete useful;
+	// The bounds are computed the first time they are needed.
+	max_rank_.resize(n_, -1);
+	universal_.resize(n_, false);
+	for (unsigned q = 0; q < n_; ++q)
+	  {
+	    const std::vector<sba_arc>& out = arcs_[q];
+	    for (unsigned i = 0; i < out.size(); ++i)
+	      if (accepting_[q] && out[i].dst == q && out[i].cond == bddtrue)
+		universal_[q] = true;
+	  }
+      }
+
+      ~inclusion_search()
+      {
+	for (unsigned i = 0; i < a_states_.size(); ++i)
+	  a_states_[i]->destroy();
+	for (unsigned i = 0; i < c_letters_.size(); ++i)
+	  delete c_letters_[i];
+      }
+
+      tgba_run*
+      run()
+      {
+	unsigned a0 = a_number(a_->get_init_state());
+	ranking c0(n_, -1);
+	c0[0] = 2 * max_rank(0);
+	unsigned p0 = p_number(a0, c_number(c0));
+	push(p0, bddfalse, false);
+
+	while (!todo_.empty())
+	  {
+	    frame& f = todo_.back();
+	    edge e;
+	    if (!next(f, e))
+	      {
+		unsigned p = f.p;
+		todo_.pop_back();
+		if (roots_.back().h == h_[p])
+		  pop_scc();
+		continue;
+	      }
+	    edges_[f.p].push_back(e);
+	    int hd = h_[e.dst];
+	    if (hd < 0)
+	      {
+		push(e.dst, e.acc, e.c_acc);
+		continue;
+	      }
+	    if (hd == 0)
+	      continue;
+	    // A cycle: merge the SCCs it goes through.
+	    bdd acc = e.acc;
+	    bool c_acc = e.c_acc;
+	    while (roots_.back().h > hd)
+	      {
+		acc |= roots_.back().acc | roots_.back().in_acc;
+		c_acc |= roots_.back().c_acc | roots_.back().in_c_acc;
+		roots_.pop_back();
+	      }
+	    root& r = roots_.back();
+	    r.acc |= acc;
+	    r.c_acc |= c_acc;
+	    if (r.acc == all_acc_ && r.c_acc)
+	      return counterexample(p0, r.h);
+	  }
+	return 0;
+      }
+
+    private:
+      struct root
+      {
+	int h;
+	bdd acc;
+	bool c_acc;
+	bdd in_acc;
+	bool in_c_acc;
+      };
+
+      void
+      explore_b(const tgba* b)
+      {
+	tgba_sba_proxy sba(b);
+	typedef Sgi::hash_map<const state*, unsigned,
+			      state_ptr_hash, state_ptr_equal> seen_map;
+	seen_map seen;
+	std::deque<const state*> todo;
+	const state* init = sba.get_init_state();
+	seen[init] = 0;
+	todo.push_back(init);
+	accepting_.push_back(sba.state_is_accepting(init));
+	arcs_.resize(1);
+	while (!todo.empty())
+	  {
+	    const state* s = todo.front();
+	    todo.pop_front();
+	    unsigned sn = seen[s];
+	    tgba_succ_iterator* i = sba.succ_iter(s);
+	    for (i->first(); !i->done(); i->next())
+	      {
+		const state* d = i->current_state();
+		std::pair<seen_map::iterator, bool> r =
+		  seen.insert(std::make_pair(d, arcs_.size()));
+		if (r.second)
+		  {
+		    todo.push_back(d);
+		    accepting_.push_back(sba.state_is_accepting(d));
+		    arcs_.resize(arcs_.size() + 1);
+		  }
+		else
+		  {
+		    d->destroy();
+		  }
+		sba_arc arc = { i->current_condition(), r.first->second };
+		arcs_[sn].push_back(arc);
+	      }
+	    delete i;
+	  }
+	for (seen_map::iterator i = seen.begin(); i != seen.end();)
+	  {
+	    const state* s = i->first;
+	    seen.erase(i++);
+	    s->destroy();
+	  }
+	n_ = arcs_.size();
+      }
+
+      unsigned
+      a_number(const state* s)
+      {
+	std::pair<a_map::iterator, bool> r =
+	  a_map_.insert(std::make_pair(s, a_states_.size()));
+	if (r.second)
+	  {
+	    a_states_.push_back(s);
+	    dead_.resize(dead_.size() + 1);
+	  }
+	else
+	  {
+	    s->destroy();
+	  }
+	return r.first->second;
+      }
+
+      unsigned
+      c_number(const ranking& r)
+      {
+	std::pair<c_map::iterator, bool> i =
+	  c_map_.insert(std::make_pair(r, c_states_.size()));
+	if (i.second)
+	  {
+	    c_states_.push_back(&i.first->first);
+	    c_letters_.push_back(0);
+	  }
+	return i.first->second;
+      }
+
+      unsigned
+      p_number(unsigned a, unsigned c)
+      {
+	std::pair<p_map::iterator, bool> i =
+	  p_map_.insert(std::make_pair(std::make_pair(a, c), p_a_.size()));
+	if (i.second)
+	  {
+	    p_a_.push_back(a);
+	    p_c_.push_back(c);
+	    h_.push_back(-1);
+	    edges_.resize(edges_.size() + 1);
+	  }
+	return i.first->second;
+      }
+
+      // Whether the product of A's state A with the ranking R is
+      // known to have no accepting run.
+      bool
+      subsumed(unsigned a, const ranking& r) const
+      {
+	return subsumer(a, r);
+      }
+
+      // A dead ranking of A's state A that subsumes R, or 0.
+      const ranking*
+      subsumer(unsigned a, const ranking& r) const
+      {
+	const std::vector<unsigned>& d = dead_[a];
+	for (unsigned i = 0; i < d.size(); ++i)
+	  if (subsumes(*c_states_[d[i]], r))
+	    return c_states_[d[i]];
+	return 0;
+      }
+
+      void
+      add_dead(unsigned a, unsigned c)
+      {
+	std::vector<unsigned>& d = dead_[a];
+	const ranking& r = *c_states_[c];
+	if (subsumed(a, r))
+	  return;
+	unsigned j = 0;
+	for (unsigned i = 0; i < d.size(); ++i)
+	  if (!subsumes(r, *c_states_[d[i]]))
+	    d[j++] = d[i];
+	d.resize(j);
+	d.push_back(c);
+      }
+
+      // Split the alphabet according to the arcs leaving the states
+      // ranked by F.
+      void
+      split_alphabet(const ranking& f, std::vector<bdd>& parts) const
+      {
+	parts.assign(1, bddtrue);
+	for (unsigned q = 0; q < n_; ++q)
+	  {
+	    if (f[q] < 0)
+	      continue;
+	    const std::vector<sba_arc>& out = arcs_[q];
+	    for (unsigned i = 0; i < out.size(); ++i)
+	      {
+		std::vector<bdd> split;
+		for (unsigned j = 0; j < parts.size(); ++j)
+		  {
+		    bdd in = parts[j] & out[i].cond;
+		    bdd notin = parts[j] - out[i].cond;
+		    if (in != bddfalse)
+		      split.push_back(in);
+		    if (notin != bddfalse)
+		      split.push_back(notin);
+		  }
+		parts.swap(split);
+	      }
+	  }
+      }
+
+      // The highest rank needed by a state Q of B.
+      int
+      max_rank(unsigned q)
+      {
+	if (max_rank_[q] < 0)
+	  max_rank_[q] = 2 * max_width(q);
+	return max_rank_[q];
+      }
+
+      // The largest subset of states of B reachable from {Q0} by the
+      // subset construction.  This bounds the width of the run DAGs
+      // of B rooted at Q0, and twice this width bounds the ranks
+      // needed in such a DAG to reject a word.  The construction
+      // stops early if a subset contains all the states reachable
+      // from Q0.
+      unsigned
+      max_width(unsigned q0) const
+      {
+	unsigned reachable = reachable_count(q0);
+	typedef Sgi::hash_set<ranking, ranking_hash> subset_set;
+	subset_set seen;
+	std::deque<const ranking*> todo;
+	ranking s0(n_, -1);
+	s0[q0] = 0;
+	todo.push_back(&*seen.insert(s0).first);
+	unsigned width = 1;
+	std::vector<bdd> parts;
+	while (!todo.empty() && width < reachable)
+	  {
+	    const ranking& s = *todo.front();
+	    todo.pop_front();
+	    split_alphabet(s, parts);
+	    for (unsigned j = 0; j < parts.size(); ++j)
+	      {
+		ranking d(n_, -1);
+		unsigned size = 0;
+		for (unsigned q = 0; q < n_; ++q)
+		  {
+		    if (s[q] < 0)
+		      continue;
+		    const std::vector<sba_arc>& out = arcs_[q];
+		    for (unsigned i = 0; i < out.size(); ++i)
+		      if (d[out[i].dst] < 0
+			  && (out[i].cond & parts[j]) != bddfalse)
+			{
+			  d[out[i].dst] = 0;
+			  ++size;
+			}
+		  }
+		std::pair<subset_set::iterator, bool> r = seen.insert(d);
+		if (r.second)
+		  {
+		    todo.push_back(&*r.first);
+		    if (size > width)
+		      width = size;
+		  }
+	      }
+	  }
+	return width;
+      }
+
+      // The number of states of B reachable from Q0.
+      unsigned
+      reachable_count(unsigned q0) const
+      {
+	std::vector<bool> seen(n_, false);
+	std::vector<unsigned> todo;
+	seen[q0] = true;
+	todo.push_back(q0);
+	unsigned count = 1;
+	while (!todo.empty())
+	  {
+	    const std::vector<sba_arc>& out = arcs_[todo.back()];
+	    todo.pop_back();
+	    for (unsigned i = 0; i < out.size(); ++i)
+	      if (!seen[out[i].dst])
+		{
+		  seen[out[i].dst] = true;
+		  todo.push_back(out[i].dst);
+		  ++count;
+		}
+	  }
+	return count;
+      }
+
+      // Compute the highest successor ranking of C for each part of
+      // the alphabet on which its successors are the same.
+      const letters&
+      c_letters(unsigned c)
+      {
+	if (c_letters_[c])
+	  return *c_letters_[c];
+	const ranking& f = *c_states_[c];
+	bool reset = true;
+	for (unsigned q = 0; q < n_; ++q)
+	  if (f[q] >= 0 && awaited(f[q]))
+	    reset = false;
+	std::vector<bdd> parts;
+	split_alphabet(f, parts);
+	letters* res = new letters(parts.size());
+	for (unsigned j = 0; j < parts.size(); ++j)
+	  {
+	    letter& l = (*res)[j];
+	    l.cond = parts[j];
+	    l.top.resize(n_, -1);
+	    for (unsigned q = 0; q < n_; ++q)
+	      {
+		if (f[q] < 0)
+		  continue;
+		int rq = rank_of(f[q]);
+		bool from_o = reset || awaited(f[q]);
+		const std::vector<sba_arc>& out = arcs_[q];
+		for (unsigned i = 0; i < out.size(); ++i)
+		  {
+		    if ((out[i].cond & parts[j]) == bddfalse)
+		      continue;
+		    int& t = l.top[out[i].dst];
+		    int r = (t < 0 || rq < rank_of(t)) ? rq : rank_of(t);
+		    bool o = (t >= 0 && awaited(t)) || from_o;
+		    t = 2 * r + o;
+		  }
+	      }
+	    // Accepting states of the SBA may only have even ranks.
+	    for (unsigned q = 0; q < n_; ++q)
+	      {
+		int& t = l.top[q];
+		if (t < 0)
+		  continue;
+		// Nothing can be rejected after this letter.
+		if (universal_[q])
+		  {
+		    l.cond = bddfalse;
+		    break;
+		  }
+		if (rank_of(t) > max_rank(q))
+		  t = 2 * max_rank(q) + awaited(t);
+		if (accepting_[q] && (rank_of(t) & 1))
+		  t -= 2;
+	      }
+	  }
+	c_letters_[c] = res;
+	return *res;
+      }
+
+      void
+      push(unsigned p, bdd in_acc, bool in_c_acc)
+      {
+	h_[p] = ++num_;
+	live_.push_back(p);
+	root r = { num_, bddfalse, false, in_acc, in_c_acc };
+	roots_.push_back(r);
+
+	todo_.push_back(frame());
+	frame& f = todo_.back();
+	f.p = p;
+	f.gi = 0;
+	f.odd_tried = false;
+	unsigned c = p_c_[p];
+	const letters& ls = c_letters(c);
+	tgba_succ_iterator* i = a_->succ_iter(a_states_[p_a_[p]]);
+	for (i->first(); !i->done(); i->next())
+	  {
+	    bdd cond = i->current_condition();
+	    bdd acc = i->current_acceptance_conditions();
+	    unsigned a_dst = -1U;
+	    for (unsigned j = 0; j < ls.size(); ++j)
+	      {
+		bdd label = ls[j].cond & cond;
+		if (label == bddfalse)
+		  continue;
+		if (a_dst == -1U)
+		  a_dst = a_number(i->current_state());
+		group g = { a_dst, label, acc, &ls[j].top };
+		f.groups.push_back(g);
+	      }
+	  }
+	delete i;
+      }
+
+      // Set the ranks of the current group to their maximum.
+      void
+      odo_start(frame& f)
+      {
+	const ranking& top = *f.groups[f.gi].top;
+	f.odo.resize(n_);
+	for (unsigned q = 0; q < n_; ++q)
+	  f.odo[q] = top[q] < 0 ? -1 : rank_of(top[q]);
+      }
+
+      // Move to the next lower ranking that differs from the current
+      // one before position END, and return false after the last.
+      bool
+      odo_next(frame& f, unsigned end)
+      {
+	const ranking& top = *f.groups[f.gi].top;
+	for (unsigned q = end; q < n_; ++q)
+	  if (top[q] >= 0)
+	    f.odo[q] = rank_of(top[q]);
+	for (unsigned q = end; q > 0;)
+	  {
+	    --q;
+	    if (top[q] < 0)
+	      continue;
+	    int step = accepting_[q] ? 2 : 1;
+	    if (f.odo[q] >= step)
+	      {
+		f.odo[q] -= step;
+		return true;
+	      }
+	    f.odo[q] = rank_of(top[q]);
+	  }
+	return false;
+      }
+
+      // Produce the next successor of the state in F that is not
+      // known to be dead.
+      bool
+      next(frame& f, edge& e)
+      {
+	bool reset = true;
+	{
+	  const ranking& src = *c_states_[p_c_[f.p]];
+	  for (unsigned q = 0; q < n_ && reset; ++q)
+	    if (src[q] >= 0 && awaited(src[q]))
+	      reset = false;
+	}
+	ranking r(n_);
+	while (f.gi < f.groups.size())
+	  {
+	    const group& g = f.groups[f.gi];
+	    const ranking& top = *g.top;
+	    if (f.odo.empty() && !f.odd_tried)
+	      {
+		// Try first the successor where the states that may have
+		// an odd rank get the highest one.  The breakpoint
+		// empties sooner from there, so counterexamples are
+		// found quickly.
+		f.odd_tried = true;
+		bool lower = false;
+		for (unsigned q = 0; q < n_; ++q)
+		  {
+		    if (top[q] < 0)
+		      {
+			r[q] = -1;
+			continue;
+		      }
+		    int k = rank_of(top[q]);
+		    if (!accepting_[q] && k > 0 && !(k & 1))
+		      {
+			--k;
+			lower = true;
+		      }
+		    r[q] = 2 * k + (!(k & 1) && awaited(top[q]));
+		  }
+		if (lower && !subsumed(g.a_dst, r))
+		  {
+		    e.dst = p_number(g.a_dst, c_number(r));
+		    e.label = g.label;
+		    e.acc = g.acc;
+		    e.c_acc = reset;
+		    return true;
+		  }
+	      }
+	    bool first = f.odo.empty();
+	    bool more;
+	    if (first)
+	      {
+		odo_start(f);
+		f.gmax = -1U;
+		more = true;
+	      }
+	    else
+	      {
+		// All the rankings of the group are below its maximum:
+		// stop if it is dead.
+		more = (f.gmax == -1U || h_[f.gmax] != 0) && odo_next(f, n_);
+	      }
+	    while (more)
+	      {
+		for (unsigned q = 0; q < n_; ++q)
+		  r[q] = top[q] < 0 ? -1 :
+		    2 * f.odo[q] + (!(f.odo[q] & 1) && awaited(top[q]));
+		const ranking* d = subsumer(g.a_dst, r);
+		if (!d)
+		  break;
+		// The next rankings stay below D until a position where
+		// D is lower than the maximum is reset to that maximum.
+		// Skip them.
+		unsigned end = n_;
+		while (end > 0 && ((*d)[end - 1] < 0
+				   || rank_of((*d)[end - 1])
+				      >= rank_of(top[end - 1])))
+		  --end;
+		first = false;
+		more = end > 0 && odo_next(f, end - 1);
+	      }
+	    if (!more)
+	      {
+		++f.gi;
+		f.odo.clear();
+		f.odd_tried = false;
+		continue;
+	      }
+	    e.dst = p_number(g.a_dst, c_number(r));
+	    e.label = g.label;
+	    e.acc = g.acc;
+	    e.c_acc = reset;
+	    if (first)
+	      f.gmax = e.dst;
+	    return true;
+	  }
+	return false;
+      }
+
+      void
+      pop_scc()
+      {
+	int h = roots_.back().h;
+	roots_.pop_back();
+	while (!live_.empty() && h_[live_.back()] >= h)
+	  {
+	    unsigned p = live_.back();
+	    live_.pop_back();
+	    h_[p] = 0;
+	    add_dead(p_a_[p], p_c_[p]);
+	    std::vector<edge>().swap(edges_[p]);
+	  }
+      }
+
+      // Find a path from FROM using the stored edges between live
+      // states numbered at least MIN_H, whose last edge satisfies
+      // TARGET.  Append it to STEPS, and return its last state.
+      template <class T>
+      unsigned
+      bfs(unsigned from, int min_h, T& target, tgba_run::steps& steps)
+      {
+	typedef Sgi::hash_map<unsigned, std::pair<unsigned, unsigned> >
+	  pred_map;
+	pred_map pred;
+	std::deque<unsigned> q;
+	q.push_back(from);
+	for (;;)
+	  {
+	    assert(!q.empty());
+	    unsigned s = q.front();
+	    q.pop_front();
+	    const std::vector<edge>& out = edges_[s];
+	    for (unsigned i = 0; i < out.size(); ++i)
+	      {
+		unsigned d = out[i].dst;
+		if (h_[d] < min_h)
+		  continue;
+		if (target(out[i]))
+		  {
+		    std::vector<std::pair<unsigned, unsigned> > path;
+		    path.push_back(std::make_pair(s, i));
+		    while (s != from)
+		      {
+			path.push_back(pred[s]);
+			s = path.back().first;
+		      }
+		    while (!path.empty())
+		      {
+			const edge& e = edges_[path.back().first]
+			  [path.back().second];
+			tgba_run::step st = {
+			  a_states_[p_a_[path.back().first]]->clone(),
+			  e.label, e.acc
+			};
+			steps.push_back(st);
+			target.seen(e);
+			path.pop_back();
+		      }
+		    return d;
+		  }
+		if (d != from && pred.find(d) == pred.end())
+		  {
+		    pred[d] = std::make_pair(s, i);
+		    q.push_back(d);
+		  }
+	      }
+	  }
+      }
+
+      struct reach_state
+      {
+	reach_state(const std::vector<int>& h, int min_h, unsigned goal)
+	  : h(h), min_h(min_h), goal(goal)
+	{
+	}
+
+	bool
+	operator()(const edge& e) const
+	{
+	  return goal == -1U ? h[e.dst] >= min_h : e.dst == goal;
+	}
+
+	void
+	seen(const edge&)
+	{
+	}
+
+	const std::vector<int>& h;
+	int min_h;
+	unsigned goal;
+      };
+
+      struct new_acceptance
+      {
+	new_acceptance()
+	  : acc(bddfalse), c_acc(false)
+	{
+	}
+
+	bool
+	operator()(const edge& e) const
+	{
+	  return (e.acc - acc) != bddfalse || (e.c_acc && !c_acc);
+	}
+
+	void
+	seen(const edge& e)
+	{
+	  acc |= e.acc;
+	  c_acc |= e.c_acc;
+	}
+
+	bdd acc;
+	bool c_acc;
+      };
+
+      tgba_run*
+      counterexample(unsigned p0, int scc_h)
+      {
+	tgba_run* run = new tgba_run;
+	unsigned s0 = p0;
+	if (h_[p0] < scc_h)
+	  {
+	    reach_state scc(h_, scc_h, -1U);
+	    s0 = bfs(p0, 1, scc, run->prefix);
+	  }
+	new_acceptance cov;
+	unsigned s = s0;
+	while (cov.acc != all_acc_ || !cov.c_acc)
+	  s = bfs(s, scc_h, cov, run->cycle);
+	if (s != s0)
+	  {
+	    reach_state back(h_, scc_h, s0);
+	    bfs(s, scc_h, back, run->cycle);
+	  }
+	return run;
+      }
+
+      const tgba* a_;
+      bdd all_acc_;
+
+      // The degeneralized B.
+      unsigned n_;
+      std::vector<std::vector<sba_arc> > arcs_;
+      std::vector<bool> accepting_;
+      // Bound on the ranks of each state, or -1 if not computed yet.
+      std::vector<int> max_rank_;
+      // Accepting states with a true self-loop: B accepts every
+      // suffix from them, so no ranking containing them can be
+      // accepting.
+      std::vector<bool> universal_;
+
+      // States of A, and the antichain of dead rankings of each.
+      typedef Sgi::hash_map<const state*, unsigned,
+			    state_ptr_hash, state_ptr_equal> a_map;
+      a_map a_map_;
+      std::vector<const state*> a_states_;
+      std::vector<std::vector<unsigned> > dead_;
+
+      // States of the complement of B.
+      typedef Sgi::hash_map<ranking, unsigned, ranking_hash> c_map;
+      c_map c_map_;
+      std::vector<const ranking*> c_states_;
+      std::vector<letters*> c_letters_;
+
+      // Product states: their components, their DFS number (-1 if
+      // not yet visited, 0 once dead), and the edges followed from
+      // them.
+      typedef Sgi::hash_map<std::pair<unsigned, unsigned>, unsigned,
+			    pair_hash> p_map;
+      p_map p_map_;
+      std::vector<unsigned> p_a_;
+      std::vector<unsigned> p_c_;
+      std::vector<int> h_;
+      std::vector<std::vector<edge> > edges_;
+
+      int num_;
+      std::vector<root> roots_;
+      std::vector<unsigned> live_;
+      std::deque<frame> todo_;
+    };
+  }
+
+  tgba_run*
+  check_inclusion(const tgba* a, const tgba* b)
+  {
+    inclusion_search s(a, b);
+    return s.run();
+  }
+}
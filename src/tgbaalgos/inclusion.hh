@@ -0,0 +1,78 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#ifndef SPOT_TGBAALGOS_INCLUSION_HH
+# define SPOT_TGBAALGOS_INCLUSION_HH
+
+namespace spot
+{
+  class tgba;
+  struct tgba_run;
+
+  /// \brief Check whether the language of \a a is included in that of \a b.
+  /// \ingroup tgba_misc
+  ///
+  /// This explores, on the fly, the product of \a a with a
+  /// rank-based complement of \a b.  The complement is the
+  /// construction of Kupferman and Vardi applied to a state-based
+  /// degeneralization of \a b.  It is never built explicitly.
+  ///
+  /// Giving a state of the complement higher ranks, or fewer states
+  /// of \a b to rank, can only enlarge its language.  Each product
+  /// state from which no accepting run exists is kept in an antichain
+  /// attached to its state of \a a.  Any state subsumed by an
+  /// element of this antichain is pruned without being explored.
+  /// The successors of each product state are generated from the
+  /// highest ranks down.  A dead maximal successor therefore cuts
+  /// all of its siblings at once.
+  ///
+  /// \verbatim
+  /// @Article{         kupferman.01.tocl,
+  ///   author        = {Orna Kupferman and Moshe Y. Vardi},
+  ///   title         = {Weak Alternating Automata Are Not That Weak},
+  ///   journal       = {ACM Transactions on Computational Logic},
+  ///   volume        = 2,
+  ///   number        = 3,
+  ///   pages         = {408--429},
+  ///   year          = 2001
+  /// }
+  /// @Article{         doyen.09.lmcs,
+  ///   author        = {Laurent Doyen and Jean-Fran\c{c}ois Raskin},
+  ///   title         = {Antichains for the Automata-Based Approach to
+  ///                    Model-Checking},
+  ///   journal       = {Logical Methods in Computer Science},
+  ///   volume        = 5,
+  ///   number        = 1,
+  ///   year          = 2009
+  /// }
+  /// \endverbatim
+  ///
+  /// \param a the automaton whose language should be included
+  /// \param b the automaton whose language should include that of \a a
+  /// \return 0 if the language of \a a is included in the language
+  /// of \a b.  Otherwise, an accepting run of \a a whose labels
+  /// have been restricted so that every word compatible with them is
+  /// rejected by \a b.  (Each label is therefore only included in the
+  /// condition of the corresponding transition of \a a.)  The caller
+  /// should delete the run.
+  tgba_run* check_inclusion(const tgba* a, const tgba* b);
+}
+
+#endif // SPOT_TGBAALGOS_INCLUSION_HH
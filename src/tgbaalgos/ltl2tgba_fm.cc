@@ -34,8 +34,10 @@
 #include "ltlvisit/apcollect.hh"
 #include <cassert>
 #include <memory>
+#include <vector>
 #include "ltl2tgba_fm.hh"
 #include "ltlvisit/contain.hh"
+#include "ltlvisit/reducecache.hh"
 
 namespace spot
 {
@@ -56,10 +58,7 @@ namespace spot
     public:
 
       translate_dict(bdd_dict* dict)
-	: dict(dict),
-	  a_set(bddtrue),
-	  var_set(bddtrue),
-	  next_set(bddtrue)
+	: dict(dict)
       {
       }
 
@@ -79,24 +78,16 @@ namespace spot
       fv_map next_map;	       ///< Maps "Next" variables to BDD variables
       vf_map next_formula_map; ///< Maps BDD variables to "Next" variables
 
-      bdd a_set;
-      bdd var_set;
-      bdd next_set;
-
       int
       register_proposition(const formula* f)
       {
-	int num = dict->register_proposition(f, this);
-	var_set &= bdd_ithvar(num);
-	return num;
+	return dict->register_proposition(f, this);
       }
 
       int
       register_a_variable(const formula* f)
       {
-	int num = dict->register_acceptance_variable(f, this);
-	a_set &= bdd_ithvar(num);
-	return num;
+	return dict->register_acceptance_variable(f, this);
       }
 
       int
@@ -116,7 +107,6 @@ namespace spot
 	    next_map[f] = num;
 	    next_formula_map[num] = f;
 	  }
-	next_set &= bdd_ithvar(num);
 	return num;
       }
 
@@ -153,6 +143,44 @@ namespace spot
 	return 0;
       }
 
+      // Split the conjunction of literals CUBE into its literals on
+      // atomic propositions, on promises, and on "Next" variables.
+      //
+      // We used to quantify CUBE over the sets of all variables of
+      // each kind, but BuDDy walks the whole variable set on each
+      // quantification, and these sets only grow when the dictionary
+      // is shared by many translations (see fm_translator).  The
+      // cost of this walk depends only on the size of CUBE.
+      void
+      split_cube(bdd cube, bdd& props, bdd& proms, bdd& nexts) const
+      {
+	props = proms = nexts = bddtrue;
+	while (cube != bddtrue)
+	  {
+	    assert(cube != bddfalse);
+	    int var = bdd_var(cube);
+	    bdd lit;
+	    bdd high = bdd_high(cube);
+	    if (high == bddfalse)
+	      {
+		lit = bdd_nithvar(var);
+		cube = bdd_low(cube);
+	      }
+	    else
+	      {
+		lit = bdd_ithvar(var);
+		cube = high;
+	      }
+	    if (next_formula_map.find(var) != next_formula_map.end())
+	      nexts &= lit;
+	    else if (dict->acc_formula_map.find(var)
+		     != dict->acc_formula_map.end())
+	      proms &= lit;
+	    else
+	      props &= lit;
+	  }
+      }
+
       formula*
       conj_bdd_to_formula(bdd b)
       {
@@ -649,6 +677,13 @@ namespace spot
 	return f;
       }
 
+      /// Number of formulae whose successors are known.
+      unsigned
+      size() const
+      {
+	return f2b_.size();
+      }
+
     private:
       ltl_trad_visitor v_;
       // Map each formula to its associated bdd.  This speed things up when
@@ -668,6 +703,109 @@ namespace spot
       bdd all_promises_;
     };
 
+    // Enumerate the outgoing arcs of a state by walking the BDD of
+    // its successors once, as an alternative to minato_isop.
+    //
+    // Each path from the root of the BDD to bddtrue gives one arc:
+    // the literals on atomic propositions and promises form the
+    // label, and the positive "Next" variables form the destination.
+    // Because "Next" and promise variables only occur positively in
+    // the formulae we translate, the BDD is monotonic in these
+    // variables: for such a variable v we have f = low | (v & high),
+    // and low implies high.  A path can therefore ignore v when it
+    // goes through the low branch, and the high branch only needs
+    // to cover high - low (otherwise we would output each arc of the
+    // low branch a second time, with v added).  This may produce
+    // more arcs than the prime implicants would, but arcs with the
+    // same destination are merged afterwards anyway.
+    //
+    // Results are memorized for each BDD node, and shared by all
+    // the states of the automaton.
+    class successor_walker
+    {
+    public:
+      // An arc is a pair (label, destination).
+      typedef std::pair<bdd, bdd> arc;
+      typedef std::vector<arc> arc_list;
+
+      successor_walker(const translate_dict& d)
+	: d_(d)
+      {
+      }
+
+      const arc_list&
+      arcs(bdd f)
+      {
+	memo_map::iterator i = memo_.find(f.id());
+	if (i != memo_.end())
+	  return i->second.arcs;
+
+	entry& e = memo_[f.id()];
+	// Keep a reference on the node, so that its number is
+	// not reused while we remember it.
+	e.node = f;
+	if (f == bddtrue)
+	  {
+	    e.arcs.push_back(arc(bddtrue, bddtrue));
+	    return e.arcs;
+	  }
+	if (f == bddfalse)
+	  return e.arcs;
+
+	int var = bdd_var(f);
+	bdd pos = bdd_ithvar(var);
+	bool is_next =
+	  d_.next_formula_map.find(var) != d_.next_formula_map.end();
+	bool is_acc = !is_next && (d_.dict->acc_formula_map.find(var)
+				   != d_.dict->acc_formula_map.end());
+	bdd flow = bdd_low(f);
+	bdd fhigh = bdd_high(f);
+	if (is_next || is_acc)
+	  fhigh -= flow;
+	// Hash-map elements are not moved on insertion, so we can
+	// hold references to LOW and HIGH while recursing.
+	const arc_list& low = arcs(flow);
+	const arc_list& high = arcs(fhigh);
+	e.arcs.reserve(low.size() + high.size());
+
+	if (is_next)
+	  {
+	    e.arcs.insert(e.arcs.end(), low.begin(), low.end());
+	    for (arc_list::const_iterator j = high.begin();
+		 j != high.end(); ++j)
+	      e.arcs.push_back(arc(j->first, j->second & pos));
+	  }
+	else if (is_acc)
+	  {
+	    e.arcs.insert(e.arcs.end(), low.begin(), low.end());
+	    for (arc_list::const_iterator j = high.begin();
+		 j != high.end(); ++j)
+	      e.arcs.push_back(arc(j->first & pos, j->second));
+	  }
+	else
+	  {
+	    bdd neg = bdd_nithvar(var);
+	    for (arc_list::const_iterator j = low.begin();
+		 j != low.end(); ++j)
+	      e.arcs.push_back(arc(j->first & neg, j->second));
+	    for (arc_list::const_iterator j = high.begin();
+		 j != high.end(); ++j)
+	      e.arcs.push_back(arc(j->first & pos, j->second));
+	  }
+	return e.arcs;
+      }
+
+    private:
+      struct entry
+      {
+	bdd node;
+	arc_list arcs;
+      };
+      typedef Sgi::hash_map<int, entry> memo_map;
+      memo_map memo_;
+      const translate_dict& d_;
+    };
+
   }
 
   typedef std::map<bdd, bdd, bdd_less_than> prom_map;
@@ -676,8 +814,11 @@ namespace spot
   static void
   fill_dests(translate_dict& d, dest_map& dests, bdd label, const formula* dest)
   {
-    bdd conds = bdd_existcomp(label, d.var_set);
-    bdd promises = bdd_existcomp(label, d.a_set);
+    bdd conds;
+    bdd promises;
+    bdd nexts;
+    d.split_cube(label, conds, promises, nexts);
+    assert(nexts == bddtrue);
 
     dest_map::iterator i = dests.find(dest);
     if (i == dests.end())
@@ -692,12 +833,62 @@ namespace spot
   }
 
 
+  // The state kept by fm_translator from one formula to the next.
+  struct fm_translator::shared_state
+  {
+    shared_state(bdd_dict* dict)
+      : d(dict), fc(d, false, bddtrue), walker(d)
+    {
+    }
+
+    translate_dict d;
+    // Unused when fair_loop_approx is set, because the successors
+    // then depend on the promises of the translated formula.
+    formula_canonizer fc;
+    successor_walker walker;
+    reduce_cache rc;
+  };
+
+  fm_translator::fm_translator(bdd_dict* dict,
+			       bool exprop, bool symb_merge,
+			       bool branching_postponement,
+			       bool fair_loop_approx,
+			       const atomic_prop_set* unobs,
+			       int reduce_ltl, bool bdd_walk)
+    : dict_(dict), exprop_(exprop), symb_merge_(symb_merge),
+      branching_postponement_(branching_postponement),
+      fair_loop_approx_(fair_loop_approx), unobs_(unobs),
+      reduce_ltl_(reduce_ltl), bdd_walk_(bdd_walk), s_(0)
+  {
+  }
+
+  fm_translator::~fm_translator()
+  {
+    delete s_;
+  }
+
+  void
+  fm_translator::clear()
+  {
+    delete s_;
+    s_ = 0;
+  }
+
+  unsigned
+  fm_translator::cached_formulae() const
+  {
+    return s_ ? s_->fc.size() : 0;
+  }
+
   tgba_explicit*
-  ltl_to_tgba_fm(const formula* f, bdd_dict* dict,
-		 bool exprop, bool symb_merge, bool branching_postponement,
-		 bool fair_loop_approx, const atomic_prop_set* unobs,
-		 int reduce_ltl)
+  fm_translator::translate(const formula* f)
   {
+    if (!s_)
+      s_ = new shared_state(dict_);
+    translate_dict& d = s_->d;
+    successor_walker& walker = s_->walker;
+    reduce_cache* rc = &s_->rc;
+
     // Normalize the formula.  We want all the negations on
     // the atomic propositions.  We also suppress logic
     // abbreviations such as <=>, =>, or XOR, since they
@@ -707,9 +898,9 @@ namespace spot
     f1->destroy();
 
     // Simplify the formula, if requested.
-    if (reduce_ltl)
+    if (reduce_ltl_)
       {
-	formula* tmp = reduce(f2, reduce_ltl);
+	formula* tmp = reduce(f2, reduce_ltl_, rc);
 	f2->destroy();
 	f2 = tmp;
       }
@@ -717,19 +908,23 @@ namespace spot
     typedef std::set<const formula*, formula_ptr_less_than> set_type;
     set_type formulae_to_translate;
 
-    translate_dict d(dict);
-
     // Compute the set of all promises that can possibly occurre
     // inside the formula.
     bdd all_promises = bddtrue;
-    if (fair_loop_approx || unobs)
+    if (fair_loop_approx_ || unobs_)
       {
 	ltl_promise_visitor pv(d);
 	f2->accept(pv);
 	all_promises = pv.result();
       }
 
-    formula_canonizer fc(d, fair_loop_approx, all_promises);
+    // The fair-loop approximation makes the successors of a
+    // formula depend on ALL_PROMISES, so they cannot be shared with
+    // other translations.
+    std::auto_ptr<formula_canonizer> local_fc;
+    if (fair_loop_approx_)
+      local_fc.reset(new formula_canonizer(d, true, all_promises));
+    formula_canonizer& fc = local_fc.get() ? *local_fc : s_->fc;
 
     // These are used when atomic propositions are interpreted as
     // events.  There are two kinds of events: observable events are
@@ -738,7 +933,7 @@ namespace spot
     // other.
     bdd observable_events = bddfalse;
     bdd unobservable_events = bddfalse;
-    if (unobs)
+    if (unobs_)
       {
 	bdd neg_events = bddtrue;
 	std::auto_ptr<atomic_prop_set> aps(atomic_prop_collect(f));
@@ -751,8 +946,8 @@ namespace spot
 	    observable_events = (observable_events & neg) | (neg_events & pos);
 	    neg_events &= neg;
 	  }
-	for (atomic_prop_set::const_iterator i = unobs->begin();
-	     i != unobs->end(); ++i)
+	for (atomic_prop_set::const_iterator i = unobs_->begin();
+	     i != unobs_->end(); ++i)
 	  {
 	    int p = d.register_proposition(*i);
 	    bdd pos = bdd_ithvar(p);
@@ -765,8 +960,7 @@ namespace spot
       }
     bdd all_events = observable_events | unobservable_events;
 
-
-    tgba_explicit_formula* a = new tgba_explicit_formula(dict);
+    tgba_explicit_formula* a = new tgba_explicit_formula(dict_);
 
     formulae_to_translate.insert(f2);
     a->set_init_state(f2);
@@ -781,7 +975,7 @@ namespace spot
 	bdd res = fc.translate(now);
 
 	// Handle exclusive events.
-	if (unobs)
+	if (unobs_)
 	  {
 	    res &= observable_events;
 	    int n = d.register_next_variable(now);
@@ -825,16 +1019,25 @@ namespace spot
 	// representation of the successors for all combinations of
 	// the atomic properties involved in the formula.
 	// VAR_SET is the set of these properties.
-	bdd var_set = bdd_existcomp(bdd_support(res), d.var_set);
+	bdd var_set;
+	bdd other_vars;
+	{
+	  bdd proms;
+	  bdd nexts;
+	  d.split_cube(bdd_support(res), var_set, proms, nexts);
+	  other_vars = proms & nexts;
+	}
 	// ALL_PROPS is the combinations we have yet to consider.
 	// We used to start with `all_props = bddtrue', but it is
 	// more efficient to start with the set of all satisfiable
 	// variables combinations.
-	bdd all_props = bdd_existcomp(res, d.var_set);
+	bdd all_props = res;
+	if (other_vars != bddtrue)
+	  all_props = bdd_exist(res, other_vars);
 	while (all_props != bddfalse)
 	  {
 	    bdd one_prop_set = bddtrue;
-	    if (exprop)
+	    if (exprop_)
 	      one_prop_set = bdd_satoneset(all_props, var_set, bddtrue);
 	    all_props -= one_prop_set;
 
@@ -848,25 +1051,41 @@ namespace spot
 	    // We never added negations in front of these variables when
 	    // we built the BDD, so prime implicants will not "invent" them.
 	    //
-	    // FIXME: minato_isop is quite expensive, and I (=adl)
-	    // don't think we really care that much about getting the
-	    // smalled sum of products that minato_isop strives to
-	    // compute.  Given that Next and Acc variables should
-	    // always be positive, maybe there is a faster way to
-	    // compute the successors?  E.g. using bdd_satone() and
-	    // ignoring negated Next and Acc variables.
-	    minato_isop isop(res & one_prop_set);
-	    bdd cube;
-	    while ((cube = isop.next()) != bddfalse)
+	    // minato_isop is quite expensive, and we do not really
+	    // care about getting the smallest sum of products that it
+	    // strives to compute.  With BDD_WALK, the successors are
+	    // instead read off the paths of the BDD, ignoring negated
+	    // Next and Acc variables (see successor_walker).
+	    successor_walker::arc_list isop_arcs;
+	    const successor_walker::arc_list* arcs = &isop_arcs;
+	    if (bdd_walk_)
+	      {
+		arcs = &walker.arcs(res & one_prop_set);
+	      }
+	    else
+	      {
+		minato_isop isop(res & one_prop_set);
+		bdd cube;
+		while ((cube = isop.next()) != bddfalse)
+		  {
+		    bdd props;
+		    bdd proms;
+		    bdd nexts;
+		    d.split_cube(cube, props, proms, nexts);
+		    isop_arcs.push_back(successor_walker::arc(props & proms,
+							      nexts));
+		  }
+	      }
+	    for (successor_walker::arc_list::const_iterator ai = arcs->begin();
+		 ai != arcs->end(); ++ai)
 	      {
-		bdd label = bdd_exist(cube, d.next_set);
-		bdd dest_bdd = bdd_existcomp(cube, d.next_set);
-		const formula* dest = d.conj_bdd_to_formula(dest_bdd);
+		bdd label = ai->first;
+		const formula* dest = d.conj_bdd_to_formula(ai->second);
 
 		// Simplify the formula, if requested.
-		if (reduce_ltl)
+		if (reduce_ltl_)
 		  {
-		    formula* tmp = reduce(dest, reduce_ltl);
+		    formula* tmp = reduce(dest, reduce_ltl_, rc);
 		    dest->destroy();
 		    dest = tmp;
 		    // Ignore the arc if the destination reduces to false.
@@ -876,7 +1095,7 @@ namespace spot
 
 		// If we already know a state with the same
 		// successors, use it in lieu of the current one.
-		if (symb_merge)
+		if (symb_merge_)
 		  dest = fc.canonize(dest);
 
 		// If we are not postponing the branching, we can
@@ -884,7 +1103,7 @@ namespace spot
 		// Otherwise, we merge transitions with identical
 		// label, and declare the outgoing transitions in a
 		// second loop.
-		if (!branching_postponement)
+		if (!branching_postponement_)
 		  {
 		    fill_dests(d, dests, label, dest);
 		  }
@@ -900,7 +1119,7 @@ namespace spot
 					 const_cast<formula*>(dest));
 		  }
 	      }
-	    if (branching_postponement)
+	    if (branching_postponement_)
 	      for (succ_map::const_iterator si = succs.begin();
 		   si != succs.end(); ++si)
 		fill_dests(d, dests, si->first, si->second);
@@ -931,7 +1150,7 @@ namespace spot
 	    // When translating LTL for an event-based logic with
 	    // unobservable events, the 1 state should accept all events,
 	    // even unobservable events.
-	    if (unobs && now == constant::true_instance())
+	    if (unobs_ && now == constant::true_instance())
 	      cond_for_true = all_events;
 	    else
 	      {
@@ -940,7 +1159,7 @@ namespace spot
 		prom_map::const_iterator j = i->second.begin();
 		// ... and it is not expected to make any promises (unless
 		// fair loop approximations are used).
-		assert(fair_loop_approx || j->first == bddtrue);
+		assert(fair_loop_approx_ || j->first == bddtrue);
 		cond_for_true = j->second;
 	      }
 	    if (!a->has_state(constant::true_instance()))
@@ -993,4 +1212,15 @@ namespace spot
     return a;
   }
 
+  tgba_explicit*
+  ltl_to_tgba_fm(const formula* f, bdd_dict* dict,
+		 bool exprop, bool symb_merge, bool branching_postponement,
+		 bool fair_loop_approx, const atomic_prop_set* unobs,
+		 int reduce_ltl, bool bdd_walk)
+  {
+    fm_translator t(dict, exprop, symb_merge, branching_postponement,
+		    fair_loop_approx, unobs, reduce_ltl, bdd_walk);
+    return t.translate(f);
+  }
+
 }
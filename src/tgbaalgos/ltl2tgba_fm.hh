@@ -121,13 +121,88 @@ namespace spot
   /// }
   /// \endverbatim
   ///
+  /// \param bdd_walk When set, the transitions leaving each state are
+  /// enumerated by walking the BDD of its successors once (the
+  /// results for each BDD node are shared by all states), instead of
+  /// computing the prime implicants of this BDD with minato_isop.
+  /// This is usually faster, but may produce more transitions with
+  /// the same destination before they are merged.
+  ///
   /// \return A spot::tgba_explicit that recognizes the language of \a f.
   tgba_explicit* ltl_to_tgba_fm(const ltl::formula* f, bdd_dict* dict,
 				bool exprop = false, bool symb_merge = true,
 				bool branching_postponement = false,
 				bool fair_loop_approx = false,
 				const ltl::atomic_prop_set* unobs = 0,
-				int reduce_ltl = ltl::Reduce_None);
+				int reduce_ltl = ltl::Reduce_None,
+				bool bdd_walk = false);
+
+  /// \brief Translate several LTL formulae with the same options as
+  /// ltl_to_tgba_fm(), sharing the translation state between them.
+  /// \ingroup tgba_ltl
+  ///
+  /// Each call to ltl_to_tgba_fm() starts from scratch: the BDD
+  /// variables of the \c X subformulae, the successors of each state
+  /// formula, and the reductions of these formulae are computed again
+  /// for every translated formula.  An fm_translator keeps them from
+  /// one call of translate() to the next, so that the subformulae
+  /// shared by related formulae are translated only once.  This state
+  /// is not shared when \a fair_loop_approx is set, because the
+  /// successors then depend on the promises of the whole formula.
+  ///
+  /// Whether this pays off depends on the formulae: the order of the
+  /// BDD variables is inherited from earlier translations, and can be
+  /// worse than the order a fresh translation would use.  Calling
+  /// clear() between unrelated formulae avoids that.
+  ///
+  /// Because states with equivalent successors are merged across
+  /// formulae, the states of an automaton may be labeled by formulae
+  /// seen in earlier translations.  The languages are unaffected.
+  ///
+  /// All automata share the \a dict given to the constructor, and
+  /// should be deleted before it.  The other parameters are those
+  /// of ltl_to_tgba_fm().
+  class fm_translator
+  {
+  public:
+    fm_translator(bdd_dict* dict,
+		  bool exprop = false, bool symb_merge = true,
+		  bool branching_postponement = false,
+		  bool fair_loop_approx = false,
+		  const ltl::atomic_prop_set* unobs = 0,
+		  int reduce_ltl = ltl::Reduce_None,
+		  bool bdd_walk = false);
+    ~fm_translator();
+
+    /// Translate \a f into a new automaton.
+    tgba_explicit* translate(const ltl::formula* f);
+
+    /// \brief Forget everything learned from previous translations.
+    ///
+    /// The shared state only grows, so callers translating many
+    /// unrelated formulae may want to clear it from time to time.
+    void clear();
+
+    /// Number of state formulae whose successors are known.
+    unsigned cached_formulae() const;
+
+  private:
+    struct shared_state;
+
+    // Disallow copy.
+    fm_translator(const fm_translator&);
+    fm_translator& operator=(const fm_translator&);
+
+    bdd_dict* dict_;
+    bool exprop_;
+    bool symb_merge_;
+    bool branching_postponement_;
+    bool fair_loop_approx_;
+    const ltl::atomic_prop_set* unobs_;
+    int reduce_ltl_;
+    bool bdd_walk_;
+    shared_state* s_;
+  };
 }
 
 #endif // SPOT_TGBAALGOS_LTL2TGBA_FM_HH
@@ -32,6 +32,7 @@
 
 #include <cassert>
 #include <list>
+#include "misc/arena.hh"
 #include "misc/hash.hh"
 #include "tgba/tgba.hh"
 #include "emptiness.hh"
@@ -454,11 +455,15 @@ namespace spot
       };
 
       explicit_magic_search_heap(size_t)
+        : destroy_states(!arena_scope::current())
         {
         }
 
       ~explicit_magic_search_heap()
         {
+          // In an arena, the states are released with the arena.
+          if (!destroy_states)
+            return;
           hash_type::const_iterator s = h.begin();
           while (s != h.end())
             {
@@ -509,6 +514,7 @@ namespace spot
       typedef Sgi::hash_map<const state*, color,
                 state_ptr_hash, state_ptr_equal> hash_type;
       hash_type h;
+      bool destroy_states;
     };
 
     class bsh_magic_search_heap
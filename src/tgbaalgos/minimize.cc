@@ -28,15 +28,13 @@
 #endif
 
 #include <queue>
-#include <deque>
-#include <set>
 #include <list>
 #include <vector>
 #include <sstream>
 #include "minimize.hh"
 #include "ltlast/allnodes.hh"
 #include "misc/hash.hh"
-#include "misc/bddlt.hh"
+#include "misc/casts.hh"
 #include "tgba/tgbaproduct.hh"
 #include "tgba/tgbatba.hh"
 #include "tgba/wdbacomp.hh"
@@ -47,6 +45,7 @@
 #include "tgbaalgos/scc.hh"
 #include "tgbaalgos/ltl2tgba_fm.hh"
 #include "tgbaalgos/bfssteps.hh"
+#include "tgbaalgos/inclusion.hh"
 
 namespace spot
 {
@@ -231,6 +230,245 @@ namespace spot
     };
 
 
+    // A state of loop_product: a position on the loop, and a state
+    // of the original automaton.  The initial state has no original
+    // state.
+    class loop_state: public state
+    {
+    public:
+      loop_state(unsigned pos, const state* s)
+	: pos_(pos), s_(s)
+      {
+      }
+
+      virtual int
+      compare(const state* other) const
+      {
+	const loop_state* o = down_cast<const loop_state*>(other);
+	assert(o);
+	if (pos_ != o->pos_)
+	  return pos_ < o->pos_ ? -1 : 1;
+	if (!s_ || !o->s_)
+	  return (s_ != 0) - (o->s_ != 0);
+	return s_->compare(o->s_);
+      }
+
+      virtual size_t
+      hash() const
+      {
+	return wang32_hash(pos_) ^ (s_ ? s_->hash() : 0);
+      }
+
+      virtual loop_state*
+      clone() const
+      {
+	return new loop_state(pos_, s_ ? s_->clone() : 0);
+      }
+
+      unsigned
+      pos() const
+      {
+	return pos_;
+      }
+
+      const state*
+      orig() const
+      {
+	return s_;
+      }
+
+    protected:
+      virtual
+      ~loop_state()
+      {
+	if (s_)
+	  s_->destroy();
+      }
+
+    private:
+      unsigned pos_;
+      const state* s_;
+    };
+
+    class loop_succ_iterator: public tgba_succ_iterator
+    {
+    public:
+      // Successors of the initial state: all the STARTS.
+      loop_succ_iterator(const power_map::power_state& starts)
+	: starts_(&starts), it_(0)
+      {
+      }
+
+      // Successors of a state whose original successors are
+      // iterated by IT, while reading LABEL.
+      loop_succ_iterator(tgba_succ_iterator* it, bdd label, unsigned next)
+	: starts_(0), it_(it), label_(label), next_(next)
+      {
+      }
+
+      virtual
+      ~loop_succ_iterator()
+      {
+	delete it_;
+      }
+
+      virtual void
+      first()
+      {
+	if (starts_)
+	  {
+	    i_ = starts_->begin();
+	    return;
+	  }
+	it_->first();
+	skip_();
+      }
+
+      virtual void
+      next()
+      {
+	if (starts_)
+	  {
+	    ++i_;
+	    return;
+	  }
+	it_->next();
+	skip_();
+      }
+
+      virtual bool
+      done() const
+      {
+	return starts_ ? i_ == starts_->end() : it_->done();
+      }
+
+      virtual loop_state*
+      current_state() const
+      {
+	if (starts_)
+	  return new loop_state(0, (*i_)->clone());
+	return new loop_state(next_, it_->current_state());
+      }
+
+      virtual bdd
+      current_condition() const
+      {
+	return starts_ ? bddtrue : cond_;
+      }
+
+      virtual bdd
+      current_acceptance_conditions() const
+      {
+	return starts_ ? bddfalse : it_->current_acceptance_conditions();
+      }
+
+    private:
+      // Skip the original transitions that are incompatible with
+      // the label of the loop.
+      void
+      skip_()
+      {
+	while (!it_->done())
+	  {
+	    cond_ = label_ & it_->current_condition();
+	    if (cond_ != bddfalse)
+	      return;
+	    it_->next();
+	  }
+      }
+
+      const power_map::power_state* starts_;
+      power_map::power_state::const_iterator i_;
+      tgba_succ_iterator* it_;
+      bdd label_;
+      bdd cond_;
+      unsigned next_;
+    };
+
+    // The product between a loop (given as the sequence of its labels)
+    // and the original automaton, starting from several original
+    // states at once: the initial state leads to each of them.
+    // Checking this product for emptiness is equivalent to checking
+    // one product per starting state, but the product states that
+    // these checks have in common are explored only once.
+    class loop_product: public tgba
+    {
+    public:
+      loop_product(const std::vector<bdd>& label, const tgba* orig,
+		   const power_map::power_state& starts)
+	: label_(label), orig_(orig), starts_(starts)
+      {
+      }
+
+      virtual state*
+      get_init_state() const
+      {
+	return new loop_state(0, 0);
+      }
+
+      virtual tgba_succ_iterator*
+      succ_iter(const state* local_state,
+		const state*, const tgba*) const
+      {
+	const loop_state* s = down_cast<const loop_state*>(local_state);
+	assert(s);
+	if (!s->orig())
+	  return new loop_succ_iterator(starts_);
+	unsigned pos = s->pos();
+	return new loop_succ_iterator(orig_->succ_iter(s->orig()),
+				      label_[pos], (pos + 1) % label_.size());
+      }
+
+      virtual bdd_dict*
+      get_dict() const
+      {
+	return orig_->get_dict();
+      }
+
+      virtual std::string
+      format_state(const state* st) const
+      {
+	const loop_state* s = down_cast<const loop_state*>(st);
+	assert(s);
+	if (!s->orig())
+	  return "init";
+	std::ostringstream os;
+	os << s->pos() << ", " << orig_->format_state(s->orig());
+	return os.str();
+      }
+
+      virtual bdd
+      all_acceptance_conditions() const
+      {
+	return orig_->all_acceptance_conditions();
+      }
+
+      virtual bdd
+      neg_acceptance_conditions() const
+      {
+	return orig_->neg_acceptance_conditions();
+      }
+
+    protected:
+      virtual bdd
+      compute_support_conditions(const state*) const
+      {
+	return bddtrue;
+      }
+
+      virtual bdd
+      compute_support_variables(const state*) const
+      {
+	return bddtrue;
+      }
+
+    private:
+      const std::vector<bdd>& label_;
+      const tgba* orig_;
+      const power_map::power_state& starts_;
+    };
+
+
     bool
     wdba_scc_is_accepting(const tgba_explicit_number* det_a, unsigned scc_n,
 			  const tgba* orig_a, scc_map& sm, power_map& pm)
@@ -245,257 +483,403 @@ namespace spot
       assert(reached == start);
       (void)reached;
 
-      // Build an automaton representing this loop.
-      tgba_explicit_number loop_a(det_a->get_dict());
-      tgba_run::steps::const_iterator i;
-      int loop_size = loop.size();
-      int n;
-      for (n = 1, i = loop.begin(); n < loop_size; ++n, ++i)
+      // The labels along the loop.
+      std::vector<bdd> label;
+      label.reserve(loop.size());
+      for (tgba_run::steps::const_iterator i = loop.begin();
+	   i != loop.end(); ++i)
 	{
-	  loop_a.create_transition(n - 1, n)->condition = i->label;
+	  label.push_back(i->label);
 	  i->s->destroy();
 	}
-      assert(i != loop.end());
-      loop_a.create_transition(n - 1, 0)->condition = i->label;
-      i->s->destroy();
-      assert(++i == loop.end());
 
-      const state* loop_a_init = loop_a.get_init_state();
-      assert(loop_a.get_label(loop_a_init) == 0);
-
-      // Check if the loop is accepting in the original automaton.
-      bool accepting = false;
-
-      // Iterate on each original state corresponding to start.
+      // Check if the loop is accepting in the original automaton,
+      // starting from any of the original states corresponding to
+      // START.
       const power_map::power_state& ps = pm.states_of(det_a->get_label(start));
-      for (power_map::power_state::const_iterator it = ps.begin();
-	   it != ps.end() && !accepting; ++it)
-	{
-	  // Contrustruct a product between
-	  // LOOP_A, and ORIG_A starting in *IT.
-
-	  tgba* p = new tgba_product_init(&loop_a, orig_a,
-					  loop_a_init, *it);
-
-	  emptiness_check* ec = couvreur99(p);
-	  emptiness_check_result* res = ec->check();
-
-	  if (res)
-	    accepting = true;
-	  delete res;
-	  delete ec;
-	  delete p;
-	}
-
-      loop_a_init->destroy();
+      loop_product prod(label, orig_a, ps);
+      emptiness_check* ec = couvreur99(&prod);
+      emptiness_check_result* res = ec->check();
+      bool accepting = res != 0;
+      delete res;
+      delete ec;
       return accepting;
     }
 
   }
 
-  tgba_explicit_number* minimize_dfa(const tgba_explicit_number* det_a,
-				     hash_set* final, hash_set* non_final)
+  namespace
   {
-    typedef std::list<hash_set*> partition_t;
-    partition_t cur_run;
-    partition_t next_run;
-
-    // The list of equivalent states.
-    partition_t done;
-
-    hash_map state_set_map;
+    // A partition of the states 0..n-1, where the states of each
+    // block are stored contiguously in elems_, and can be marked in
+    // time proportional to the number of marked states.  This is the
+    // data structure used by Valmari and Lehtinen in "Efficient
+    // minimization of DFAs with partial transition functions"
+    // (STACS'08).
+    class state_partition
+    {
+    public:
+      // INIT[s] is the initial block of state s, between 0 and
+      // BLOCKS - 1.  All blocks should be non-empty.
+      state_partition(const std::vector<unsigned>& init, unsigned blocks)
+	: elems_(init.size()), loc_(init.size()), block_(init),
+	  first_(blocks + 1, 0), marked_(blocks, 0)
+      {
+	unsigned n = init.size();
+	// Counting sort of the states by block.
+	for (unsigned s = 0; s < n; ++s)
+	  ++first_[init[s] + 1];
+	for (unsigned b = 1; b <= blocks; ++b)
+	  first_[b] += first_[b - 1];
+	end_.assign(first_.begin() + 1, first_.end());
+	first_.pop_back();
+	std::vector<unsigned> pos(first_);
+	for (unsigned s = 0; s < n; ++s)
+	  {
+	    unsigned i = pos[init[s]]++;
+	    elems_[i] = s;
+	    loc_[s] = i;
+	  }
+      }
 
-    // Size of det_a
-    unsigned size = final->size() + non_final->size();
-    // Use bdd variables to number sets.  set_num is the first variable
-    // available.
-    unsigned set_num =
-      det_a->get_dict()->register_anonymous_variables(size, det_a);
+      unsigned
+      blocks() const
+      {
+	return first_.size();
+      }
 
-    std::set<int> free_var;
-    for (unsigned i = set_num; i < set_num + size; ++i)
-      free_var.insert(i);
-    std::map<int, int> used_var;
+      unsigned
+      block_of(unsigned s) const
+      {
+	return block_[s];
+      }
 
-    hash_set* final_copy;
+      unsigned
+      block_size(unsigned b) const
+      {
+	return end_[b] - first_[b];
+      }
 
-    if (!final->empty())
+      std::vector<unsigned>::const_iterator
+      begin(unsigned b) const
       {
-	unsigned s = final->size();
-	used_var[set_num] = s;
-	free_var.erase(set_num);
-	if (s > 1)
-	  cur_run.push_back(final);
-	else
-	  done.push_back(final);
-	for (hash_set::const_iterator i = final->begin();
-	     i != final->end(); ++i)
-	  state_set_map[*i] = set_num;
+	return elems_.begin() + first_[b];
+      }
 
-	final_copy = new hash_set(*final);
+      std::vector<unsigned>::const_iterator
+      end(unsigned b) const
+      {
+	return elems_.begin() + end_[b];
       }
-    else
+
+      // Mark state S by moving it to the front of its block.
+      void
+      mark(unsigned s)
       {
-	final_copy = final;
+	unsigned b = block_[s];
+	unsigned i = loc_[s];
+	unsigned j = first_[b] + marked_[b];
+	if (i < j)		// Already marked.
+	  return;
+	unsigned t = elems_[j];
+	elems_[j] = s;
+	loc_[s] = j;
+	elems_[i] = t;
+	loc_[t] = i;
+	if (marked_[b]++ == 0)
+	  touched_.push_back(b);
       }
 
-    if (!non_final->empty())
+      // Split each block with marked states into its marked and its
+      // unmarked states, and unmark everything.  The marked states
+      // go to a new block, and ON_SPLIT(OLD, NEW) is called.
+      template <class F>
+      void
+      split(F& on_split)
       {
-	unsigned s = non_final->size();
-	unsigned num = set_num + 1;
-	used_var[num] = s;
-	free_var.erase(num);
-	if (s > 1)
-	  cur_run.push_back(non_final);
-	else
-	  done.push_back(non_final);
-	for (hash_set::const_iterator i = non_final->begin();
-	     i != non_final->end(); ++i)
-	  state_set_map[*i] = num;
+	while (!touched_.empty())
+	  {
+	    unsigned b = touched_.back();
+	    touched_.pop_back();
+	    unsigned m = marked_[b];
+	    marked_[b] = 0;
+	    if (first_[b] + m == end_[b])
+	      continue;
+	    unsigned nb = first_.size();
+	    first_.push_back(first_[b]);
+	    end_.push_back(first_[b] + m);
+	    marked_.push_back(0);
+	    first_[b] += m;
+	    for (unsigned i = first_[nb]; i < end_[nb]; ++i)
+	      block_[elems_[i]] = nb;
+	    on_split(b, nb);
+	  }
       }
-    else
+
+    private:
+      std::vector<unsigned> elems_;
+      std::vector<unsigned> loc_;
+      std::vector<unsigned> block_;
+      std::vector<unsigned> first_;
+      std::vector<unsigned> end_;
+      std::vector<unsigned> marked_;
+      std::vector<unsigned> touched_;
+    };
+
+    // The set of blocks that remain to be used as splitters.
+    struct hopcroft_worklist
+    {
+      hopcroft_worklist(const state_partition& p)
+	: p(p), pending(p.blocks(), true)
       {
-	delete non_final;
+	// With a partial transition function, every initial block
+	// has to be used as a splitter.
+	for (unsigned b = 0; b < p.blocks(); ++b)
+	  todo.push_back(b);
       }
 
-    // A bdd_states_map is a list of formulae (in a BDD form) associated with a
-    // destination set of states.
-    typedef std::map<bdd, hash_set*, bdd_less_than> bdd_states_map;
+      void
+      operator()(unsigned old_block, unsigned new_block)
+      {
+	pending.push_back(false);
+	// If OLD_BLOCK is still pending, both halves must be
+	// processed.  Otherwise processing the smallest half is
+	// enough: this is what makes the algorithm O(n log n).
+	unsigned b = new_block;
+	if (!pending[old_block]
+	    && p.block_size(old_block) < p.block_size(new_block))
+	  b = old_block;
+	pending[b] = true;
+	todo.push_back(b);
+      }
 
-    bool did_split = true;
+      const state_partition& p;
+      std::vector<bool> pending;
+      std::vector<unsigned> todo;
+    };
+  }
 
-    while (did_split)
+  tgba_explicit_number* minimize_dfa(const tgba_explicit_number* det_a,
+				     hash_set* final, hash_set* non_final)
+  {
+    // Number the states densely, in breadth-first order from the
+    // initial state, so that the result does not depend on the order
+    // of the hash tables.
+    const unsigned unnumbered = -1U;
+    hash_map state_num;
+    hash_set::const_iterator hi;
+    for (hi = final->begin(); hi != final->end(); ++hi)
+      state_num[*hi] = unnumbered;
+    for (hi = non_final->begin(); hi != non_final->end(); ++hi)
+      state_num[*hi] = unnumbered;
+    std::vector<const state*> states;
+    states.reserve(state_num.size());
+    {
+      std::queue<const state*> todo;
+      const state* init = det_a->get_init_state();
+      hash_map::iterator i = state_num.find(init);
+      init->destroy();
+      if (i != state_num.end())
+	{
+	  i->second = 0;
+	  states.push_back(i->first);
+	  todo.push(i->first);
+	}
+      while (!todo.empty())
+	{
+	  const state* src = todo.front();
+	  todo.pop();
+	  tgba_succ_iterator* si = det_a->succ_iter(src);
+	  for (si->first(); !si->done(); si->next())
+	    {
+	      const state* dst = si->current_state();
+	      hash_map::iterator j = state_num.find(dst);
+	      dst->destroy();
+	      if (j != state_num.end() && j->second == unnumbered)
+		{
+		  j->second = states.size();
+		  states.push_back(j->first);
+		  todo.push(j->first);
+		}
+	    }
+	  delete si;
+	}
+      // Useful states should all be reachable through useful
+      // states, but let us not rely on it.
+      for (i = state_num.begin(); i != state_num.end(); ++i)
+	if (i->second == unnumbered)
+	  {
+	    i->second = states.size();
+	    states.push_back(i->first);
+	  }
+    }
+    unsigned n = states.size();
+
+    // Collect the transitions between the states of the partition.
+    // Transitions going outside of it are ignored: this can happen
+    // if FINAL and NON_FINAL do not cover the whole automaton
+    // (because we want to ignore some useless states).
+    std::vector<bdd> labels;
+    Sgi::hash_map<int, unsigned> label_num; // bdd id -> index in labels
+    std::vector<unsigned> arc_src;
+    std::vector<unsigned> arc_dst;
+    std::vector<unsigned> arc_label;
+    for (unsigned s = 0; s < n; ++s)
       {
-	did_split = false;
-	while (!cur_run.empty())
+	tgba_succ_iterator* si = det_a->succ_iter(states[s]);
+	for (si->first(); !si->done(); si->next())
 	  {
-	    // Get a set to process.
-	    hash_set* cur = cur_run.front();
-	    cur_run.pop_front();
-
-	    trace << "processing " << format_hash_set(cur, det_a) << std::endl;
+	    const state* dst = si->current_state();
+	    hash_map::const_iterator j = state_num.find(dst);
+	    dst->destroy();
+	    if (j == state_num.end())
+	      continue;
+	    bdd cond = si->current_condition();
+	    std::pair<Sgi::hash_map<int, unsigned>::iterator, bool> r =
+	      label_num.insert(std::make_pair(cond.id(), labels.size()));
+	    if (r.second)
+	      labels.push_back(cond);
+	    arc_src.push_back(s);
+	    arc_dst.push_back(j->second);
+	    arc_label.push_back(r.first->second);
+	  }
+	delete si;
+      }
 
-	    hash_set::iterator hi;
-	    bdd_states_map bdd_map;
-	    for (hi = cur->begin(); hi != cur->end(); ++hi)
+    // Split the labels into disjoint letters, so that each label
+    // is a union of letters.  The automaton is then a DFA over
+    // these letters.  There are usually few distinct labels.
+    std::vector<bdd> letters;
+    for (unsigned l = 0; l < labels.size(); ++l)
+      {
+	bdd rest = labels[l];
+	unsigned count = letters.size();
+	for (unsigned j = 0; j < count && rest != bddfalse; ++j)
+	  {
+	    bdd common = letters[j] & rest;
+	    if (common == bddfalse)
+	      continue;
+	    rest -= common;
+	    if (common != letters[j])
 	      {
-		const state* src = *hi;
-		bdd f = bddfalse;
-		tgba_succ_iterator* si = det_a->succ_iter(src);
-		for (si->first(); !si->done(); si->next())
-		  {
-		    const state* dst = si->current_state();
-		    hash_map::const_iterator i = state_set_map.find(dst);
-		    dst->destroy();
-		    if (i == state_set_map.end())
-		      // The destination state is not in our
-		      // partition.  This can happen if the initial
-		      // FINAL and NON_FINAL supplied to the algorithm
-		      // do not cover the whole automaton (because we
-		      // want to ignore some useless states).  Simply
-		      // ignore these states here.
-		      continue;
-		    f |= (bdd_ithvar(i->second) & si->current_condition());
-		  }
-		delete si;
-
-		// Have we already seen this formula ?
-		bdd_states_map::iterator bsi = bdd_map.find(f);
-		if (bsi == bdd_map.end())
-		  {
-		    // No, create a new set.
-		    hash_set* new_set = new hash_set;
-		    new_set->insert(src);
-		    bdd_map[f] = new_set;
-		  }
-		else
-		  {
-		    // Yes, add the current state to the set.
-		    bsi->second->insert(src);
-		  }
+		letters.push_back(letters[j] - common);
+		letters[j] = common;
 	      }
+	  }
+	if (rest != bddfalse)
+	  letters.push_back(rest);
+      }
+    std::vector<std::vector<unsigned> > letters_of(labels.size());
+    for (unsigned l = 0; l < labels.size(); ++l)
+      for (unsigned j = 0; j < letters.size(); ++j)
+	if ((letters[j] & labels[l]) != bddfalse)
+	  letters_of[l].push_back(j);
+
+    // Index the letter-transitions by destination: the predecessors
+    // of state t are pred[pred_first[t]] to pred[pred_first[t + 1] - 1],
+    // each given as a (source, letter) pair.
+    std::vector<unsigned> pred_first(n + 1, 0);
+    for (unsigned t = 0; t < arc_dst.size(); ++t)
+      pred_first[arc_dst[t] + 1] += letters_of[arc_label[t]].size();
+    for (unsigned s = 0; s < n; ++s)
+      pred_first[s + 1] += pred_first[s];
+    std::vector<std::pair<unsigned, unsigned> > pred(pred_first[n]);
+    {
+      std::vector<unsigned> pos(pred_first.begin(), pred_first.end() - 1);
+      for (unsigned t = 0; t < arc_dst.size(); ++t)
+	{
+	  const std::vector<unsigned>& ls = letters_of[arc_label[t]];
+	  for (unsigned j = 0; j < ls.size(); ++j)
+	    pred[pos[arc_dst[t]]++] = std::make_pair(arc_src[t], ls[j]);
+	}
+    }
 
-	    bdd_states_map::iterator bsi = bdd_map.begin();
-	    if (bdd_map.size() == 1)
-	      {
-		// The set was not split.
-		trace << "set " << format_hash_set(bsi->second, det_a)
-		      << " was not split" << std::endl;
-		next_run.push_back(bsi->second);
-	      }
-	    else
+    // The initial partition separates final and non-final states.
+    std::vector<unsigned> init(n, 0);
+    unsigned blocks = 0;
+    if (!final->empty())
+      ++blocks;
+    if (!non_final->empty())
+      {
+	for (unsigned s = 0; s < n; ++s)
+	  if (final->find(states[s]) == final->end())
+	    init[s] = blocks;
+	++blocks;
+      }
+    state_partition part(init, blocks);
+    hopcroft_worklist work(part);
+
+    // Refine the partition until all blocks are stable.
+    std::vector<std::vector<unsigned> > pre(letters.size());
+    std::vector<unsigned> used_letters;
+    std::vector<unsigned> splitter;
+    while (!work.todo.empty())
+      {
+	unsigned b = work.todo.back();
+	work.todo.pop_back();
+	work.pending[b] = false;
+
+	// Gather the predecessors of B, per letter.  B may be split
+	// while we process its letters, so work on a copy.
+	splitter.assign(part.begin(b), part.end(b));
+	for (unsigned i = 0; i < splitter.size(); ++i)
+	  {
+	    unsigned t = splitter[i];
+	    for (unsigned j = pred_first[t]; j < pred_first[t + 1]; ++j)
 	      {
-		for (; bsi != bdd_map.end(); ++bsi)
-		  {
-		    hash_set* set = bsi->second;
-		    // Free the number associated to these states.
-		    unsigned num = state_set_map[*set->begin()];
-		    assert(used_var.find(num) != used_var.end());
-		    unsigned left = (used_var[num] -= set->size());
-		    // Make sure LEFT does not become negative (hence bigger
-		    // than SIZE when read as unsigned)
-		    assert(left < size);
-		    if (left == 0)
-		      {
-			used_var.erase(num);
-			free_var.insert(num);
-		      }
-		    // Pick a free number
-		    assert(!free_var.empty());
-		    num = *free_var.begin();
-		    free_var.erase(free_var.begin());
-		    used_var[num] = set->size();
-		    for (hash_set::iterator hit = set->begin();
-			 hit != set->end(); ++hit)
-		      state_set_map[*hit] = num;
-		    // Trivial sets can't be splitted any further.
-		    if (set->size() == 1)
-		      {
-			trace << "set " << format_hash_set(set, det_a)
-			      << " is minimal" << std::endl;
-			done.push_back(set);
-		      }
-		    else
-		      {
-			did_split = true;
-			trace << "set " << format_hash_set(set, det_a)
-			      << " should be processed further" << std::endl;
-			next_run.push_back(set);
-		      }
-		  }
+		std::vector<unsigned>& v = pre[pred[j].second];
+		if (v.empty())
+		  used_letters.push_back(pred[j].second);
+		v.push_back(pred[j].first);
 	      }
-	    delete cur;
 	  }
-	if (did_split)
-	  trace << "splitting did occur during this pass." << std::endl;
-	else
-	  trace << "splitting did not occur during this pass." << std::endl;
-	std::swap(cur_run, next_run);
+
+	for (unsigned i = 0; i < used_letters.size(); ++i)
+	  {
+	    std::vector<unsigned>& v = pre[used_letters[i]];
+	    for (unsigned j = 0; j < v.size(); ++j)
+	      part.mark(v[j]);
+	    part.split(work);
+	    v.clear();
+	  }
+	used_letters.clear();
       }
 
-    done.splice(done.end(), cur_run);
+    // Gather the blocks, numbered by their first state.
+    std::list<hash_set*> done;
+    {
+      std::vector<hash_set*> set_of(part.blocks(), 0);
+      for (unsigned s = 0; s < n; ++s)
+	{
+	  hash_set*& h = set_of[part.block_of(s)];
+	  if (!h)
+	    {
+	      h = new hash_set;
+	      done.push_back(h);
+	    }
+	  h->insert(states[s]);
+	}
+    }
 
 #ifdef TRACE
     trace << "Final partition: ";
-    for (partition_t::const_iterator i = done.begin(); i != done.end(); ++i)
+    for (std::list<hash_set*>::const_iterator i = done.begin();
+	 i != done.end(); ++i)
       trace << format_hash_set(*i, det_a) << " ";
     trace << std::endl;
 #endif
 
     // Build the result.
-    tgba_explicit_number* res = build_result(det_a, done, final_copy);
+    tgba_explicit_number* res = build_result(det_a, done, final);
 
     // Free all the allocated memory.
-    delete final_copy;
-    hash_map::iterator hit;
-    for (hit = state_set_map.begin(); hit != state_set_map.end();)
-      {
-	hash_map::iterator old = hit++;
-	old->first->destroy();
-      }
+    for (unsigned s = 0; s < n; ++s)
+      states[s]->destroy();
     std::list<hash_set*>::iterator it;
     for (it = done.begin(); it != done.end(); ++it)
       delete *it;
+    delete final;
+    delete non_final;
     delete det_a;
 
     return res;
@@ -607,8 +991,8 @@ namespace spot
 	  if (!is_useless)
 	    {
 	      hash_set* dest_set = acc ? final : non_final;
-	      const std::list<const state*>& l = sm.states_of(n);
-	      std::list<const state*>::const_iterator il;
+	      const std::vector<const state*>& l = sm.states_of(n);
+	      std::vector<const state*>::const_iterator il;
 	      for (il = l.begin(); il != l.end(); ++il)
 		dest_set->insert((*il)->clone());
 	    }
@@ -618,6 +1002,26 @@ namespace spot
     return minimize_dfa(det_a, final, non_final);
   }
 
+  namespace
+  {
+    // Whether L(aut) is included in L(wdba), using the complement
+    // of the weak deterministic automaton wdba.
+    bool
+    wdba_includes(const tgba_explicit_number* wdba, const tgba* aut)
+    {
+      tgba* neg_wdba = wdba_complement(wdba);
+      tgba* p = new tgba_product(aut, neg_wdba);
+      emptiness_check* ec = couvreur99(p);
+      emptiness_check_result* res = ec->check();
+      bool included = !res;
+      delete res;
+      delete ec;
+      delete p;
+      delete neg_wdba;
+      return included;
+    }
+  }
+
   const tgba*
   minimize_obligation(const tgba* aut_f,
 		      const ltl::formula* f, const tgba* aut_neg_f)
@@ -633,8 +1037,15 @@ namespace spot
 
     if (!f && !aut_neg_f)
       {
-	// We do not now if the minimization is safe.
-	return 0;
+	// Without the negation, check that L(min_aut_f) is included
+	// in L(aut_f) without complementing aut_f.
+	tgba_run* run = check_inclusion(min_aut_f, aut_f);
+	bool ok = !run && wdba_includes(min_aut_f, aut_f);
+	delete run;
+	if (ok)
+	  return min_aut_f;
+	delete min_aut_f;
+	return aut_f;
       }
 
     const tgba* to_free = 0;
@@ -669,34 +1080,13 @@ namespace spot
     emptiness_check_result* res = ec->check();
     if (!res)
       {
-	delete ec;
-	delete p;
-
-	// Complement the minimized WDBA.
-	tgba* neg_min_aut_f = wdba_complement(min_aut_f);
-
-	tgba* p = new tgba_product(aut_f, neg_min_aut_f);
-	emptiness_check* ec = couvreur99(p);
-	res = ec->check();
-
-	if (!res)
-	  {
-	    // Finally, we are now sure that it was safe
-	    // to minimize the automaton.
-	    ok = true;
-	  }
-
-	delete res;
-	delete ec;
-	delete p;
-	delete neg_min_aut_f;
-      }
-    else
-      {
-	delete res;
-	delete ec;
-	delete p;
+	// We are now sure that it was safe to minimize the automaton
+	// if L(aut_f) is included in L(min_aut_f).
+	ok = wdba_includes(min_aut_f, aut_f);
       }
+    delete res;
+    delete ec;
+    delete p;
     delete to_free;
 
     if (ok)
@@ -121,15 +121,15 @@ namespace spot
   /// Because it is hard to determine if an automaton corresponds
   /// to an obligation property, you should supply either the formula
   /// \a f expressed by the automaton \a aut_f, or \a aut_neg_f the negation
-  /// of the automaton \a aut_neg_f.
+  /// of the automaton \a aut_neg_f.  If neither is supplied, the
+  /// (more costly) check_inclusion() is used instead of a product
+  /// with \a aut_neg_f.
   ///
   /// \param aut_f the automaton to minimize
   /// \param f the LTL formula represented by the automaton \a aut_f
   /// \param aut_neg_f an automaton representing the negation of \a aut_f
   /// \return a new tgba if the automaton could be minimized, aut_f if
-  /// the automaton cannot be minimized, 0 if we do not if if the
-  /// minimization is correct because neither \a f nor \a aut_neg_f
-  /// were supplied.
+  /// the automaton cannot be minimized.
   ///
   /// The function proceeds as follows.  If the formula \a f or the
   /// automaton \a aut can easily be proved to represent an obligation
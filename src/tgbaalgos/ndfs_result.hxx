@@ -34,6 +34,7 @@
 #endif
 
 #include <cassert>
+#include <algorithm>
 #include <list>
 #include "misc/hash.hh"
 #include "tgba/tgba.hh"
@@ -413,8 +414,7 @@ namespace spot
         return s;
       }
 
-      void finalize(const std::map<const state*, tgba_run::step,
-		                   state_ptr_less_than>&,
+      void finalize(const father_map&,
 		    const tgba_run::step&, const state*, tgba_run::steps&)
       {
       }
@@ -658,8 +658,7 @@ namespace spot
       cycle_entry_point->destroy();
 
       // Now shift the cycle so it starts on cycle_entry_point.
-      run->cycle.splice(run->cycle.end(), run->cycle,
-                        run->cycle.begin(), cycle_ep_it);
+      std::rotate(run->cycle.begin(), cycle_ep_it, run->cycle.end());
     }
   };
 
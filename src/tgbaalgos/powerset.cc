@@ -21,48 +21,109 @@
 // Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
 // 02111-1307, USA.
 
-#include <set>
+#include <climits>
 #include <deque>
 #include "powerset.hh"
 #include "misc/hash.hh"
-#include "tgbaalgos/powerset.hh"
 #include "bdd.h"
 
 namespace spot
 {
+  namespace
+  {
+    // An outgoing transition of the original automaton.
+    struct out_arc
+    {
+      out_arc(bdd cond, unsigned dst)
+	: cond(cond), dst(dst)
+      {
+      }
+
+      bdd cond;
+      unsigned dst;
+    };
+
+    typedef std::vector<out_arc> out_arcs;
+
+    // A set of original states, as an increasing sequence of state
+    // numbers.
+    typedef std::vector<unsigned> id_set;
+
+    struct id_set_hash
+    {
+      size_t
+      operator()(const id_set& ids) const
+      {
+	size_t h = ids.size();
+	for (id_set::const_iterator i = ids.begin(); i != ids.end(); ++i)
+	  h = hash_combine(h, *i);
+	return h;
+      }
+    };
+
+    typedef unsigned long word;
+    const unsigned word_bits = sizeof(word) * CHAR_BIT;
+  }
+
   tgba_explicit_number*
   tgba_powerset(const tgba* aut, power_map& pm)
   {
-    typedef power_map::power_state power_state;
-    typedef std::map<power_map::power_state, int> power_set;
-    typedef std::deque<power_map::power_state> todo_list;
+    // Number all the reachable states of AUT, and record their
+    // outgoing transitions and support variables, so that the
+    // original automaton is only explored once.
+    std::vector<out_arcs> arcs;
+    std::vector<bdd> support;
+    pm.number_of(aut->get_init_state());
+    for (unsigned n = 0; n < pm.states.size(); ++n)
+      {
+	const state* src = pm.states[n];
+	support.push_back(aut->support_variables(src));
+	arcs.push_back(out_arcs());
+	tgba_succ_iterator* si = aut->succ_iter(src);
+	for (si->first(); !si->done(); si->next())
+	  {
+	    unsigned dst = pm.number_of(si->current_state());
+	    arcs[n].push_back(out_arc(si->current_condition(), dst));
+	  }
+	delete si;
+      }
 
+    // Power states are interned by their sets of numbers.  KEY_OF
+    // points to the keys of this table, by power state number.
+    typedef Sgi::hash_map<id_set, int, id_set_hash> power_set;
     power_set seen;
-    todo_list todo;
+    std::vector<const id_set*> key_of;
+    std::deque<int> todo;
     tgba_explicit_number* res = new tgba_explicit_number(aut->get_dict());
 
+    // Power state numbers start at 1.
+    key_of.push_back(0);
+    pm.map_.push_back(power_map::power_state());
     {
-      power_state ps;
-      state* s = aut->get_init_state();
-      pm.states.insert(s);
-      ps.insert(s);
-      todo.push_back(ps);
-      seen[ps] = 1;
-      pm.map_[1] = ps;
+      id_set init(1, 0);
+      power_set::iterator i = seen.insert(std::make_pair(init, 1)).first;
+      key_of.push_back(&i->first);
+      pm.map_.push_back(power_map::power_state(1, pm.states[0]));
+      todo.push_back(1);
     }
 
-    unsigned state_num = 1;
+    // The successors of a power state are accumulated in a bit set
+    // over the state numbers, which yields them in increasing order.
+    std::vector<word> dest_bits((pm.states.size() + word_bits - 1)
+				/ word_bits, 0);
+    id_set dest;
 
     while (!todo.empty())
       {
-	power_state src = todo.front();
+	int src_num = todo.front();
 	todo.pop_front();
+	const id_set& src = *key_of[src_num];
+
 	// Compute all variables occurring on outgoing arcs.
 	bdd all_vars = bddtrue;
-	power_state::const_iterator i;
-
+	id_set::const_iterator i;
 	for (i = src.begin(); i != src.end(); ++i)
-	  all_vars &= aut->support_variables(*i);
+	  all_vars &= support[*i];
 
 	// Compute all possible combinations of these variables.
 	bdd all_conds = bddtrue;
@@ -72,37 +133,49 @@ namespace spot
 	    all_conds -= cond;
 
 	    // Construct the set of all states reachable via COND.
-	    power_state dest;
+	    bool empty = true;
 	    for (i = src.begin(); i != src.end(); ++i)
 	      {
-		tgba_succ_iterator *si = aut->succ_iter(*i);
-		for (si->first(); !si->done(); si->next())
-		  if ((cond >> si->current_condition()) == bddtrue)
+		const out_arcs& out = arcs[*i];
+		for (out_arcs::const_iterator a = out.begin();
+		     a != out.end(); ++a)
+		  if ((cond >> a->cond) == bddtrue)
 		    {
-		      const state* s = pm.canonicalize(si->current_state());
-		      dest.insert(s);
+		      dest_bits[a->dst / word_bits] |=
+			word(1) << (a->dst % word_bits);
+		      empty = false;
 		    }
-		delete si;
 	      }
-	    if (dest.empty())
+	    if (empty)
 	      continue;
-	    // Add that transition.
-	    power_set::const_iterator i = seen.find(dest);
-	    int dest_num;
-	    tgba_explicit::transition* t;
-	    if (i != seen.end())
+	    dest.clear();
+	    for (unsigned w = 0; w < dest_bits.size(); ++w)
 	      {
-		dest_num = i->second;
-                t = res->create_transition(seen[src], dest_num);
+		word b = dest_bits[w];
+		if (!b)
+		  continue;
+		dest_bits[w] = 0;
+		for (unsigned j = w * word_bits; b; ++j, b >>= 1)
+		  if (b & 1)
+		    dest.push_back(j);
 	      }
-	    else
+
+	    // Add that transition.
+	    std::pair<power_set::iterator, bool> r =
+	      seen.insert(std::make_pair(dest, int(key_of.size())));
+	    int dest_num = r.first->second;
+	    if (r.second)
 	      {
-		dest_num = ++state_num;
-		seen[dest] = dest_num;
-		pm.map_[dest_num] = dest;
-		todo.push_back(dest);
-                t = res->create_transition(seen[src], dest_num);
+		key_of.push_back(&r.first->first);
+		power_map::power_state ps;
+		ps.reserve(dest.size());
+		for (i = dest.begin(); i != dest.end(); ++i)
+		  ps.push_back(pm.states[*i]);
+		pm.map_.push_back(ps);
+		todo.push_back(dest_num);
 	      }
+	    tgba_explicit::transition* t =
+	      res->create_transition(src_num, dest_num);
 	    res->add_conditions(t, cond);
 	  }
       }
@@ -24,57 +24,61 @@
 #ifndef SPOT_TGBAALGOS_POWERSET_HH
 # define SPOT_TGBAALGOS_POWERSET_HH
 
-# include <list>
-# include <map>
+# include <vector>
 # include "tgba/tgbaexplicit.hh"
+# include "misc/hash.hh"
 
 namespace spot
 {
 
+  /// \brief The states of the original automaton associated to each
+  /// state of an automaton built by tgba_powerset().
+  ///
+  /// The original states are numbered densely, in the order they are
+  /// discovered, and each of them is represented by a unique state
+  /// pointer.
   struct power_map
   {
-    typedef std::set<const state*, state_ptr_less_than> power_state;
-    typedef std::map<int, power_state> power_map_data;
-    typedef Sgi::hash_set<const state*, state_ptr_hash,
-			  state_ptr_equal> state_set;
+    /// A set of original states, ordered by state number.
+    typedef std::vector<const state*> power_state;
+    typedef std::vector<power_state> power_map_data;
+    typedef Sgi::hash_map<const state*, unsigned, state_ptr_hash,
+			  state_ptr_equal> state_map;
 
     ~power_map()
     {
       // Release all states.
-      state_set::const_iterator i = states.begin();
-      while (i != states.end())
-	{
-	  // Advance the iterator before deleting the key.
-	  const state* s = *i;
-	  ++i;
-	  s->destroy();
-	}
+      for (unsigned i = 0; i < states.size(); ++i)
+	states[i]->destroy();
     }
 
+    /// The original states associated to state \a s of the
+    /// deterministic automaton.
     const power_state&
     states_of(int s) const
     {
-      return map_.find(s)->second;
+      return map_[s];
     }
 
-    const state*
-    canonicalize(const state* s)
+    /// \brief Return the number of \a s.
+    ///
+    /// \a s is destroyed if an equal state has already been
+    /// numbered, and kept otherwise.
+    unsigned
+    number_of(const state* s)
     {
-      state_set::const_iterator i = states.find(s);
-      if (i != states.end())
-	{
-	  s->destroy();
-	  s = *i;
-	}
+      std::pair<state_map::iterator, bool> r =
+	nums.insert(state_map::value_type(s, states.size()));
+      if (r.second)
+	states.push_back(s);
       else
-	{
-	  states.insert(s);
-	}
-      return s;
+	s->destroy();
+      return r.first->second;
     }
 
     power_map_data map_;
-    state_set states;
+    std::vector<const state*> states;
+    state_map nums;
   };
 
 
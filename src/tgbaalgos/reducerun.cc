@@ -21,6 +21,7 @@
 // Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
 // 02111-1307, USA.
 
+#include <algorithm>
 #include "misc/hash.hh"
 #include "emptiness.hh"
 #include "tgba/tgba.hh"
@@ -182,8 +183,7 @@ namespace spot
     assert(cycle_ep_it != res->cycle.end());
 
     // Now shift the cycle so it starts on cycle_entry_point.
-    res->cycle.splice(res->cycle.end(), res->cycle,
-		      res->cycle.begin(), cycle_ep_it);
+    std::rotate(res->cycle.begin(), cycle_ep_it, res->cycle.end());
 
     return res;
   }
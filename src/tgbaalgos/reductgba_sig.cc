@@ -0,0 +1,395 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#include <map>
+#include "reductgba_sim.hh"
+#include "misc/hash.hh"
+
+namespace spot
+{
+  namespace
+  {
+    typedef Sgi::hash_map<const state*, unsigned,
+			  state_ptr_hash, state_ptr_equal> state_num_map;
+
+    // An outgoing transition.  LABEL is its condition with its
+    // acceptance conditions encoded for the direct signatures, and
+    // ACCEPTING tells whether it has any acceptance condition.
+    struct sig_arc
+    {
+      sig_arc(bdd cond, bdd label, bool accepting, unsigned dst)
+	: cond(cond), label(label), accepting(accepting), dst(dst)
+      {
+      }
+
+      bdd cond;
+      bdd label;
+      bool accepting;
+      unsigned dst;
+    };
+
+    // Compute the greatest direct or delayed simulation of an
+    // automaton by signature refinement.
+    //
+    // Starting from the relation where every state simulates every
+    // other state, each round computes the signature of every state:
+    //
+    //   sig(p) = OR over p --(cond,acc)--> p'
+    //              of cond & enc(acc) & down(class(p'))
+    //
+    // where down(c) is the disjunction of the variables of all
+    // classes simulated by c, and enc(acc) is the conjunction of the
+    // negation of the acceptance variables that are not in acc.  With
+    // these encodings, sig(p) implies sig(q) iff for each letter of
+    // each transition of p there is a transition of q with the same
+    // letter, at least the same acceptance conditions, and going to
+    // a state that simulates the destination of the transition of p.
+    // States of a class with different signatures are then split,
+    // and a class is kept under another only if their signatures
+    // imply each other in that direction.  This is repeated until
+    // the relation is stable.
+    //
+    // The delayed simulation is computed on pairs of states with a
+    // pending bit, telling whether the simulated state has seen an
+    // acceptance condition that the simulating state has not matched
+    // yet.  The simulating state wins if that bit is cleared
+    // infinitely often, so the winning pairs are obtained with the
+    // usual nested fixpoint of Bchi games,
+    //
+    //   W = nu Z. mu Y. (clear & pre(Z)) | pre(Y)
+    //
+    // where pre(X) holds the pairs (p,q,b) such that for each letter
+    // of each transition p --(cond,acc)--> p', q has a transition
+    // q --(cond',acc')--> q' with the same letter and such that
+    // (p',q',(b|acc)&!acc') is in X.  Each pre() is computed by
+    // comparing signatures again: the signature of p for bit b is
+    //
+    //   sig(p,b) = OR over p --(cond,acc)--> p' of cond & v(p') & C(b|acc)
+    //
+    // where v(p') is a variable of p', and C(c) is the literal of the
+    // pending bit, while the signature of q for X is
+    //
+    //   sig_X(q) = OR over q --(cond,acc')--> q' of
+    //                cond & (C(1) & down_X(q',!acc') | C(0) & down_X(q',0))
+    //
+    // where down_X(q',d) is the disjunction of the variables of the
+    // states p' such that (p',q',d) is in X.  Then (p,q,b) is in pre(X)
+    // iff sig(p,b) implies sig_X(q).  Like the parity game, this
+    // handles only one acceptance condition.
+    class signature_simulation
+    {
+    public:
+      signature_simulation(const tgba* a)
+	: a_(a)
+      {
+	bdd acc_vars = bdd_support(a->all_acceptance_conditions());
+
+	// Number the states densely, in breadth-first order.
+
+	const state* init = a->get_init_state();
+	num_[init] = 0;
+	states_.push_back(init);
+	for (unsigned n = 0; n < states_.size(); ++n)
+	  {
+	    arcs_.push_back(std::vector<sig_arc>());
+	    tgba_succ_iterator* si = a->succ_iter(states_[n]);
+	    for (si->first(); !si->done(); si->next())
+	      {
+		const state* dst = si->current_state();
+		std::pair<state_num_map::iterator, bool> r =
+		  num_.insert(std::make_pair(dst, states_.size()));
+		if (r.second)
+		  states_.push_back(dst);
+		else
+		  dst->destroy();
+		bdd acc = encode_acc(si->current_acceptance_conditions(),
+				     acc_vars);
+		bdd cond = si->current_condition();
+		arcs_[n].push_back(sig_arc(cond, cond & acc,
+					   si->current_acceptance_conditions()
+					   != bddfalse,
+					   r.first->second));
+	      }
+	    delete si;
+	  }
+      }
+
+      ~signature_simulation()
+      {
+	// The states still owned are those that were not handed to
+	// a relation.
+	for (unsigned n = 0; n < states_.size(); ++n)
+	  if (states_[n])
+	    states_[n]->destroy();
+      }
+
+      // Compute the direct simulation, and give the states to REL.
+      void
+      direct_relation(simulation_relation* rel)
+      {
+	unsigned n = states_.size();
+	std::vector<unsigned> class_of(n, 0);
+	// le[c1][c2] means that class c2 simulates class c1.
+	std::vector<std::vector<bool> > le(1, std::vector<bool>(1, true));
+
+	bdd_dict* dict = a_->get_dict();
+	int base = dict->register_anonymous_variables(n, this);
+
+	std::vector<bdd> down;
+	std::vector<bdd> sig(n);
+	for (;;)
+	  {
+	    unsigned classes = le.size();
+	    down.assign(classes, bddfalse);
+	    for (unsigned c1 = 0; c1 < classes; ++c1)
+	      for (unsigned c2 = 0; c2 < classes; ++c2)
+		if (le[c1][c2])
+		  down[c2] |= bdd_ithvar(base + c1);
+
+	    for (unsigned s = 0; s < n; ++s)
+	      {
+		bdd res = bddfalse;
+		const std::vector<sig_arc>& out = arcs_[s];
+		for (unsigned t = 0; t < out.size(); ++t)
+		  res |= out[t].label & down[class_of[out[t].dst]];
+		sig[s] = res;
+	      }
+
+	    // Split the classes according to the signatures.
+	    typedef std::map<std::pair<unsigned, int>, unsigned> split_map;
+	    split_map split;
+	    std::vector<unsigned> new_class_of(n);
+	    std::vector<unsigned> repr;
+	    for (unsigned s = 0; s < n; ++s)
+	      {
+		std::pair<split_map::iterator, bool> r =
+		  split.insert(std::make_pair(std::make_pair(class_of[s],
+							     sig[s].id()),
+					      repr.size()));
+		if (r.second)
+		  repr.push_back(s);
+		new_class_of[s] = r.first->second;
+	      }
+
+	    // Order the new classes.
+	    unsigned new_classes = repr.size();
+	    std::vector<std::vector<bool> >
+	      new_le(new_classes, std::vector<bool>(new_classes, false));
+	    bool changed = new_classes != classes;
+	    for (unsigned c1 = 0; c1 < new_classes; ++c1)
+	      for (unsigned c2 = 0; c2 < new_classes; ++c2)
+		{
+		  unsigned r1 = repr[c1];
+		  unsigned r2 = repr[c2];
+		  bool b = c1 == c2
+		    || (le[class_of[r1]][class_of[r2]]
+			&& (sig[r1] - sig[r2]) == bddfalse);
+		  new_le[c1][c2] = b;
+		  if (!changed && b != le[c1][c2])
+		    changed = true;
+		}
+
+	    class_of.swap(new_class_of);
+	    le.swap(new_le);
+	    if (!changed)
+	      break;
+	  }
+
+	dict->unregister_all_my_variables(this);
+
+	std::vector<bool> win(n * n);
+	for (unsigned s1 = 0; s1 < n; ++s1)
+	  for (unsigned s2 = 0; s2 < n; ++s2)
+	    win[s1 * n + s2] = le[class_of[s1]][class_of[s2]];
+	output(win, rel);
+      }
+
+      // Compute the delayed simulation, and give the states to REL.
+      void
+      delayed_relation(simulation_relation* rel)
+      {
+	if (a_->number_of_acceptance_conditions() > 1)
+	  return;
+
+	unsigned n = states_.size();
+	bdd_dict* dict = a_->get_dict();
+	int base = dict->register_anonymous_variables(n + 1, this);
+	bdd pending = bdd_ithvar(base + n);
+
+	// The signatures of the simulated states do not change.
+	std::vector<bdd> sig[2];
+	for (unsigned b = 0; b < 2; ++b)
+	  {
+	    sig[b].resize(n);
+	    for (unsigned s = 0; s < n; ++s)
+	      {
+		bdd res = bddfalse;
+		const std::vector<sig_arc>& out = arcs_[s];
+		for (unsigned t = 0; t < out.size(); ++t)
+		  res |= out[t].cond & bdd_ithvar(base + out[t].dst)
+		    & ((b || out[t].accepting) ? pending : !pending);
+		sig[b][s] = res;
+	      }
+	  }
+
+	// z[b][p * n + q] holds if (p,q,b) is in Z.
+	std::vector<bool> z[2];
+	z[0].assign(n * n, true);
+	z[1].assign(n * n, true);
+	// Z only shrinks, so the pairs out of Z, and the pairs already
+	// in Y, need not be checked again.
+	std::vector<bool> todo[2];
+	std::vector<bool> y[2];
+	std::vector<bool> cy[2];
+	for (;;)
+	  {
+	    todo[0] = z[0];
+	    todo[1].assign(n * n, false);
+	    pre(z, todo, y, base, pending, sig);
+	    for (;;)
+	      {
+		bool changed = false;
+		for (unsigned b = 0; b < 2; ++b)
+		  for (unsigned i = 0; i < n * n; ++i)
+		    todo[b][i] = z[b][i] && !y[b][i];
+		pre(y, todo, cy, base, pending, sig);
+		for (unsigned b = 0; b < 2; ++b)
+		  for (unsigned i = 0; i < n * n; ++i)
+		    if (cy[b][i])
+		      {
+			y[b][i] = true;
+			changed = true;
+		      }
+		if (!changed)
+		  break;
+	      }
+	    bool changed = y[0] != z[0] || y[1] != z[1];
+	    z[0].swap(y[0]);
+	    z[1].swap(y[1]);
+	    if (!changed)
+	      break;
+	  }
+
+	dict->unregister_all_my_variables(this);
+	output(z[0], rel);
+      }
+
+    private:
+      // Compute pre(X) into RES, for the delayed simulation, checking
+      // only the pairs in TODO.
+      void
+      pre(const std::vector<bool>* x, const std::vector<bool>* todo,
+	  std::vector<bool>* res,
+	  int base, bdd pending, const std::vector<bdd>* sig) const
+      {
+	unsigned n = states_.size();
+
+	// down[d][q'] is down_X(q',d).
+	std::vector<bdd> down[2];
+	for (unsigned d = 0; d < 2; ++d)
+	  {
+	    down[d].assign(n, bddfalse);
+	    for (unsigned p = 0; p < n; ++p)
+	      for (unsigned q = 0; q < n; ++q)
+		if (x[d][p * n + q])
+		  down[d][q] |= bdd_ithvar(base + p);
+	  }
+
+	res[0].assign(n * n, false);
+	res[1].assign(n * n, false);
+	for (unsigned q = 0; q < n; ++q)
+	  {
+	    bool needed = false;
+	    for (unsigned b = 0; b < 2 && !needed; ++b)
+	      for (unsigned p = 0; p < n && !needed; ++p)
+		needed = todo[b][p * n + q];
+	    if (!needed)
+	      continue;
+
+	    bdd dup = bddfalse;
+	    const std::vector<sig_arc>& out = arcs_[q];
+	    for (unsigned t = 0; t < out.size(); ++t)
+	      {
+		unsigned dst = out[t].dst;
+		dup |= out[t].cond
+		  & ((pending & down[out[t].accepting ? 0 : 1][dst])
+		     | (down[0][dst] - pending));
+	      }
+	    for (unsigned b = 0; b < 2; ++b)
+	      for (unsigned p = 0; p < n; ++p)
+		if (todo[b][p * n + q])
+		  res[b][p * n + q] = (sig[b][p] - dup) == bddfalse;
+	  }
+      }
+
+      // Output the pairs (p,q) such that WIN[p * n + q] holds, in
+      // the order of the state numbers, and give the states to REL.
+      void
+      output(const std::vector<bool>& win, simulation_relation* rel)
+      {
+	unsigned n = states_.size();
+	for (unsigned s1 = 0; s1 < n; ++s1)
+	  for (unsigned s2 = 0; s2 < n; ++s2)
+	    if (win[s1 * n + s2])
+	      rel->push_back(new state_couple(states_[s1], states_[s2]));
+	states_.clear();
+      }
+
+      // Encode acceptance conditions ACC as the conjunction of the
+      // negations of the acceptance variables that do not occur in
+      // ACC.
+      static bdd
+      encode_acc(bdd acc, bdd acc_vars)
+      {
+	bdd res = bddtrue;
+	for (; acc_vars != bddtrue; acc_vars = bdd_high(acc_vars))
+	  {
+	    bdd v = bdd_ithvar(bdd_var(acc_vars));
+	    if ((acc & v) == bddfalse)
+	      res &= !v;
+	  }
+	return res;
+      }
+
+      const tgba* a_;
+      state_num_map num_;
+      std::vector<const state*> states_;
+      std::vector<std::vector<sig_arc> > arcs_;
+    };
+  }
+
+  direct_simulation_relation*
+  get_direct_relation_simulation_sig(const tgba* a)
+  {
+    direct_simulation_relation* rel = new direct_simulation_relation;
+    signature_simulation sim(a);
+    sim.direct_relation(rel);
+    return rel;
+  }
+
+  delayed_simulation_relation*
+  get_delayed_relation_simulation_sig(const tgba* a)
+  {
+    delayed_simulation_relation* rel = new delayed_simulation_relation;
+    signature_simulation sim(a);
+    sim.delayed_relation(rel);
+    return rel;
+  }
+}
@@ -667,7 +667,7 @@ namespace spot
   }
 
   const tgba*
-  reduc_tgba_sim(const tgba* f, int opt)
+  reduc_tgba_sim(const tgba* f, int opt, bool signature)
   {
     if (opt & Reduce_Scc)
       {
@@ -687,7 +687,9 @@ namespace spot
     if (opt & (Reduce_quotient_Dir_Sim | Reduce_transition_Dir_Sim))
       {
 	direct_simulation_relation* rel
-	  = get_direct_relation_simulation(automatareduc, std::cout);
+	  = signature
+	  ? get_direct_relation_simulation_sig(automatareduc)
+	  : get_direct_relation_simulation(automatareduc, std::cout);
 
 	assert(rel);
 
@@ -701,7 +703,9 @@ namespace spot
       if (opt & (Reduce_quotient_Del_Sim | Reduce_transition_Del_Sim))
 	{
 	  delayed_simulation_relation* rel
-	    = get_delayed_relation_simulation(automatareduc, std::cout);
+	    = signature
+	    ? get_delayed_relation_simulation_sig(automatareduc)
+	    : get_delayed_relation_simulation(automatareduc, std::cout);
 
 	  assert(rel);
 
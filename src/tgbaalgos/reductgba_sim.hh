@@ -68,8 +68,13 @@ namespace spot
   /// \param a the automata to reduce.
   /// \param opt a conjonction of spot::reduce_tgba_options specifying
   ///             which optimizations to apply.
+  /// \param signature whether to compute the simulation by signature
+  ///             refinement (see get_direct_relation_simulation_sig()
+  ///             and get_delayed_relation_simulation_sig()) instead
+  ///             of a parity game.
   /// \return the reduced automata.
-  const tgba* reduc_tgba_sim(const tgba* a, int opt = Reduce_All);
+  const tgba* reduc_tgba_sim(const tgba* a, int opt = Reduce_All,
+			     bool signature = false);
 
 #ifndef SWIG
 
@@ -84,6 +89,35 @@ namespace spot
 							       std::ostream& os,
 							       int opt = -1);
 
+  /// \brief Compute a direct simulation relation on states of tgba
+  /// \a a by signature refinement.
+  ///
+  /// This computes the same kind of relation as
+  /// get_direct_relation_simulation(), without building a parity
+  /// game: the states are numbered densely, and the relation is
+  /// refined by comparing BDD-encoded signatures of the states until
+  /// it is stable.  The simulating state may match each letter of a
+  /// transition with a different transition, so the relation can be
+  /// larger than the one computed with the game.
+  direct_simulation_relation*
+  get_direct_relation_simulation_sig(const tgba* a);
+
+  /// \brief Compute a delayed simulation relation on states of tgba
+  /// \a a by signature refinement.
+  ///
+  /// This computes the same kind of relation as
+  /// get_delayed_relation_simulation(), without building a parity
+  /// game: the pairs of states are refined with a pending-acceptance
+  /// bit, using the fixpoint of a Bchi game whose predecessor
+  /// operator compares BDD-encoded signatures.  Only |Q|^2 bits are
+  /// kept besides the signatures.  As with
+  /// get_direct_relation_simulation_sig(), the relation can be larger
+  /// than the one computed with the game.
+  /// \bug Like get_delayed_relation_simulation(), returns an empty
+  /// relation for generalized automata.
+  delayed_simulation_relation*
+  get_delayed_relation_simulation_sig(const tgba* a);
+
   /// To free a simulation relation.
   void free_relation_simulation(direct_simulation_relation* rel);
   /// To free a simulation relation.
@@ -44,7 +44,7 @@ namespace spot
 	if (!sm->accepting(scc))
 	  continue;
 	// Accepting SCCs should have only one state.
-	const std::list<const state*>& st = sm->states_of(scc);
+	const std::vector<const state*>& st = sm->states_of(scc);
 	if (st.size() != 1)
 	  {
 	    result = false;
@@ -20,6 +20,7 @@
 
 #include <queue>
 #include <set>
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include "scc.hh"
@@ -96,13 +97,46 @@ namespace spot
   }
 
 
+  unsigned
+  scc_map::cond_number(const bdd& cond)
+  {
+    std::pair<Sgi::hash_map<int, unsigned>::iterator, bool> res =
+      cond_num_.insert(std::make_pair(cond.id(), conds_.size()));
+    if (res.second)
+      conds_.push_back(cond);
+    return res.first->second;
+  }
+
+  namespace
+  {
+    bool
+    succ_less(const std::pair<unsigned, bdd>& a,
+	      const std::pair<unsigned, bdd>& b)
+    {
+      return a.first < b.first;
+    }
+
+    // Append SRC to DST, emptying SRC.  The order of the elements
+    // does not matter, so append the smaller vector to the larger.
+    template <typename T>
+    void
+    merge_into(std::vector<T>& dst, std::vector<T>& src)
+    {
+      if (dst.size() < src.size())
+	dst.swap(src);
+      dst.insert(dst.end(), src.begin(), src.end());
+      std::vector<T>().swap(src);
+    }
+  }
+
   int
   scc_map::relabel_component()
   {
-    assert(!root_.front().states.empty());
-    std::list<const state*>::iterator i;
+    scc& top = root_.back();
+    assert(!top.states.empty());
     int n = scc_map_.size();
-    for (i = root_.front().states.begin(); i != root_.front().states.end(); ++i)
+    std::vector<const state*>::const_iterator i;
+    for (i = top.states.begin(); i != top.states.end(); ++i)
       {
 	hash_type::iterator spi = h_.find(*i);
 	assert(spi != h_.end());
@@ -110,30 +144,54 @@ namespace spot
 	assert(spi->second < 0);
 	spi->second = n;
       }
-    scc_map_.push_back(root_.front());
-    return n;
-  }
-
-  // recursively update supp rec
-  bdd
-  scc_map::update_supp_rec(unsigned state)
-  {
-    assert(scc_map_.size() > state);
 
-    bdd& res = scc_map_[state].supp_rec;
+    // Remove duplicate conditions.
+    std::sort(top.conds.begin(), top.conds.end());
+    top.conds.erase(std::unique(top.conds.begin(), top.conds.end()),
+		    top.conds.end());
 
-    if (res == bddfalse)
+    // Gather the transitions going to the same SCC.
+    succ_type& succ = top.succ;
+    std::stable_sort(succ.begin(), succ.end(), succ_less);
+    if (!succ.empty())
       {
-	const succ_type& s = succ(state);
-	succ_type::const_iterator it;
+	succ_type::iterator out = succ.begin();
+	for (succ_type::iterator in = out + 1; in != succ.end(); ++in)
+	  if (out->first == in->first)
+	    out->second |= in->second;
+	  else
+	    *++out = *in;
+	succ.erase(out + 1, succ.end());
+      }
 
-	res = scc_map_[state].supp;
+    // Move the SCC without copying its containers.
+    scc_map_.push_back(scc(top.index));
+    scc& res = scc_map_.back();
+    res.acc = top.acc;
+    res.states.swap(top.states);
+    res.conds.swap(top.conds);
+    res.supp = top.supp;
+    res.supp_rec = top.supp_rec;
+    res.succ.swap(top.succ);
+    res.trivial = top.trivial;
+    res.useful_acc = top.useful_acc;
+    return n;
+  }
 
-	for (it = s.begin(); it != s.end(); ++it)
-	  res &= update_supp_rec(it->first) & bdd_support(it->second);
+  void
+  scc_map::update_supp_rec()
+  {
+    // The successors of an SCC always have a smaller number, so
+    // a single pass in increasing order is enough.
+    unsigned count = scc_map_.size();
+    for (unsigned n = 0; n < count; ++n)
+      {
+	bdd res = scc_map_[n].supp;
+	const succ_type& s = scc_map_[n].succ;
+	for (succ_type::const_iterator it = s.begin(); it != s.end(); ++it)
+	  res &= scc_map_[it->first].supp_rec & bdd_support(it->second);
+	scc_map_[n].supp_rec = res;
       }
-
-    return res;
   }
 
   void
@@ -145,56 +203,57 @@ namespace spot
       state* init = aut_->get_init_state();
       num_ = -1;
       h_.insert(std::make_pair(init, num_));
-      root_.push_front(scc(num_));
-      arc_acc_.push(bddfalse);
-      arc_cond_.push(bddfalse);
+      root_.push_back(scc(num_));
+      arc_acc_.push_back(bddfalse);
+      arc_cond_.push_back(bddfalse);
       tgba_succ_iterator* iter = aut_->succ_iter(init);
       iter->first();
-      todo_.push(pair_state_iter(init, iter));
+      todo_item t = { init, num_, iter };
+      todo_.push_back(t);
     }
 
+    bdd all = aut_->all_acceptance_conditions();
+
     while (!todo_.empty())
       {
 	assert(root_.size() == arc_acc_.size());
 	assert(root_.size() == arc_cond_.size());
 
 	// We are looking at the next successor in SUCC.
-	tgba_succ_iterator* succ = todo_.top().second;
+	tgba_succ_iterator* succ = todo_.back().it;
 
 	// If there is no more successor, backtrack.
 	if (succ->done())
 	  {
 	    // We have explored all successors of state CURR.
-	    const state* curr = todo_.top().first;
+	    const state* curr = todo_.back().s;
+	    int curr_num = todo_.back().num;
 
 	    // Backtrack TODO_.
-	    todo_.pop();
+	    todo_.pop_back();
 
-	    // Fill rem with any component removed, so that
-	    // remove_component() does not have to traverse the SCC
-	    // again.
-	    hash_type::const_iterator spi = h_.find(curr);
-	    assert(spi != h_.end());
-	    root_.front().states.push_front(spi->first);
+	    // Record CURR in the SCC at the top of ROOT_.  CURR is
+	    // the key used in H_, so there is no need to look it up.
+	    // The root of an SCC is always the last state recorded.
+	    assert(!root_.empty());
+	    root_.back().states.push_back(curr);
 
 	    // When backtracking the root of an SCC, we must also
-	    // remove that SCC from the ARC/ROOT stacks.  We must
-	    // discard from H all reachable states from this SCC.
-	    assert(!root_.empty());
-	    if (root_.front().index == spi->second)
+	    // remove that SCC from the ARC/ROOT stacks.
+	    if (root_.back().index == curr_num)
 	      {
 		assert(!arc_acc_.empty());
 		assert(arc_cond_.size() == arc_acc_.size());
-		bdd cond = arc_cond_.top();
-		arc_cond_.pop();
-		arc_acc_.pop();
+		bdd cond = arc_cond_.back();
+		arc_cond_.pop_back();
+		arc_acc_.pop_back();
 		int num = relabel_component();
-		root_.pop_front();
+		root_.pop_back();
 
 		// Record the transition between the SCC being popped
 		// and the previous SCC.
 		if (!root_.empty())
-		  root_.front().succ.insert(std::make_pair(num, cond));
+		  root_.back().succ.push_back(std::make_pair(num, cond));
 	      }
 
 	    delete succ;
@@ -205,7 +264,7 @@ namespace spot
 	// We have a successor to look at.
 	// Fetch the values we are interested in...
 	const state* dest = succ->current_state();
-	if (!dest->compare(todo_.top().first))
+	if (!dest->compare(todo_.back().s))
 	  ++self_loops_;
 	bdd acc = succ->current_acceptance_conditions();
 	bdd cond = succ->current_condition();
@@ -215,37 +274,34 @@ namespace spot
 	// We do not need SUCC from now on.
 
 	// Are we going to a new state?
-	hash_type::const_iterator spi = h_.find(dest);
-	if (spi == h_.end())
+	std::pair<hash_type::iterator, bool> spi =
+	  h_.insert(std::make_pair(dest, num_ - 1));
+	if (spi.second)
 	  {
 	    // Yes.  Number it, stack it, and register its successors
 	    // for later processing.
-	    h_.insert(std::make_pair(dest, --num_));
-	    root_.push_front(scc(num_));
-	    arc_acc_.push(acc);
-	    arc_cond_.push(cond);
+	    --num_;
+	    root_.push_back(scc(num_));
+	    arc_acc_.push_back(acc);
+	    arc_cond_.push_back(cond);
 	    tgba_succ_iterator* iter = aut_->succ_iter(dest);
 	    iter->first();
-	    todo_.push(pair_state_iter(dest, iter));
+	    todo_item t = { dest, num_, iter };
+	    todo_.push_back(t);
 	    continue;
 	  }
 
 	// If we know the state, reuse the previous object.
 	dest->destroy();
-	dest = spi->first;
 
 	// Have we reached a maximal SCC?
-	if (spi->second >= 0)
+	if (spi.first->second >= 0)
 	  {
-	    int dest = spi->second;
 	    // Record that there is a transition from this SCC to the
-	    // dest SCC labelled with cond.
-	    succ_type::iterator i = root_.front().succ.find(dest);
-	    if (i == root_.front().succ.end())
-	      root_.front().succ.insert(std::make_pair(dest, cond));
-	    else
-	      i->second |= cond;
-
+	    // dest SCC labelled with cond.  Duplicates are merged
+	    // when the SCC is complete.
+	    root_.back().succ.push_back(std::make_pair(spi.first->second,
+						       cond));
 	    continue;
 	  }
 
@@ -259,55 +315,49 @@ namespace spot
 	// This merge is easy to do because the order of the SCC in
 	// ROOT is descending: we just have to merge all SCCs from the
 	// top of ROOT that have an index lesser than the one of
-	// the SCC of S2 (called the "threshold").
-	int threshold = spi->second;
-	std::list<const state*> states;
-	succ_type succs;
-	cond_set conds;
-	conds.insert(cond);
+	// the SCC of S2 (called the "threshold").  Each SCC is
+	// merged into the one below it.
+	int threshold = spi.first->second;
 	bdd supp = bdd_support(cond);
-	bdd all = aut_->all_acceptance_conditions();
 	bdd useful = all - acc;
-	while (threshold > root_.front().index)
+	while (threshold > root_.back().index)
 	  {
-	    assert(!root_.empty());
+	    assert(root_.size() > 1);
 	    assert(!arc_acc_.empty());
 	    assert(arc_acc_.size() == arc_cond_.size());
-	    acc |= root_.front().acc;
-	    bdd lacc = arc_acc_.top();
+	    scc& top = root_.back();
+	    scc& below = root_[root_.size() - 2];
+	    acc |= top.acc;
+	    bdd lacc = arc_acc_.back();
 	    acc |= lacc;
-	    useful |= (all - lacc) | root_.front().useful_acc;
-	    states.splice(states.end(), root_.front().states);
-	    succs.insert(root_.front().succ.begin(),
-			 root_.front().succ.end());
-	    conds.insert(arc_cond_.top());
-	    conds.insert(root_.front().conds.begin(),
-			 root_.front().conds.end());
-	    supp &= root_.front().supp;
-	    root_.pop_front();
-	    arc_acc_.pop();
-	    arc_cond_.pop();
+	    useful |= (all - lacc) | top.useful_acc;
+	    merge_into(below.states, top.states);
+	    merge_into(below.succ, top.succ);
+	    merge_into(below.conds, top.conds);
+	    below.conds.push_back(cond_number(arc_cond_.back()));
+	    supp &= top.supp;
+	    root_.pop_back();
+	    arc_acc_.pop_back();
+	    arc_cond_.pop_back();
 	  }
 
 	// Note that we do not always have
-	//  threshold == root_.front().index
+	//  threshold == root_.back().index
 	// after this loop, the SCC whose index is threshold might have
 	// been merged with a higher SCC.
 
-	// Accumulate all acceptance conditions, states, SCC
-	// successors, and conditions into the merged SCC.
-	root_.front().acc |= acc;
-	root_.front().states.splice(root_.front().states.end(), states);
-	root_.front().succ.insert(succs.begin(), succs.end());
-	root_.front().conds.insert(conds.begin(), conds.end());
-	root_.front().supp &= supp;
+	// Accumulate all acceptance conditions, and conditions into
+	// the merged SCC.
+	scc& top = root_.back();
+	top.acc |= acc;
+	top.conds.push_back(cond_number(cond));
+	top.supp &= supp;
 	// This SCC is no longer trivial.
-	root_.front().trivial = false;
-	root_.front().useful_acc |= useful;
+	top.trivial = false;
+	top.useful_acc |= useful;
       }
 
-    // recursively update supp_rec
-    (void) update_supp_rec(initial());
+    update_supp_rec();
   }
 
   unsigned scc_map::scc_of_state(const state* s) const
@@ -317,10 +367,15 @@ namespace spot
     return i->second;
   }
 
-  const scc_map::cond_set& scc_map::cond_set_of(unsigned n) const
+  scc_map::cond_set scc_map::cond_set_of(unsigned n) const
   {
     assert(scc_map_.size() > n);
-    return scc_map_[n].conds;
+    cond_set res;
+    const std::vector<unsigned>& c = scc_map_[n].conds;
+    for (std::vector<unsigned>::const_iterator i = c.begin();
+	 i != c.end(); ++i)
+      res.insert(conds_[*i]);
+    return res;
   }
 
   bdd scc_map::ap_set_of(unsigned n) const
@@ -348,7 +403,7 @@ namespace spot
     return self_loops_;
   }
 
-  const std::list<const state*>& scc_map::states_of(unsigned n) const
+  const std::vector<const state*>& scc_map::states_of(unsigned n) const
   {
     assert(scc_map_.size() > n);
     return scc_map_[n].states;
@@ -357,7 +412,7 @@ namespace spot
   const state* scc_map::one_state_of(unsigned n) const
   {
     assert(scc_map_.size() > n);
-    return scc_map_[n].states.front();
+    return scc_map_[n].states.back();
   }
 
   unsigned scc_map::scc_count() const
@@ -372,85 +427,63 @@ namespace spot
     return scc_map_[n].useful_acc;
   }
 
-  namespace
-  {
-    struct scc_recurse_data
-    {
-      scc_recurse_data() : acc_scc(0), dead_scc(0) {};
-      typedef std::map<unsigned, unsigned> graph_counter;
-      graph_counter acc_paths;
-      graph_counter dead_paths;
-      unsigned acc_scc;
-      unsigned dead_scc;
-    };
-
-    bool scc_recurse(const scc_map& m, unsigned state, scc_recurse_data& data)
-    {
-      // Don't recurse on previously visited states.
-      scc_recurse_data::graph_counter::const_iterator i =
-	data.acc_paths.find(state);
-      if (i != data.acc_paths.end())
-	return i->second > 0;
-
-      const scc_map::succ_type& succ = m.succ(state);
-
-      bool accepting = m.accepting(state);
-      scc_map::succ_type::const_iterator it;
-      unsigned acc_paths = 0;
-      unsigned dead_paths = 0;
-
-      bool paths_accepting = false;
-      for (it = succ.begin(); it != succ.end(); ++it)
-	{
-	  unsigned dest = it->first;
-	  bool path_accepting = scc_recurse(m, dest, data);
-	  paths_accepting |= path_accepting;
-
-	  acc_paths += data.acc_paths[dest];
-	  dead_paths += data.dead_paths[dest];
-	}
-
-      if (accepting)
-	{
-	  ++data.acc_scc;
-	  if (acc_paths == 0)
-	    acc_paths = 1;
-	}
-      else if (!paths_accepting)
-	{
-	  ++data.dead_scc;
-	  if (dead_paths == 0)
-	    dead_paths = 1;
-	}
-
-      data.acc_paths[state] = acc_paths;
-      data.dead_paths[state] = dead_paths;
-
-      return accepting | paths_accepting;
-    }
-
-  }
-
   scc_stats build_scc_stats(const scc_map& m)
   {
     scc_stats res;
     res.self_loops = m.self_loops();
     res.scc_total = m.scc_count();
 
-    scc_recurse_data d;
-    unsigned init = m.initial();
-    scc_recurse(m, init, d);
+    // The successors of an SCC always have a smaller number, so
+    // the SCCs can be processed bottom-up in increasing order.
+    // Only the SCCs reachable from the initial state exist.
+    std::vector<unsigned> acc_paths(res.scc_total);
+    std::vector<unsigned> dead_paths(res.scc_total);
+    std::vector<bool> reach_acc(res.scc_total);
+    res.acc_scc = 0;
+    res.dead_scc = 0;
+    for (unsigned n = 0; n < res.scc_total; ++n)
+      {
+	const scc_map::succ_type& succ = m.succ(n);
+	bool accepting = m.accepting(n);
+	bool paths_accepting = false;
+	unsigned acc = 0;
+	unsigned dead = 0;
+	scc_map::succ_type::const_iterator it;
+	for (it = succ.begin(); it != succ.end(); ++it)
+	  {
+	    unsigned dest = it->first;
+	    paths_accepting |= reach_acc[dest];
+	    acc += acc_paths[dest];
+	    dead += dead_paths[dest];
+	  }
 
-    res.acc_scc = d.acc_scc;
-    res.dead_scc = d.dead_scc;
-    res.acc_paths = d.acc_paths[init];
-    res.dead_paths = d.dead_paths[init];
+	if (accepting)
+	  {
+	    ++res.acc_scc;
+	    if (acc == 0)
+	      acc = 1;
+	  }
+	else if (!paths_accepting)
+	  {
+	    ++res.dead_scc;
+	    if (dead == 0)
+	      dead = 1;
+	  }
+
+	acc_paths[n] = acc;
+	dead_paths[n] = dead;
+	reach_acc[n] = accepting || paths_accepting;
+      }
+
+    unsigned init = m.initial();
+    res.acc_paths = acc_paths[init];
+    res.dead_paths = dead_paths[init];
 
-    res.useless_scc_map.reserve(res.scc_total);
+    res.useless_scc_map.resize(res.scc_total);
     bdd useful_acc = bddfalse;
     for (unsigned n = 0; n < res.scc_total; ++n)
       {
-	res.useless_scc_map[n] = !d.acc_paths[n];
+	res.useless_scc_map[n] = !acc_paths[n];
 	if (m.accepting(n))
 	  useful_acc |= m.useful_acc_of(n);
       }
@@ -484,7 +517,7 @@ namespace spot
 	int state = q.front();
 	q.pop();
 
-	const scc_map::cond_set& cs = m.cond_set_of(state);
+	scc_map::cond_set cs = m.cond_set_of(state);
 
 	std::ostringstream ostr;
 	ostr << state;
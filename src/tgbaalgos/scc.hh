@@ -21,8 +21,8 @@
 #ifndef SPOT_TGBAALGOS_SCC_HH
 # define SPOT_TGBAALGOS_SCC_HH
 
-#include <map>
-#include <stack>
+#include <deque>
+#include <set>
 #include <vector>
 #include "tgba/tgba.hh"
 #include <iosfwd>
@@ -71,7 +71,9 @@ namespace spot
   class scc_map
   {
   public:
-    typedef std::map<unsigned, bdd> succ_type;
+    /// Successor SCCs, with the disjunction of the conditions of the
+    /// transitions leading to them, ordered by SCC number.
+    typedef std::vector<std::pair<unsigned, bdd> > succ_type;
     typedef std::set<bdd, bdd_less_than> cond_set;
 
     /// \brief Constructor.
@@ -120,7 +122,7 @@ namespace spot
     /// \brief Return the set of conditions occurring in an SCC.
     ///
     /// \pre This should only be called once build_map() has run.
-    const cond_set& cond_set_of(unsigned n) const;
+    cond_set cond_set_of(unsigned n) const;
 
     /// \brief Return the set of atomic properties occurring in an SCC.
     ///
@@ -155,7 +157,7 @@ namespace spot
     /// instance.  They should NOT be destroyed by the client code.
     ///
     /// \pre This should only be called once build_map() has run.
-    const std::list<const state*>& states_of(unsigned n) const;
+    const std::vector<const state*>& states_of(unsigned n) const;
 
     /// \brief Return one state of an SCC.
     ///
@@ -174,8 +176,9 @@ namespace spot
     unsigned self_loops() const;
 
   protected:
-    bdd update_supp_rec(unsigned state);
+    void update_supp_rec();
     int relabel_component();
+    unsigned cond_number(const bdd& cond);
 
     struct scc
     {
@@ -189,14 +192,16 @@ namespace spot
       /// connect the states of the connected component.
       bdd acc;
       /// States of the component.
-      std::list<const state*> states;
-      /// Set of conditions used in the SCC.
-      cond_set conds;
+      std::vector<const state*> states;
+      /// Numbers of the conditions used in the SCC.  This may contain
+      /// duplicates until the SCC is complete.
+      std::vector<unsigned> conds;
       /// Conjunction of atomic propositions used in the SCC.
       bdd supp;
       /// Conjunction of atomic propositions used in the SCC.
       bdd supp_rec;
-      /// Successor SCC.
+      /// Successor SCC.  This may list an SCC several times until
+      /// the SCC is complete.
       succ_type succ;
       /// Trivial SCC have one state and no self-loops.
       bool trivial;
@@ -205,11 +210,11 @@ namespace spot
     };
 
     const tgba* aut_;		// Automata to decompose.
-    typedef std::list<scc> stack_type;
+    typedef std::deque<scc> stack_type;
     stack_type root_;		// Stack of SCC roots.
-    std::stack<bdd> arc_acc_;	// A stack of acceptance conditions
+    std::vector<bdd> arc_acc_;	// A stack of acceptance conditions
 				// between each of these SCC.
-    std::stack<bdd> arc_cond_;	// A stack of conditions
+    std::vector<bdd> arc_cond_;	// A stack of conditions
 				// between each of these SCC.
     typedef Sgi::hash_map<const state*, int,
 			  state_ptr_hash, state_ptr_equal> hash_type;
@@ -218,17 +223,28 @@ namespace spot
                                 // number states that are part of
                                 // incomplete SCCs being completed.
     int num_;			// Number of visited nodes, negated.
-    typedef std::pair<const spot::state*, tgba_succ_iterator*> pair_state_iter;
-    std::stack<pair_state_iter> todo_; // DFS stack.  Holds (STATE,
-				       // ITERATOR) pairs where
-				       // ITERATOR is an iterator over
-				       // the successors of STATE.
-				       // ITERATOR should always be
-				       // freed when TODO is popped,
-				       // but STATE should not because
-				       // it is used as a key in H.
-
-    typedef std::vector<scc> scc_map_type;
+    struct todo_item
+    {
+      const spot::state* s;
+      int num;
+      tgba_succ_iterator* it;
+    };
+    std::vector<todo_item> todo_; // DFS stack.  Holds (STATE, NUM,
+				  // ITERATOR) triplets where NUM is
+				  // the number of STATE in H and
+				  // ITERATOR is an iterator over
+				  // the successors of STATE.
+				  // ITERATOR should always be
+				  // freed when TODO is popped,
+				  // but STATE should not because
+				  // it is used as a key in H.
+
+    std::vector<bdd> conds_;	// Conditions, by number.
+    Sgi::hash_map<int, unsigned> cond_num_; // Number of each
+					    // condition, indexed by
+					    // BDD id.
+
+    typedef std::deque<scc> scc_map_type;
     scc_map_type scc_map_; // Map of constructed maximal SCC.
 			   // SCC number "n" in H_ corresponds to entry
                            // "n" in SCC_MAP_.
@@ -22,6 +22,8 @@
 #include "tgba/tgbaexplicit.hh"
 #include "reachiter.hh"
 #include "tgbaalgos/scc.hh"
+#include "misc/hash.hh"
+#include "misc/casts.hh"
 #include <sstream>
 
 namespace spot
@@ -41,22 +43,6 @@ namespace spot
       return out_aut->create_transition(in_name.str(), out_name.str());
     }
 
-    static
-    tgba_explicit::transition*
-    create_transition(const tgba* aut, tgba_explicit_formula* out_aut,
-		      const state* in_s, int, const state* out_s, int)
-    {
-      const tgba_explicit_formula* a =
-	static_cast<const tgba_explicit_formula*>(aut);
-      const ltl::formula* in_f = a->get_label(in_s);
-      const ltl::formula* out_f = a->get_label(out_s);
-      if (!out_aut->has_state(in_f))
-	in_f->clone();
-      if ((in_f != out_f) && !out_aut->has_state(out_f))
-	out_f->clone();
-      return out_aut->create_transition(in_f, out_f);
-    }
-
     template<class T>
     class filter_iter: public tgba_reachable_iterator_depth_first
     {
@@ -121,6 +107,87 @@ namespace spot
       bool all_;
     };
 
+    // Same as filter_iter, but for a tgba_explicit_formula, whose
+    // states can be kept with their labels: walk the transitions of
+    // the useful states of the explicit automaton directly.  This
+    // saves the successor iterators, the reachability map, and the
+    // label and SCC lookups done for both ends of each transition.
+    tgba_explicit_formula*
+    filter_explicit(const tgba_explicit_formula* aut,
+		    const scc_map& sm,
+		    const std::vector<bool>& useless,
+		    bdd useful, bdd strip, bool remove_all_useless)
+    {
+      tgba_explicit_formula* out =
+	new tgba_explicit_formula(aut->get_dict());
+      out->set_acceptance_conditions(useful);
+
+      // The language is empty: output no state, like filter_iter.
+      if (useless[sm.initial()])
+	return out;
+
+      // Output state and SCC of each useful input state.  All
+      // useful states are reachable from the initial state through
+      // useful states only.
+      typedef std::pair<tgba_explicit::state*, unsigned> out_scc;
+      typedef Sgi::hash_map<const state*, out_scc,
+			    ptr_hash<state> > state_map;
+      state_map sm2out;
+
+      // Create the initial state first, so that it remains initial.
+      {
+	const state* init = aut->get_init_state();
+	const ltl::formula* f = aut->get_label(init);
+	f->clone();
+	sm2out[init] = out_scc(out->add_state(f), sm.initial());
+	init->destroy();
+      }
+      unsigned scc_count = sm.scc_count();
+      for (unsigned n = 0; n < scc_count; ++n)
+	{
+	  if (useless[n])
+	    continue;
+	  const std::vector<const state*>& st = sm.states_of(n);
+	  std::vector<const state*>::const_iterator i;
+	  for (i = st.begin(); i != st.end(); ++i)
+	    {
+	      out_scc& o = sm2out[*i];
+	      if (o.first)
+		continue;	// The initial state.
+	      const ltl::formula* f = aut->get_label(*i);
+	      f->clone();
+	      o.first = out->add_state(f);
+	      o.second = n;
+	    }
+	}
+
+      state_map::const_iterator i;
+      for (i = sm2out.begin(); i != sm2out.end(); ++i)
+	{
+	  const state_explicit* src =
+	    down_cast<const state_explicit*>(i->first);
+	  tgba_explicit::state* out_src = i->second.first;
+	  unsigned src_scc = i->second.second;
+	  state_explicit::transitions_t::const_iterator t;
+	  for (t = src->successors.begin(); t != src->successors.end(); ++t)
+	    {
+	      state_map::const_iterator d = sm2out.find(t->dest);
+	      if (d == sm2out.end())
+		continue;	// Useless destination.
+	      tgba_explicit::transition* ot =
+		out->create_transition(out_src, d->second.first);
+	      out->add_conditions(ot, t->condition);
+	      // See filter_iter::process_link().
+	      unsigned u = d->second.second;
+	      if (sm.accepting(u)
+		  && (!remove_all_useless || u == src_scc))
+		out->add_acceptance_conditions
+		  (ot, bdd_exist(t->acceptance_conditions, strip) & useful);
+	    }
+	}
+      return out;
+    }
+
   } // anonymous
 
 
@@ -167,11 +234,9 @@ namespace spot
       dynamic_cast<const tgba_explicit_formula*>(aut);
     if (af)
       {
-	filter_iter<tgba_explicit_formula> fi(af, sm, ss.useless_scc_map,
-					      useful, strip,
-					      remove_all_useless);
-	fi.run();
-	tgba_explicit_formula* res = fi.result();
+	tgba_explicit_formula* res =
+	  filter_explicit(af, sm, ss.useless_scc_map, useful, strip,
+			  remove_all_useless);
 	res->merge_transitions();
 	return res;
       }
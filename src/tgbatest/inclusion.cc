@@ -0,0 +1,294 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+// Check language inclusion between the translations of LTL formulae
+// with check_inclusion(), and compare the answer with the emptiness
+// of the product of the first automaton with the translation of the
+// negation of the second.
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+#include "ltlast/allnodes.hh"
+#include "ltlenv/defaultenv.hh"
+#include "ltlparse/public.hh"
+#include "ltlvisit/randomltl.hh"
+#include "ltlvisit/tostring.hh"
+#include "misc/random.hh"
+#include "misc/timer.hh"
+#include "tgba/tgbaexplicit.hh"
+#include "tgba/tgbakvcomplement.hh"
+#include "tgba/tgbaproduct.hh"
+#include "tgbaalgos/emptiness.hh"
+#include "tgbaalgos/gtec/gtec.hh"
+#include "tgbaalgos/inclusion.hh"
+#include "tgbaalgos/ltl2tgba_fm.hh"
+
+namespace
+{
+  void
+  syntax(char* prog)
+  {
+    std::cerr << "Usage: " << prog << " [OPTIONS...] [F G]" << std::endl
+	      << std::endl
+	      << "Check whether the language of F is included in that of G,"
+	      << std::endl
+	      << "or do so for random formulae if F and G are omitted."
+	      << std::endl << std::endl
+	      << "Options:" << std::endl
+	      << "  -a N    number of atomic propositions [3]" << std::endl
+	      << "  -f N    size of random formulae [10]" << std::endl
+	      << "  -kv     check inclusion through the product with "
+	      << "tgba_kv_complement" << std::endl
+	      << "  -r N    number of random pairs of formulae [0]"
+	      << std::endl
+	      << "  -s N    seed for the random number generator [0]"
+	      << std::endl
+	      << "  -v      print each pair of formulae and the answer"
+	      << std::endl;
+    exit(2);
+  }
+
+  int
+  to_int(const char* s)
+  {
+    char* endptr;
+    int res = strtol(s, &endptr, 10);
+    if (*endptr || res < 0)
+      {
+	std::cerr << "Failed to parse `" << s << "' as a positive integer."
+		  << std::endl;
+	exit(2);
+      }
+    return res;
+  }
+
+  bool
+  is_empty(const spot::tgba* a)
+  {
+    spot::emptiness_check* ec = spot::couvreur99(a);
+    spot::emptiness_check_result* res = ec->check();
+    bool empty = !res;
+    delete res;
+    delete ec;
+    return empty;
+  }
+
+  // The automaton recognizing the words compatible with RUN.
+  spot::tgba*
+  lasso(spot::bdd_dict* dict, const spot::tgba_run* run)
+  {
+    spot::tgba_explicit_number* res = new spot::tgba_explicit_number(dict);
+    int n = 0;
+    spot::tgba_run::steps::const_iterator i;
+    for (i = run->prefix.begin(); i != run->prefix.end(); ++i, ++n)
+      res->add_conditions(res->create_transition(n, n + 1), i->label);
+    int loop = n;
+    for (i = run->cycle.begin(); i != run->cycle.end(); ++n)
+      {
+	bdd label = i->label;
+	++i;
+	int dst = i == run->cycle.end() ? loop : n + 1;
+	res->add_conditions(res->create_transition(n, dst), label);
+      }
+    return res;
+  }
+
+  // Check L(F) <= L(G), and return false if something is wrong.
+  bool
+  check(spot::bdd_dict* dict, const spot::ltl::formula* f,
+	const spot::ltl::formula* g, bool kv, spot::timer& t,
+	bool verbose)
+  {
+    spot::tgba* af = spot::ltl_to_tgba_fm(f, dict);
+    spot::tgba* ag = spot::ltl_to_tgba_fm(g, dict);
+    spot::ltl::formula* ng =
+      spot::ltl::unop::instance(spot::ltl::unop::Not, g->clone());
+    spot::tgba* ang = spot::ltl_to_tgba_fm(ng, dict);
+    ng->destroy();
+
+    bool included;
+    spot::tgba_run* run = 0;
+    t.start();
+    if (kv)
+      {
+	spot::tgba* c = new spot::tgba_kv_complement(ag);
+	spot::tgba* p = new spot::tgba_product(af, c);
+	included = is_empty(p);
+	delete p;
+	delete c;
+      }
+    else
+      {
+	run = spot::check_inclusion(af, ag);
+	included = !run;
+      }
+    t.stop();
+
+    bool ok = true;
+    bool expected;
+    {
+      spot::tgba_product p(af, ang);
+      expected = is_empty(&p);
+    }
+    if (included != expected)
+      {
+	std::cerr << "inclusion of " << spot::ltl::to_string(f)
+		  << " in " << spot::ltl::to_string(g) << " should be "
+		  << (expected ? "true" : "false") << std::endl;
+	ok = false;
+      }
+    if (run)
+      {
+	// Some word of the counterexample must be accepted by F, and
+	// all of them must be rejected by G.
+	spot::tgba* l = lasso(dict, run);
+	{
+	  spot::tgba_product p(l, af);
+	  if (is_empty(&p))
+	    {
+	      std::cerr << "counterexample is rejected by "
+			<< spot::ltl::to_string(f) << std::endl;
+	      ok = false;
+	    }
+	}
+	{
+	  spot::tgba_product p(l, ag);
+	  if (!is_empty(&p))
+	    {
+	      std::cerr << "counterexample is accepted by "
+			<< spot::ltl::to_string(g) << std::endl;
+	      ok = false;
+	    }
+	}
+	delete l;
+	delete run;
+      }
+    if (verbose)
+      std::cout << spot::ltl::to_string(f) << " <= "
+		<< spot::ltl::to_string(g) << ": "
+		<< (included ? "included" : "not included") << std::endl;
+
+    delete ang;
+    delete ag;
+    delete af;
+    return ok;
+  }
+}
+
+int
+main(int argc, char** argv)
+{
+  int opt_a = 3;
+  int opt_f = 10;
+  int opt_r = 0;
+  int opt_s = 0;
+  bool opt_kv = false;
+  bool opt_v = false;
+  const char* fs = 0;
+  const char* gs = 0;
+
+  for (int argn = 1; argn < argc; ++argn)
+    {
+      if (!strcmp(argv[argn], "-a") && argn + 1 < argc)
+	opt_a = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-f") && argn + 1 < argc)
+	opt_f = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-kv"))
+	opt_kv = true;
+      else if (!strcmp(argv[argn], "-r") && argn + 1 < argc)
+	opt_r = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-s") && argn + 1 < argc)
+	opt_s = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-v"))
+	opt_v = true;
+      else if (*argv[argn] == '-' || gs)
+	syntax(argv[0]);
+      else if (fs)
+	gs = argv[argn];
+      else
+	fs = argv[argn];
+    }
+  if (fs ? !gs : !opt_r)
+    syntax(argv[0]);
+
+  spot::bdd_dict* dict = new spot::bdd_dict();
+  spot::timer t;
+  bool ok = true;
+
+  if (fs)
+    {
+      spot::ltl::parse_error_list pel;
+      spot::ltl::formula* f = spot::ltl::parse(fs, pel);
+      if (spot::ltl::format_parse_errors(std::cerr, fs, pel))
+	return 2;
+      spot::ltl::formula* g = spot::ltl::parse(gs, pel);
+      if (spot::ltl::format_parse_errors(std::cerr, gs, pel))
+	return 2;
+      ok = check(dict, f, g, opt_kv, t, true);
+      f->destroy();
+      g->destroy();
+    }
+  else
+    {
+      spot::ltl::environment& env =
+	spot::ltl::default_environment::instance();
+      spot::ltl::atomic_prop_set ap;
+      for (int i = 0; i < opt_a; ++i)
+	{
+	  char buf[20];
+	  sprintf(buf, "p%d", i);
+	  ap.insert(static_cast<spot::ltl::atomic_prop*>(env.require(buf)));
+	}
+      spot::ltl::random_ltl rl(&ap);
+      spot::srand(opt_s);
+      for (int i = 0; i < opt_r; ++i)
+	{
+	  spot::ltl::formula* f = rl.generate(opt_f);
+	  spot::ltl::formula* g = rl.generate(opt_f);
+	  // Besides the random pair, check two inclusions that hold.
+	  spot::ltl::formula* fg =
+	    spot::ltl::multop::instance(spot::ltl::multop::And,
+					f->clone(), g->clone());
+	  spot::ltl::formula* forg =
+	    spot::ltl::multop::instance(spot::ltl::multop::Or,
+					f->clone(), g->clone());
+	  ok &= check(dict, f, g, opt_kv, t, opt_v);
+	  ok &= check(dict, fg, f, opt_kv, t, opt_v);
+	  ok &= check(dict, f, forg, opt_kv, t, opt_v);
+	  f->destroy();
+	  g->destroy();
+	  fg->destroy();
+	  forg->destroy();
+	}
+      for (spot::ltl::atomic_prop_set::iterator i = ap.begin();
+	   i != ap.end(); ++i)
+	(*i)->destroy();
+      std::cout << 3 * opt_r << " inclusions checked in "
+		<< double(t.utime() + t.stime()) / sysconf(_SC_CLK_TCK)
+		<< " s" << std::endl;
+    }
+
+  delete dict;
+  return !ok;
+}
@@ -20,27 +20,127 @@
 
 #include <iostream>
 #include "misc/intvcmp2.hh"
+#include "misc/hasharray.hh"
+#include "misc/simd.hh"
+#include "misc/random.hh"
 #include <cstring>
 
 
-int check_aa(int* data, int size, unsigned expected = 0)
+// The vectorized code paths should give exactly the same results as
+// the scalar one.
+int check_simd(int* data, int size, const int* comp, size_t csize)
 {
+  int res = 0;
+  int* comp2 = new int[size * 2];
+  int* decomp = new int[size + 30];
+
+  for (int l = spot::simd_sse41; l <= spot::simd_avx2; ++l)
+    {
+      spot::simd_level level = static_cast<spot::simd_level>(l);
+      if (spot::set_simd_level(level) != level)
+	break;
+      const char* name = spot::simd_level_name(level);
+
+      size_t csize2 = size * 2;
+      spot::int_array_array_compress2(data, size, comp2, csize2);
+      if (csize2 != csize || memcmp(comp, comp2, csize * sizeof(int)))
+	{
+	  std::cout << "*** " << name << " compression error ***"
+		    << std::endl;
+	  res = 1;
+	}
+
+      spot::int_array_array_decompress2(comp, csize, decomp, size);
+      if (memcmp(data, decomp, size * sizeof(int)))
+	{
+	  std::cout << "*** " << name << " decompression error ***"
+		    << std::endl;
+	  res = 1;
+	}
+    }
+  spot::set_simd_level(spot::simd_none);
+
+  delete[] comp2;
+  delete[] decomp;
+  return res;
+}
+
+// Change each value of DATA in turn (and a later one), and check
+// that incremental compression and hashing give the same results as
+// compressing and hashing from scratch.
+int check_delta(int* data, int size, const int* comp, size_t csize)
+{
+  int res = 0;
+  int* changed = new int[size];
+  int* comp2 = new int[size * 2];
+  int* comp3 = new int[size * 2];
+  unsigned hash = spot::wang32_sum_hash_array(data, size);
+
+  for (int i = 0; i <= size; ++i)
+    {
+      memcpy(changed, data, size * sizeof(int));
+      unsigned hash2 = hash;
+      for (int j = i; j < size; j += 7 + i)
+	{
+	  int val = data[j] ? 0 : 1 + (j % 3) * 200;
+	  changed[j] = val;
+	  hash2 += (spot::wang32_slot_hash(j, val)
+		    - spot::wang32_slot_hash(j, data[j]));
+	}
+
+      size_t csize2 = size * 2;
+      spot::int_array_array_compress2(changed, size, comp2, csize2);
+      size_t csize3 = size * 2;
+      spot::int_array_array_recompress2(changed, size, i, comp, csize,
+					comp3, csize3);
+      if (csize2 != csize3 || memcmp(comp2, comp3, csize2 * sizeof(int)))
+	{
+	  std::cout << "*** recompression error *** (change at " << i
+		    << ")" << std::endl;
+	  res = 1;
+	  break;
+	}
+      if (hash2 != spot::wang32_sum_hash_array(changed, size))
+	{
+	  std::cout << "*** incremental hash error *** (change at " << i
+		    << ")" << std::endl;
+	  res = 1;
+	  break;
+	}
+    }
+
+  delete[] changed;
+  delete[] comp2;
+  delete[] comp3;
+  return res;
+}
+
+int check_aa(int* data, int size, unsigned expected = 0, bool verbose = true)
+{
+  spot::set_simd_level(spot::simd_none);
+
   int* comp = new int[size * 2];
   size_t csize = size * 2;
   spot::int_array_array_compress2(data, size, comp, csize);
 
-  std::cout << "AC[" << csize << "] ";
-  for (size_t i = 0; i < csize; ++i)
-    std::cout << comp[i] << " ";
-  std::cout << std::endl;
+  if (verbose)
+    {
+      std::cout << "AC[" << csize << "] ";
+      for (size_t i = 0; i < csize; ++i)
+	std::cout << comp[i] << " ";
+      std::cout << std::endl;
+    }
 
   int* decomp = new int[size + 30];
   spot::int_array_array_decompress2(comp, csize, decomp, size);
 
-  std::cout << "AD[" << size << "] ";
-  for (int i = 0; i < size; ++i)
-    std::cout << decomp[i] << " ";
-  std::cout << std::endl;
+  if (verbose)
+    {
+      std::cout << "AD[" << size << "] ";
+      for (int i = 0; i < size; ++i)
+	std::cout << decomp[i] << " ";
+      std::cout << std::endl;
+    }
 
   int res = memcmp(data, decomp, size * sizeof(int));
 
@@ -61,7 +161,11 @@ int check_aa(int* data, int size, unsigned expected = 0)
       res = 1;
     }
 
-  std::cout << std::endl;
+  res |= check_simd(data, size, comp, csize);
+  res |= check_delta(data, size, comp, csize);
+
+  if (verbose)
+    std::cout << std::endl;
 
   delete[] comp;
   delete[] decomp;
@@ -127,5 +231,34 @@ int main()
 		   0, 0, 0, 0, 0, 0, 0, 0, 9 };
   errors += check(comp10, sizeof(comp10) / sizeof(*comp10));
 
+  // Thirty 1-bit values.  (The eighth used to be stored at the
+  // position of the tenth.)
+  int comp11[] = { 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+  errors += check(comp11, sizeof(comp11) / sizeof(*comp11));
+
+  // Six values that fit in 5 bits, except the last one.  (This used
+  // to encode 1000 on 5 bits.)
+  int comp12[] = { 1, 1, 1, 1, 1, 1000, 1, 1, 1, 1, 1 };
+  errors += check(comp12, sizeof(comp12) / sizeof(*comp12));
+
+  // Random arrays of values of various widths.
+  spot::srand(0);
+  for (int n = 0; n < 200; ++n)
+    {
+      int size = spot::rrand(1, 300);
+      int* data = new int[size];
+      int width = spot::rrand(0, 10);
+      for (int i = 0; i < size; ++i)
+	{
+	  data[i] = spot::mrand(2);
+	  // A few values are wider.
+	  if (spot::mrand(8) == 0)
+	    data[i] = spot::mrand(1 << (width * 27 / 10 + 1));
+	}
+      errors += check_aa(data, size, 0, false);
+      delete[] data;
+    }
+
   return errors;
 }
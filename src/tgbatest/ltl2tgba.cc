@@ -28,6 +28,8 @@
 #include <string>
 #include <cstdlib>
 #include "ltlvisit/contain.hh"
+#include "ltlvisit/reduce.hh"
+#include "ltlvisit/reducecache.hh"
 #include "ltlvisit/tostring.hh"
 #include "ltlvisit/apcollect.hh"
 #include "ltlast/allnodes.hh"
@@ -44,9 +46,11 @@
 #include "tgba/tgbaproduct.hh"
 #include "tgba/futurecondcol.hh"
 #include "tgbaalgos/reducerun.hh"
+#include "tgbaalgos/compactrun.hh"
 #include "tgbaparse/public.hh"
 #include "neverparse/public.hh"
 #include "tgbaalgos/dupexp.hh"
+#include "tgbaalgos/degen.hh"
 #include "tgbaalgos/minimize.hh"
 #include "tgbaalgos/neverclaim.hh"
 #include "tgbaalgos/reductgba_sim.hh"
@@ -57,7 +61,9 @@
 #include "tgbaalgos/eltl2tgba_lacim.hh"
 #include "tgbaalgos/gtec/gtec.hh"
 #include "eltlparse/public.hh"
+#include "misc/arena.hh"
 #include "misc/timer.hh"
+#include "misc/perfreport.hh"
 
 #include "tgbaalgos/stats.hh"
 #include "tgbaalgos/scc.hh"
@@ -136,6 +142,9 @@ syntax(char* prog)
 	    << "  -fr5  use -r5 (see below) at each step of FM" << std::endl
 	    << "  -fr6  use -r6 (see below) at each step of FM" << std::endl
 	    << "  -fr7  use -r7 (see below) at each step of FM" << std::endl
+	    << "  -fw   enumerate transitions by walking BDDs instead of "
+	    << "computing" << std::endl
+	    << "        prime implicants (implies -f)" << std::endl
             << "  -L    fair-loop approximation (implies -f)" << std::endl
             << "  -p    branching postponement (implies -f)" << std::endl
             << "  -U[PROPS]  consider atomic properties of the formula as "
@@ -180,6 +189,9 @@ syntax(char* prog)
 	    << "  -r5   reduce formula using tau03" << std::endl
 	    << "  -r6   reduce formula using tau03+" << std::endl
 	    << "  -r7   reduce formula using tau03+ and -r4" << std::endl
+	    << "  -rcfile  keep the containment checks of -r5, -r6, and -r7"
+	    << std::endl
+	    << "           in `file' for later runs" << std::endl
 	    << "  -rd   display the reduced formula" << std::endl
 	    << std::endl
 
@@ -189,6 +201,10 @@ syntax(char* prog)
 	    << "(SGBA)" << std::endl
 	    << "  -D    degeneralize the automaton as a TBA" << std::endl
 	    << "  -DS   degeneralize the automaton as an SBA" << std::endl
+	    << "  -DE   degeneralize the automaton as an explicit TBA"
+	    << std::endl
+	    << "  -DSE  degeneralize the automaton as an explicit SBA"
+	    << std::endl
 	    << std::endl
 
 	    << "Automaton simplifications (after translation):"
@@ -207,6 +223,10 @@ syntax(char* prog)
 	    << "          "
 	    << "(prefer -R3 over -R3f if you degeneralize with -D, -DS, or -N)"
 	    << std::endl
+	    << "  -Rs   compute the simulation of -R1q, -R1t, -R2q, and -R2t by"
+	    << std::endl
+	    << "          signature refinement instead of a parity game"
+	    << std::endl
 	    << "  -Rd   display the simulation relation" << std::endl
 	    << "  -RD   display the parity game (dot format)" << std::endl
             << "  -Rm   attempt to minimize the automata" << std::endl
@@ -230,12 +250,20 @@ syntax(char* prog)
 	    << std::endl
 	    << "  -CR   compute and replay an accepting run (implies -C)"
 	    << std::endl
+	    << "  -CC   compute an accepting run, and print it from its "
+	    << "compact form (implies -C)" << std::endl
 	    << "  -g    graph the accepting run on the automaton (requires -e)"
 	    << std::endl
 	    << "  -G    graph the accepting run seen as an automaton "
 	    << " (requires -e)" << std::endl
 	    << "  -m    try to reduce accepting runs, in a second pass"
 	    << std::endl
+	    << "  -arena  allocate the states and iterators of the product "
+	    << "with -P in an" << std::endl
+	    << "        arena, released at once (requires an explicit "
+	    << "automaton: not -l," << std::endl
+	    << "        -le, -taa, or -lS, unless with -s or -S)"
+	    << std::endl
 	    << "Where ALGO should be one of:" << std::endl
 	    << "  Cou99(OPTIONS) (the default)" << std::endl
 	    << "  CVWY90(OPTIONS)" << std::endl
@@ -281,6 +309,12 @@ syntax(char* prog)
 	    << "  -d    turn on traces during parsing" << std::endl
             << "  -T    time the different phases of the translation"
 	    << std::endl
+	    << "  -JFILE  write a JSON performance report to FILE"
+	    << std::endl
+	    << "  -W[SECS]  report the progress of the emptiness check on "
+	    << "stderr every SECS" << std::endl
+	    << "        seconds (10 by default, 0 for never) and on SIGUSR1"
+	    << std::endl
 	    << "  -v    display the BDD variables used by the automaton"
 	    << std::endl;
   exit(2);
@@ -294,12 +328,14 @@ main(int argc, char** argv)
   bool debug_opt = false;
   bool paper_opt = false;
   enum { NoDegen, DegenTBA, DegenSBA } degeneralize_opt = NoDegen;
+  bool degeneralize_explicit = false;
   enum { TransitionLabeled, StateLabeled } labeling_opt = TransitionLabeled;
   enum { TransFM, TransLaCIM, TransLaCIM_ELTL, TransLaCIM_ELTL_ops, TransTAA }
     translation = TransFM;
   int fm_red = spot::ltl::Reduce_None;
   bool fm_exprop_opt = false;
   bool fm_symb_merge_opt = true;
+  bool fm_bdd_walk = false;
   bool file_opt = false;
   int output = 0;
   int formula_index = 0;
@@ -309,13 +345,16 @@ main(int argc, char** argv)
   bool expect_counter_example = false;
   bool accepting_run = false;
   bool accepting_run_replay = false;
+  bool accepting_run_compact = false;
   bool from_file = false;
   bool read_neverclaim = false;
   int reduc_aut = spot::Reduce_None;
+  bool sim_signature = false;
   int redopt = spot::ltl::Reduce_None;
   bool scc_filter_all = false;
   bool symbolic_scc_pruning = false;
   bool display_reduce_form = false;
+  const char* containment_cache = 0;
   bool display_rel_sim = false;
   bool display_parity_game = false;
   bool post_branching = false;
@@ -333,9 +372,13 @@ main(int argc, char** argv)
   spot::tgba_explicit_string* system = 0;
   const spot::tgba* product = 0;
   const spot::tgba* product_to_free = 0;
+  bool use_arena = false;
   spot::bdd_dict* dict = new spot::bdd_dict();
   spot::timer_map tm;
   bool use_timer = false;
+  const char* json_file = 0;
+  spot::perf_report report("ltl2tgba");
+  const char* progress_interval = 0;
   bool assume_sba = false;
 
   for (;;)
@@ -357,6 +400,10 @@ main(int argc, char** argv)
 	{
 	  output = 4;
 	}
+      else if (!strcmp(argv[formula_index], "-arena"))
+	{
+	  use_arena = true;
+	}
       else if (!strcmp(argv[formula_index], "-b"))
 	{
 	  output = 7;
@@ -375,6 +422,11 @@ main(int argc, char** argv)
 	  accepting_run = true;
 	  accepting_run_replay = true;
 	}
+      else if (!strcmp(argv[formula_index], "-CC"))
+	{
+	  accepting_run = true;
+	  accepting_run_compact = true;
+	}
       else if (!strcmp(argv[formula_index], "-d"))
 	{
 	  debug_opt = true;
@@ -387,6 +439,16 @@ main(int argc, char** argv)
 	{
 	  degeneralize_opt = DegenSBA;
 	}
+      else if (!strcmp(argv[formula_index], "-DE"))
+	{
+	  degeneralize_opt = DegenTBA;
+	  degeneralize_explicit = true;
+	}
+      else if (!strcmp(argv[formula_index], "-DSE"))
+	{
+	  degeneralize_opt = DegenSBA;
+	  degeneralize_explicit = true;
+	}
       else if (!strncmp(argv[formula_index], "-e", 2))
         {
 	  echeck_algo = 2 + argv[formula_index];
@@ -516,6 +578,11 @@ main(int argc, char** argv)
 	{
 	  translation = TransLaCIM_ELTL_ops;
 	}
+      else if (!strcmp(argv[formula_index], "-fw"))
+	{
+	  translation = TransFM;
+	  fm_bdd_walk = true;
+	}
       else if (!strcmp(argv[formula_index], "-L"))
 	{
 	  fair_loop_approx = true;
@@ -631,10 +698,19 @@ main(int argc, char** argv)
 	{
 	  symbolic_scc_pruning = true;
 	}
+      else if (!strncmp(argv[formula_index], "-rc", 3)
+	       && argv[formula_index][3])
+	{
+	  containment_cache = argv[formula_index] + 3;
+	}
       else if (!strcmp(argv[formula_index], "-rd"))
 	{
 	  display_reduce_form = true;
 	}
+      else if (!strcmp(argv[formula_index], "-Rs"))
+	{
+	  sim_signature = true;
+	}
       else if (!strcmp(argv[formula_index], "-Rd"))
 	{
 	  display_rel_sim = true;
@@ -667,6 +743,16 @@ main(int argc, char** argv)
 	{
 	  use_timer = true;
 	}
+      else if (!strncmp(argv[formula_index], "-J", 2))
+	{
+	  json_file = argv[formula_index] + 2;
+	  if (!*json_file)
+	    syntax(argv[0]);
+	}
+      else if (!strncmp(argv[formula_index], "-W", 2))
+	{
+	  progress_interval = argv[formula_index] + 2;
+	}
       else if (!strcmp(argv[formula_index], "-taa"))
 	{
 	  translation = TransTAA;
@@ -841,9 +927,29 @@ main(int argc, char** argv)
 	  if (redopt != spot::ltl::Reduce_None)
 	    {
 	      tm.start("reducing formula");
-	      spot::ltl::formula* t = spot::ltl::reduce(f, redopt);
+	      spot::ltl::reduce_cache rc;
+	      spot::bdd_dict lcc_dict;
+	      spot::ltl::language_containment_checker lcc(&lcc_dict,
+							  true, true,
+							  false, false);
+	      if (containment_cache)
+		{
+		  if (!lcc.use_cache_file(containment_cache))
+		    {
+		      std::cerr << "Cannot write " << containment_cache
+				<< std::endl;
+		      exit(2);
+		    }
+		  rc.set_containment_checker(&lcc);
+		}
+	      spot::ltl::formula* t = spot::ltl::reduce(f, redopt, &rc);
 	      f->destroy();
 	      tm.stop("reducing formula");
+	      if (containment_cache && use_timer)
+		std::cout << "containment checks: " << lcc.hits()
+			  << " hits (" << lcc.file_hits() << " from "
+			  << containment_cache << "), " << lcc.misses()
+			  << " misses" << std::endl;
 	      f = t;
 	      if (display_reduce_form)
 		std::cout << spot::ltl::to_string(f) << std::endl;
@@ -858,7 +964,7 @@ main(int argc, char** argv)
 				       post_branching,
 				       fair_loop_approx,
 				       unobservables,
-				       fm_red);
+				       fm_red, fm_bdd_walk);
 	      break;
 	    case TransTAA:
 	      a = spot::ltl_to_taa(f, dict, containment);
@@ -916,9 +1022,16 @@ main(int argc, char** argv)
 	  tm.stop("reducing A_f w/ SCC");
 	}
 
-      const spot::tgba_tba_proxy* degeneralized = 0;
+      const spot::tgba* degeneralized = 0;
       const spot::tgba_sgba_proxy* state_labeled = 0;
 
+      // Open the arena before degeneralizing A, so that the states
+      // of the degeneralization proxy are allocated from it too.
+      spot::arena_scope* arena = 0;
+      if (system && use_arena)
+	arena = new spot::arena_scope;
+      const spot::tgba* undegeneralized = a;
+
       unsigned int n_acc = a->number_of_acceptance_conditions();
       if (echeck_inst
 	  && degeneralize_opt == NoDegen
@@ -926,7 +1039,15 @@ main(int argc, char** argv)
 	  && echeck_inst->max_acceptance_conditions() < n_acc)
 	degeneralize_opt = DegenTBA;
 
-      if (degeneralize_opt == DegenTBA)
+      if (degeneralize_explicit && degeneralize_opt != NoDegen)
+	{
+	  tm.start("degeneralization");
+	  a = degeneralized =
+	    spot::degeneralize(a, degeneralize_opt == DegenSBA);
+	  tm.stop("degeneralization");
+	  assume_sba = degeneralize_opt == DegenSBA;
+	}
+      else if (degeneralize_opt == DegenTBA)
 	{
 	  a = degeneralized = new spot::tgba_tba_proxy(a);
 	}
@@ -947,17 +1068,7 @@ main(int argc, char** argv)
 	  minimized = minimize_obligation(a, f);
 	  tm.stop("obligation minimization");
 
-	  if (minimized == 0)
-	    {
-	      // if (!f)
-		{
-		  std::cerr << "Error: Without a formula I cannot make "
-			    << "sure that the automaton built with -Rm\n"
-			    << "       is correct." << std::endl;
-		  exit(2);
-		}
-	    }
-	  else if (minimized == a)
+	  if (minimized == a)
 	    {
 	      minimized = 0;
 	    }
@@ -997,17 +1108,23 @@ main(int argc, char** argv)
 		  if (reduc_aut & (spot::Reduce_quotient_Dir_Sim |
 				   spot::Reduce_transition_Dir_Sim))
 		    {
-		      rel_dir =
-			spot::get_direct_relation_simulation
-			  (a, std::cout, display_parity_game);
+		      if (sim_signature)
+			rel_dir = spot::get_direct_relation_simulation_sig(a);
+		      else
+			rel_dir =
+			  spot::get_direct_relation_simulation
+			    (a, std::cout, display_parity_game);
 		      assert(rel_dir);
 		    }
 		  if (reduc_aut & (spot::Reduce_quotient_Del_Sim |
 					spot::Reduce_transition_Del_Sim))
 		    {
-		      rel_del =
-			spot::get_delayed_relation_simulation
-			  (a, std::cout, display_parity_game);
+		      if (sim_signature)
+			rel_del = spot::get_delayed_relation_simulation_sig(a);
+		      else
+			rel_del =
+			  spot::get_delayed_relation_simulation
+			    (a, std::cout, display_parity_game);
 		      assert(rel_del);
 		    }
 
@@ -1054,6 +1171,24 @@ main(int argc, char** argv)
 
       if (system)
         {
+	  // The states of the product own those of A, and the
+	  // emptiness checks do not destroy them in an arena.  This is
+	  // only safe if they own nothing, as the explicit states and
+	  // the states of a degeneralization proxy of explicit states
+	  // allocated in the arena.
+	  if (arena
+	      && !dynamic_cast<const spot::tgba_explicit*>(a)
+	      && !(a == degeneralized && !degeneralize_explicit
+		   && dynamic_cast<const spot::tgba_explicit*>
+		   (undegeneralized)))
+	    {
+	      std::cerr << ("Error: -arena requires an explicit "
+			    "automaton.\n"
+			    "       Do not use -l, -le, -taa, or -lS, "
+			    "or use -s or -S.")
+			<< std::endl;
+	      exit(2);
+	    }
           a = product = product_to_free = new spot::tgba_product(system, a);
 
 	  assume_sba = false;
@@ -1217,11 +1352,38 @@ main(int argc, char** argv)
 	  spot::emptiness_check* ec = echeck_inst->instantiate(a);
 	  bool search_many = echeck_inst->options().get("repeated");
 	  assert(ec);
+	  spot::ec_progress_printer progress(std::cerr);
+	  if (progress_interval)
+	    if (spot::ec_statistics* ecs =
+		dynamic_cast<spot::ec_statistics*>(ec))
+	      {
+		ecs->set_progress(&progress, *progress_interval
+				  ? strtod(progress_interval, 0) : 10.);
+		spot::ec_progress::report_on_sigusr1();
+	      }
+	  // The statistics of each check of a repeated search go to
+	  // their own sections of the JSON report.
+	  unsigned check_num = 0;
+	  std::string ec_section = "emptiness check";
+	  std::string run_section = "accepting run";
 	  do
 	    {
+	      if (search_many)
+		{
+		  ++check_num;
+		  ec_section =
+		    spot::perf_report::numbered_section("emptiness check",
+							check_num);
+		  run_section =
+		    spot::perf_report::numbered_section("accepting run",
+							check_num);
+		}
 	      tm.start("running emptiness check");
 	      spot::emptiness_check_result* res = ec->check();
 	      tm.stop("running emptiness check");
+	      if (json_file)
+		if (const spot::unsigned_statistics* s = ec->statistics())
+		  report.add_stats(ec_section, *s);
 
               if (paper_opt)
                 {
@@ -1308,6 +1470,26 @@ main(int argc, char** argv)
 				exit_code = 1;
 			      tm.stop("replaying acc. run");
 			    }
+			  else if (accepting_run_compact)
+			    {
+			      tm.start("compacting accepting run");
+			      spot::compact_tgba_run* crun =
+				spot::compact_run(a, run);
+			      tm.stop("compacting accepting run");
+			      if (!crun)
+				{
+				  std::cout << "the accepting run is not a run "
+					    << "of the automaton" << std::endl;
+				  exit_code = 1;
+				}
+			      else
+				{
+				  tm.start("printing accepting run");
+				  spot::print_tgba_run(std::cout, a, crun);
+				  tm.stop("printing accepting run");
+				  delete crun;
+				}
+			    }
 			  else
 			    {
 			      tm.start("printing accepting run");
@@ -1339,6 +1521,9 @@ main(int argc, char** argv)
 				<< "(use -C to print it)" << std::endl;
 		    }
                 }
+	      if (json_file && res)
+		if (const spot::unsigned_statistics* s = res->statistics())
+		  report.add_stats(run_section, *s);
 	      delete res;
 	    }
 	  while (search_many);
@@ -1356,6 +1541,7 @@ main(int argc, char** argv)
       delete aut_red;
       delete minimized;
       delete degeneralized;
+      delete arena;
       delete aut_scc;
       delete state_labeled;
       delete to_free;
@@ -1368,6 +1554,16 @@ main(int argc, char** argv)
 
   if (use_timer)
     tm.print(std::cout);
+  if (json_file)
+    {
+      report.add_timers("main", tm);
+      report.add_bdd_stats();
+      if (!report.print_json(json_file))
+	{
+	  std::cerr << "cannot write `" << json_file << "'" << std::endl;
+	  exit_code = 2;
+	}
+    }
 
   if (unobservables)
     {
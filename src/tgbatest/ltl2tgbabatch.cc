@@ -0,0 +1,420 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+// Translate all the LTL formulae of a file in a single process (or
+// in a few worker processes), sharing one bdd_dict and one
+// fm_translator between all formulae of a process.
+
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "ltlast/formula.hh"
+#include "ltlparse/ltlfile.hh"
+#include "ltlvisit/reduce.hh"
+#include "ltlvisit/tostring.hh"
+#include "tgba/bdddict.hh"
+#include "tgbaalgos/ltl2tgba_fm.hh"
+#include "tgbaalgos/save.hh"
+#include "tgbaalgos/stats.hh"
+#include "misc/timer.hh"
+
+namespace
+{
+  struct options
+  {
+    bool exprop;
+    bool symb_merge;
+    bool branching_postponement;
+    bool fair_loop_approx;
+    bool bdd_walk;
+    int reduce_ltl;
+    unsigned flush;
+
+    options()
+      : exprop(false), symb_merge(true), branching_postponement(false),
+	fair_loop_approx(false), bdd_walk(false),
+	reduce_ltl(spot::ltl::Reduce_None), flush(1)
+    {
+    }
+  };
+
+  // The outcome of one translation.
+  struct result
+  {
+    std::string aut;		// tgba_save_reachable() output.
+    clock_t utime;
+    clock_t stime;
+    unsigned states;
+    unsigned transitions;
+  };
+
+  void
+  syntax(char* prog)
+  {
+    std::cerr << "Usage: " << prog << " [OPTIONS...] FILE" << std::endl
+	      << std::endl
+	      << "Translate the LTL formulae of FILE (one per line) with"
+	      << " the FM algorithm, and" << std::endl
+	      << "output the automata in the format of tgba_save_reachable(),"
+	      << " in the order" << std::endl
+	      << "of FILE, separated by empty lines." << std::endl
+	      << std::endl
+	      << "Options:" << std::endl
+	      << "  -c N  forget the state shared between translations"
+	      << " every N formulae" << std::endl
+	      << "          (0 = never) [1]" << std::endl
+	      << "  -fr1 .. -fr7" << std::endl
+	      << "        simplify formulae at each step of FM (see ltl2tgba)"
+	      << std::endl
+	      << "  -fw   walk BDDs instead of computing prime implicants"
+	      << std::endl
+	      << "  -j N  translate with N worker processes [1]" << std::endl
+	      << "  -L    fair-loop approximation" << std::endl
+	      << "  -o F  write the automata to file F instead of"
+	      << " standard output" << std::endl
+	      << "  -p    branching postponement" << std::endl
+	      << "  -T    report the time and size of each translation on"
+	      << " standard error" << std::endl
+	      << "  -x    exprop" << std::endl
+	      << "  -y    do not merge states with same symbolic representation"
+	      << std::endl;
+    exit(2);
+  }
+
+  int
+  to_int_nonneg(const char* s, const char* arg)
+  {
+    char* endptr;
+    int res = strtol(s, &endptr, 10);
+    if (*endptr || res < 0)
+      {
+	std::cerr << "argument of " << arg << " (" << s
+		  << ") must be a nonnegative integer" << std::endl;
+	exit(2);
+      }
+    return res;
+  }
+
+  void
+  translate_one(spot::fm_translator& t, const spot::ltl::formula* f,
+		result& r)
+  {
+    spot::timer tm;
+    tm.start();
+    spot::tgba_explicit* a = t.translate(f);
+    tm.stop();
+    r.utime = tm.utime();
+    r.stime = tm.stime();
+    spot::tgba_statistics s = spot::stats_reachable(a);
+    r.states = s.states;
+    r.transitions = s.transitions;
+    std::ostringstream os;
+    spot::tgba_save_reachable(os, a);
+    r.aut = os.str();
+    delete a;
+  }
+
+  // Translate formulae FIRST, FIRST+STEP, FIRST+2*STEP, ... of FS,
+  // and pass each result to OUT.
+  template <class Output>
+  void
+  translate_range(const std::vector<spot::ltl::formula*>& fs,
+		  unsigned first, unsigned step, const options& o,
+		  Output& out)
+  {
+    spot::bdd_dict dict;
+    {
+      spot::fm_translator t(&dict, o.exprop, o.symb_merge,
+			    o.branching_postponement, o.fair_loop_approx,
+			    0, o.reduce_ltl, o.bdd_walk);
+      unsigned done = 0;
+      for (unsigned i = first; i < fs.size(); i += step)
+	{
+	  if (o.flush && done > 0 && done % o.flush == 0)
+	    t.clear();
+	  result r;
+	  translate_one(t, fs[i], r);
+	  out(i, r);
+	  ++done;
+	}
+    }
+  }
+
+  // Print results to the output stream, and their statistics to
+  // std::cerr when TIMING is set.
+  class printer
+  {
+  public:
+    printer(std::ostream& os, const std::vector<spot::ltl::formula*>& fs,
+	    bool timing)
+      : os_(os), fs_(fs), timing_(timing), utime_(0), stime_(0)
+    {
+    }
+
+    void
+    operator()(unsigned i, const result& r)
+    {
+      if (i > 0)
+	os_ << std::endl;
+      os_ << r.aut;
+      utime_ += r.utime;
+      stime_ += r.stime;
+      if (timing_)
+	{
+	  std::cerr << std::setw(5) << i + 1 << ": "
+		    << std::setw(8) << std::fixed << std::setprecision(2)
+		    << seconds(r.utime + r.stime) << " s, "
+		    << std::setw(6) << r.states << " states, "
+		    << std::setw(7) << r.transitions << " transitions, ";
+	  spot::ltl::to_string(fs_[i], std::cerr) << std::endl;
+	}
+    }
+
+    ~printer()
+    {
+      if (timing_)
+	std::cerr << "total: " << std::fixed << std::setprecision(2)
+		  << seconds(utime_) << " s user, "
+		  << seconds(stime_) << " s system" << std::endl;
+    }
+
+  private:
+    static double
+    seconds(clock_t c)
+    {
+      return double(c) / sysconf(_SC_CLK_TCK);
+    }
+
+    std::ostream& os_;
+    const std::vector<spot::ltl::formula*>& fs_;
+    bool timing_;
+    clock_t utime_;
+    clock_t stime_;
+  };
+
+  // Workers send each result to the parent through a pipe, as a
+  // header line followed by the automaton.
+  class pipe_writer
+  {
+  public:
+    pipe_writer(FILE* f)
+      : f_(f)
+    {
+    }
+
+    void
+    operator()(unsigned, const result& r)
+    {
+      fprintf(f_, "%lu %ld %ld %u %u\n",
+	      static_cast<unsigned long>(r.aut.size()),
+	      static_cast<long>(r.utime), static_cast<long>(r.stime),
+	      r.states, r.transitions);
+      fwrite(r.aut.data(), 1, r.aut.size(), f_);
+    }
+
+  private:
+    FILE* f_;
+  };
+
+  bool
+  read_result(FILE* f, result& r)
+  {
+    unsigned long size;
+    long utime;
+    long stime;
+    if (fscanf(f, "%lu %ld %ld %u %u", &size, &utime, &stime,
+	       &r.states, &r.transitions) != 5
+	|| fgetc(f) != '\n')
+      return false;
+    r.utime = utime;
+    r.stime = stime;
+    r.aut.resize(size);
+    return size == 0 || fread(&r.aut[0], 1, size, f) == size;
+  }
+
+  // Fork JOBS workers, and print their results in the order of FS.
+  // Worker K translates formulae K, K+JOBS, K+2*JOBS, ..., so the
+  // results can be collected by reading the pipes in turn.
+  int
+  run_workers(const std::vector<spot::ltl::formula*>& fs, unsigned jobs,
+	      const options& o, printer& out)
+  {
+    std::vector<FILE*> pipes(jobs);
+    std::vector<pid_t> pids(jobs);
+    std::cout.flush();
+    for (unsigned k = 0; k < jobs; ++k)
+      {
+	int fd[2];
+	if (pipe(fd))
+	  {
+	    perror("pipe");
+	    exit(2);
+	  }
+	pid_t pid = fork();
+	if (pid < 0)
+	  {
+	    perror("fork");
+	    exit(2);
+	  }
+	if (pid == 0)
+	  {
+	    // Worker.  Each process initializes its own BuDDy.
+	    close(fd[0]);
+	    for (unsigned j = 0; j < k; ++j)
+	      fclose(pipes[j]);
+	    FILE* f = fdopen(fd[1], "w");
+	    pipe_writer w(f);
+	    translate_range(fs, k, jobs, o, w);
+	    exit(fclose(f) ? 2 : 0);
+	  }
+	close(fd[1]);
+	pids[k] = pid;
+	pipes[k] = fdopen(fd[0], "r");
+      }
+
+    int exit_code = 0;
+    for (unsigned i = 0; i < fs.size(); ++i)
+      {
+	result r;
+	if (!read_result(pipes[i % jobs], r))
+	  {
+	    std::cerr << "worker " << i % jobs
+		      << " failed to translate formula " << i + 1
+		      << std::endl;
+	    exit_code = 2;
+	    break;
+	  }
+	out(i, r);
+      }
+    for (unsigned k = 0; k < jobs; ++k)
+      {
+	fclose(pipes[k]);
+	int status;
+	while (waitpid(pids[k], &status, 0) < 0 && errno == EINTR)
+	  continue;
+	if (!WIFEXITED(status) || WEXITSTATUS(status))
+	  exit_code = 2;
+      }
+    return exit_code;
+  }
+}
+
+int
+main(int argc, char** argv)
+{
+  options o;
+  unsigned jobs = 1;
+  bool timing = false;
+  const char* output = 0;
+  const char* file = 0;
+
+  for (int argn = 1; argn < argc; ++argn)
+    {
+      const char* arg = argv[argn];
+      if (!strcmp(arg, "-c") && argn + 1 < argc)
+	o.flush = to_int_nonneg(argv[++argn], arg);
+      else if (!strcmp(arg, "-fr1"))
+	o.reduce_ltl |= spot::ltl::Reduce_Basics;
+      else if (!strcmp(arg, "-fr2"))
+	o.reduce_ltl |= spot::ltl::Reduce_Eventuality_And_Universality;
+      else if (!strcmp(arg, "-fr3"))
+	o.reduce_ltl |= spot::ltl::Reduce_Syntactic_Implications;
+      else if (!strcmp(arg, "-fr4"))
+	o.reduce_ltl |= spot::ltl::Reduce_Basics
+	  | spot::ltl::Reduce_Eventuality_And_Universality
+	  | spot::ltl::Reduce_Syntactic_Implications;
+      else if (!strcmp(arg, "-fr5"))
+	o.reduce_ltl |= spot::ltl::Reduce_Containment_Checks;
+      else if (!strcmp(arg, "-fr6"))
+	o.reduce_ltl |= spot::ltl::Reduce_Containment_Checks_Stronger;
+      else if (!strcmp(arg, "-fr7"))
+	o.reduce_ltl |= spot::ltl::Reduce_All;
+      else if (!strcmp(arg, "-fw"))
+	o.bdd_walk = true;
+      else if (!strcmp(arg, "-j") && argn + 1 < argc)
+	jobs = to_int_nonneg(argv[++argn], arg);
+      else if (!strcmp(arg, "-L"))
+	o.fair_loop_approx = true;
+      else if (!strcmp(arg, "-o") && argn + 1 < argc)
+	output = argv[++argn];
+      else if (!strcmp(arg, "-p"))
+	o.branching_postponement = true;
+      else if (!strcmp(arg, "-T"))
+	timing = true;
+      else if (!strcmp(arg, "-x"))
+	o.exprop = true;
+      else if (!strcmp(arg, "-y"))
+	o.symb_merge = false;
+      else if (*arg == '-' || file)
+	syntax(argv[0]);
+      else
+	file = arg;
+    }
+  if (!file || jobs == 0)
+    syntax(argv[0]);
+
+  // Parse everything first, so that workers can share the list.
+  std::vector<spot::ltl::formula*> fs;
+  {
+    spot::ltl::ltl_file formulae(file);
+    spot::ltl::formula* f;
+    while ((f = formulae.next()))
+      fs.push_back(f);
+  }
+
+  std::ofstream* of = 0;
+  if (output)
+    {
+      of = new std::ofstream(output);
+      if (!*of)
+	{
+	  std::cerr << "Cannot open " << output << std::endl;
+	  exit(2);
+	}
+    }
+
+  int exit_code = 0;
+  {
+    printer out(of ? *of : std::cout, fs, timing);
+    if (jobs > fs.size())
+      jobs = fs.size();
+    if (jobs <= 1)
+      translate_range(fs, 0, 1, o, out);
+    else
+      exit_code = run_workers(fs, jobs, o, out);
+  }
+  delete of;
+
+  for (unsigned i = 0; i < fs.size(); ++i)
+    fs[i]->destroy();
+  return exit_code;
+}
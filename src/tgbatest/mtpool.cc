@@ -0,0 +1,231 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+#include <iostream>
+#include <cstring>
+#include <set>
+#include <vector>
+#include "misc/fixpool.hh"
+#include "misc/mspool.hh"
+#include "misc/mtpool.hh"
+
+// Fill the block B of size SIZE with a pattern depending on I.
+void fill(void* b, size_t size, int i)
+{
+  memset(b, i & 0xff, size);
+}
+
+// Check the pattern written by fill().
+int check_fill(const void* b, size_t size, int i, const char* name)
+{
+  const unsigned char* c = static_cast<const unsigned char*>(b);
+  for (size_t j = 0; j < size; ++j)
+    if (c[j] != (i & 0xff))
+      {
+	std::cout << "*** " << name << ": block " << i
+		  << " was overwritten ***" << std::endl;
+	return 1;
+      }
+  return 0;
+}
+
+int check_aligned(const void* b, const char* name)
+{
+  if (reinterpret_cast<size_t>(b) % (2 * sizeof(size_t)))
+    {
+      std::cout << "*** " << name << ": misaligned block ***" << std::endl;
+      return 1;
+    }
+  return 0;
+}
+
+int check_counter(size_t value, size_t expected, const char* name)
+{
+  if (value != expected)
+    {
+      std::cout << "*** " << name << " is " << value << " instead of "
+		<< expected << " ***" << std::endl;
+      return 1;
+    }
+  return 0;
+}
+
+size_t block_size(int i)
+{
+  return 1 + i * 37 % 300;
+}
+
+int check_single()
+{
+  int errors = 0;
+  const int n = 1000;
+  std::vector<void*> blocks(n);
+
+  spot::fixed_size_pool fp(24);
+  for (int i = 0; i < n; ++i)
+    {
+      blocks[i] = fp.allocate();
+      errors += check_aligned(blocks[i], "fixed_size_pool");
+      fill(blocks[i], 24, i);
+    }
+  for (int i = 0; i < n; ++i)
+    errors += check_fill(blocks[i], 24, i, "fixed_size_pool");
+  const size_t alignment = 2 * sizeof(size_t);
+  const size_t rounded = (24 + alignment - 1) & ~(alignment - 1);
+  errors += check_counter(fp.used_bytes(), n * rounded,
+			  "fixed_size_pool::used_bytes()");
+  for (int i = 0; i < n; ++i)
+    fp.deallocate(blocks[i]);
+  errors += check_counter(fp.used_bytes(), 0,
+			  "fixed_size_pool::used_bytes()");
+
+  spot::multiple_size_pool mp;
+  size_t total = 0;
+  for (int i = 0; i < n; ++i)
+    {
+      blocks[i] = mp.allocate(block_size(i));
+      errors += check_aligned(blocks[i], "multiple_size_pool");
+      fill(blocks[i], block_size(i), i);
+      total += mp.fixsize(block_size(i));
+    }
+  for (int i = 0; i < n; ++i)
+    errors += check_fill(blocks[i], block_size(i), i, "multiple_size_pool");
+  errors += check_counter(mp.used_bytes(), total,
+			  "multiple_size_pool::used_bytes()");
+  if (mp.allocated_bytes() < total)
+    {
+      std::cout << "*** multiple_size_pool::allocated_bytes() is too small"
+		<< " ***" << std::endl;
+      ++errors;
+    }
+  for (int i = 0; i < n; ++i)
+    mp.deallocate(blocks[i], block_size(i));
+  errors += check_counter(mp.used_bytes(), 0,
+			  "multiple_size_pool::used_bytes()");
+  return errors;
+}
+
+// Allocate blocks through one cache, and release them through
+// another, as if two threads were involved.  With magazines of 4
+// blocks, this moves blocks through the depot in every way.
+template <class Pool, class Size>
+int check_concurrent(Pool& pool, Size size, const char* name)
+{
+  int errors = 0;
+  const int n = 1000;
+  std::vector<void*> blocks(n);
+  {
+    typename Pool::cache a(pool);
+    typename Pool::cache b(pool);
+
+    for (int round = 0; round < 3; ++round)
+      {
+	std::set<void*> seen;
+	for (int i = 0; i < n; ++i)
+	  {
+	    typename Pool::cache& c = (i % 3) ? a : b;
+	    blocks[i] = size.allocate(c, i);
+	    errors += check_aligned(blocks[i], name);
+	    if (!seen.insert(blocks[i]).second)
+	      {
+		std::cout << "*** " << name << ": block allocated twice ***"
+			  << std::endl;
+		++errors;
+	      }
+	    fill(blocks[i], size(i), i);
+	  }
+	for (int i = 0; i < n; ++i)
+	  errors += check_fill(blocks[i], size(i), i, name);
+	for (int i = n - 1; i >= 0; --i)
+	  {
+	    typename Pool::cache& c = (i % 5) ? b : a;
+	    size.deallocate(c, blocks[i], i);
+	  }
+	errors += check_counter(pool.allocated_bytes(),
+				pool.free_bytes() + a.cached_bytes()
+				+ b.cached_bytes(), name);
+      }
+    a.flush();
+    errors += check_counter(a.cached_bytes(), 0, name);
+  }
+  // The caches have been destroyed, so all the memory is back in
+  // the pool.
+  errors += check_counter(pool.allocated_bytes(), pool.free_bytes(), name);
+  return errors;
+}
+
+struct fixed_size
+{
+  size_t
+  operator()(int) const
+  {
+    return 24;
+  }
+
+  void*
+  allocate(spot::concurrent_fixed_size_pool::cache& c, int) const
+  {
+    return c.allocate();
+  }
+
+  void
+  deallocate(spot::concurrent_fixed_size_pool::cache& c, void* b, int) const
+  {
+    c.deallocate(b);
+  }
+};
+
+struct multiple_size
+{
+  size_t
+  operator()(int i) const
+  {
+    return block_size(i);
+  }
+
+  void*
+  allocate(spot::concurrent_multiple_size_pool::cache& c, int i) const
+  {
+    return c.allocate(block_size(i));
+  }
+
+  void
+  deallocate(spot::concurrent_multiple_size_pool::cache& c,
+	     void* b, int i) const
+  {
+    c.deallocate(b, block_size(i));
+  }
+};
+
+int main()
+{
+  int errors = check_single();
+
+  spot::concurrent_fixed_size_pool fp(24, 4);
+  errors += check_concurrent(fp, fixed_size(),
+			     "concurrent_fixed_size_pool");
+
+  // Blocks larger than 256 bytes are allocated from the system.
+  spot::concurrent_multiple_size_pool mp(256, 4);
+  errors += check_concurrent(mp, multiple_size(),
+			     "concurrent_multiple_size_pool");
+
+  return errors != 0;
+}
@@ -49,6 +49,7 @@
 #include "tgba/tgbatba.hh"
 #include "tgba/tgbaproduct.hh"
 #include "misc/timer.hh"
+#include "misc/perfreport.hh"
 
 #include "tgbaalgos/ltl2tgba_fm.hh"
 
@@ -113,6 +114,8 @@ syntax(char* prog)
 	    << std::endl
 	    << "  -Z      like -z, but print extra statistics after the run"
 	    << " of each algorithm" << std::endl
+	    << "  -JFILE  write a JSON performance report to FILE"
+	    << " (implies -z)" << std::endl
 	    << std::endl
 	    << "Graph Generation Options:" << std::endl
 	    << "  -a N F  number of acceptance conditions and probability that"
@@ -359,6 +362,24 @@ struct stat_collector
     return os;
   }
 
+  // Add these statistics to REPORT, in one section per algorithm.
+  void
+  report(spot::perf_report& report, const std::string& prefix) const
+  {
+    typename stats_alg_map::const_iterator i;
+    for (i = stats.begin(); i != stats.end(); ++i)
+      for (typename alg_1stat_map::const_iterator j = i->second.begin();
+	   j != i->second.end(); ++j)
+	{
+	  const std::string section = prefix + j->first;
+	  report.add(section, i->first + " (min)", j->second.min);
+	  report.add(section, i->first + " (mean)",
+		     static_cast<double>(j->second.tot) / j->second.n);
+	  report.add(section, i->first + " (max)", j->second.max);
+	  report.add(section, i->first + " (count)", j->second.n);
+	}
+  }
+
 
 };
 
@@ -561,6 +582,7 @@ main(int argc, char** argv)
 
   bool opt_0 = false;
   bool opt_z = false;
+  const char* json_file = 0;
   bool opt_Z = false;
 
   int opt_R = 0;
@@ -745,6 +767,13 @@ main(int argc, char** argv)
 	{
 	  opt_z = true;
 	}
+      else if (!strncmp(argv[argn], "-J", 2))
+	{
+	  json_file = argv[argn] + 2;
+	  if (!*json_file)
+	    syntax(argv[0]);
+	  opt_z = true;
+	}
       else if (!strcmp(argv[argn], "-Z"))
 	{
 	  opt_Z = opt_z = true;
@@ -1292,6 +1321,21 @@ main(int argc, char** argv)
       }
     }
 
+  if (json_file)
+    {
+      spot::perf_report report("randtgba");
+      report.add_timers("emptiness checks", tm_ec);
+      report.add_timers("accepting runs", tm_ar);
+      sc_ec.report(report, "emptiness check ");
+      sc_arc.report(report, "accepting run ");
+      report.add_bdd_stats();
+      if (!report.print_json(json_file))
+	{
+	  std::cerr << "cannot write `" << json_file << "'" << std::endl;
+	  exit_code = 2;
+	}
+    }
+
   if (!failed_seeds.empty())
     {
       exit_code = 1;
@@ -64,6 +64,7 @@ main(int argc, char** argv)
     syntax(argv[0]);
 
   int o = spot::ltl::Reduce_None;
+  bool signature = false;
   switch (atoi(argv[1]))
     {
     case 0:
@@ -94,6 +95,14 @@ main(int argc, char** argv)
     case 7:
       // No Reduction
       break;
+    case 8:
+      o = spot::Reduce_quotient_Dir_Sim;
+      signature = true;
+      break;
+    case 9:
+      o = spot::Reduce_quotient_Del_Sim;
+      signature = true;
+      break;
     default:
       return 2;
   }
@@ -127,13 +136,21 @@ main(int argc, char** argv)
 
   if (o & spot::Reduce_quotient_Dir_Sim)
     {
-      rel_dir = spot::get_direct_relation_simulation(automatareduc, std::cout);
+      if (signature)
+	rel_dir = spot::get_direct_relation_simulation_sig(automatareduc);
+      else
+	rel_dir = spot::get_direct_relation_simulation(automatareduc,
+						       std::cout);
       automatareduc->quotient_state(rel_dir);
     }
   else if (o & spot::Reduce_quotient_Del_Sim)
     {
       std::cout << "get delayed" << std::endl;
-      rel_del = spot::get_delayed_relation_simulation(automatareduc, std::cout);
+      if (signature)
+	rel_del = spot::get_delayed_relation_simulation_sig(automatareduc);
+      else
+	rel_del = spot::get_delayed_relation_simulation(automatareduc,
+							std::cout);
       std::cout << "quotient state" << std::endl;
       automatareduc->quotient_state(rel_del);
       std::cout << "end" << std::endl;
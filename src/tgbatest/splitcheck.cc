@@ -0,0 +1,279 @@
+// Copyright (C) 2026 Laboratoire de Recherche et Developpement de
+// l'Epita (LRDE)
+//
+// This file is part of Spot, a model checking library.
+//
+// Spot is free software; you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Spot is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+// or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Spot; see the file COPYING.  If not, write to the Free
+// Software Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+// 02111-1307, USA.
+
+// Check random models against random formulae with
+// split_emptiness_check(), and compare the answer with the emptiness
+// of the product with the whole automaton of the formula.  Also check
+// that the workers are stopped once one of them has found an
+// accepting run, and that none is left behind.
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "ltlast/allnodes.hh"
+#include "ltlenv/defaultenv.hh"
+#include "ltlvisit/randomltl.hh"
+#include "ltlvisit/tostring.hh"
+#include "misc/random.hh"
+#include "tgba/tgbaexplicit.hh"
+#include "tgba/tgbaproduct.hh"
+#include "tgbaalgos/cutscc.hh"
+#include "tgbaalgos/emptiness.hh"
+#include "tgbaalgos/gtec/gtec.hh"
+#include "tgbaalgos/ltl2tgba_fm.hh"
+#include "tgbaalgos/randomgraph.hh"
+#include "tgbaalgos/scc.hh"
+
+namespace
+{
+  void
+  syntax(char* prog)
+  {
+    std::cerr << "Usage: " << prog << " [OPTIONS...]" << std::endl
+	      << std::endl
+	      << "Check random products with split_emptiness_check()."
+	      << std::endl << std::endl
+	      << "Options:" << std::endl
+	      << "  -a N    number of atomic propositions [3]" << std::endl
+	      << "  -f N    size of random formulae [8]" << std::endl
+	      << "  -j N    number of workers [3]" << std::endl
+	      << "  -n N    number of states of the random models [100]"
+	      << std::endl
+	      << "  -p N    number of automata in each split [4]"
+	      << std::endl
+	      << "  -r N    number of random products [10]" << std::endl
+	      << "  -s N    seed for the random number generator [0]"
+	      << std::endl
+	      << "  -v      print each formula and the answer" << std::endl;
+    exit(2);
+  }
+
+  int
+  to_int(const char* s)
+  {
+    char* endptr;
+    int res = strtol(s, &endptr, 10);
+    if (*endptr || res < 0)
+      {
+	std::cerr << "Failed to parse `" << s << "' as a positive integer."
+		  << std::endl;
+	exit(2);
+      }
+    return res;
+  }
+
+  bool
+  is_empty(const spot::tgba* a)
+  {
+    spot::emptiness_check* ec = spot::couvreur99(a);
+    spot::emptiness_check_result* res = ec->check();
+    bool empty = !res;
+    delete res;
+    delete ec;
+    return empty;
+  }
+
+  // All the workers must have been reaped, and this process has no
+  // other children.
+  bool
+  no_child_left()
+  {
+    if (waitpid(-1, 0, WNOHANG) < 0 && errno == ECHILD)
+      return true;
+    std::cerr << "a worker was left behind" << std::endl;
+    return false;
+  }
+
+  // An automaton with a single state looping on true, which takes
+  // a minute to produce it.
+  class slow_tgba: public spot::tgba_explicit_number
+  {
+  public:
+    slow_tgba(spot::bdd_dict* dict)
+      : spot::tgba_explicit_number(dict)
+    {
+      add_conditions(create_transition(0, 0), bddtrue);
+    }
+
+    virtual spot::state*
+    get_init_state() const
+    {
+      sleep(60);
+      return spot::tgba_explicit_number::get_init_state();
+    }
+  };
+
+  // Check MODEL against F, with 1 and JOBS workers.
+  bool
+  check(spot::bdd_dict* dict, const spot::tgba* model,
+	const spot::ltl::formula* f, unsigned parts, unsigned jobs,
+	bool verbose)
+  {
+    spot::tgba* af = spot::ltl_to_tgba_fm(f, dict);
+    bool expected;
+    {
+      spot::tgba_product p(model, af);
+      expected = !is_empty(&p);
+    }
+
+    // Remove the useless SCCs before splitting, as bench/split-product
+    // does.  Nothing is left if there is no accepting path.
+    std::list<spot::tgba*> split;
+    {
+      spot::scc_map m(af);
+      m.build_map();
+      split = spot::split_tgba(af, m, 1);
+    }
+    spot::tgba* a = split.empty() ? 0 : split.front();
+    if (a)
+      {
+	spot::scc_map m(a);
+	m.build_map();
+	split = spot::split_tgba(a, m, parts);
+      }
+
+    bool ok = true;
+    unsigned js[2] = { 1, jobs };
+    for (unsigned i = 0; i < 2; ++i)
+      {
+	int res = spot::split_emptiness_check(model, split, js[i]);
+	if (res != (expected ? 1 : 0))
+	  {
+	    std::cerr << "with " << js[i] << " worker(s), "
+		      << spot::ltl::to_string(f) << " gives " << res
+		      << " instead of " << expected << std::endl;
+	    ok = false;
+	  }
+	ok &= no_child_left();
+      }
+    if (verbose)
+      std::cout << spot::ltl::to_string(f) << ": " << split.size()
+		<< " part(s), "
+		<< (expected ? "accepting run" : "empty") << std::endl;
+
+    for (std::list<spot::tgba*>::iterator i = split.begin();
+	 i != split.end(); ++i)
+      delete *i;
+    delete a;
+    delete af;
+    return ok;
+  }
+
+  // One worker finds an accepting run at once while the other is
+  // asleep: the latter must be killed.
+  bool
+  check_stop(spot::bdd_dict* dict)
+  {
+    spot::tgba_explicit_number* fast = new spot::tgba_explicit_number(dict);
+    fast->add_conditions(fast->create_transition(0, 0), bddtrue);
+    spot::tgba* slow = new slow_tgba(dict);
+    std::list<spot::tgba*> split;
+    split.push_back(slow);
+    split.push_back(fast);
+
+    bool ok = true;
+    time_t start = time(0);
+    int res = spot::split_emptiness_check(fast, split, 2);
+    if (res != 1)
+      {
+	std::cerr << "the accepting run was not found" << std::endl;
+	ok = false;
+      }
+    if (time(0) - start >= 30)
+      {
+	std::cerr << "the sleeping worker was not stopped" << std::endl;
+	ok = false;
+      }
+    ok &= no_child_left();
+
+    delete slow;
+    delete fast;
+    return ok;
+  }
+}
+
+int
+main(int argc, char** argv)
+{
+  int opt_a = 3;
+  int opt_f = 8;
+  int opt_j = 3;
+  int opt_n = 100;
+  int opt_p = 4;
+  int opt_r = 10;
+  int opt_s = 0;
+  bool opt_v = false;
+
+  for (int argn = 1; argn < argc; ++argn)
+    {
+      if (!strcmp(argv[argn], "-a") && argn + 1 < argc)
+	opt_a = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-f") && argn + 1 < argc)
+	opt_f = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-j") && argn + 1 < argc)
+	opt_j = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-n") && argn + 1 < argc)
+	opt_n = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-p") && argn + 1 < argc)
+	opt_p = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-r") && argn + 1 < argc)
+	opt_r = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-s") && argn + 1 < argc)
+	opt_s = to_int(argv[++argn]);
+      else if (!strcmp(argv[argn], "-v"))
+	opt_v = true;
+      else
+	syntax(argv[0]);
+    }
+
+  spot::bdd_dict* dict = new spot::bdd_dict();
+  bool ok = check_stop(dict);
+
+  spot::ltl::environment& env = spot::ltl::default_environment::instance();
+  spot::ltl::atomic_prop_set ap;
+  for (int i = 0; i < opt_a; ++i)
+    {
+      char buf[20];
+      sprintf(buf, "p%d", i);
+      ap.insert(static_cast<spot::ltl::atomic_prop*>(env.require(buf)));
+    }
+  spot::ltl::random_ltl rl(&ap);
+  spot::srand(opt_s);
+  for (int i = 0; i < opt_r; ++i)
+    {
+      spot::tgba* model = spot::random_graph(opt_n, 0.05, &ap, dict);
+      spot::ltl::formula* f = rl.generate(opt_f);
+      ok &= check(dict, model, f, opt_p, opt_j, opt_v);
+      f->destroy();
+      delete model;
+    }
+  for (spot::ltl::atomic_prop_set::iterator i = ap.begin();
+       i != ap.end(); ++i)
+    (*i)->destroy();
+
+  delete dict;
+  return !ok;
+}